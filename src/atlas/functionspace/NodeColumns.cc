@@ -11,12 +11,16 @@
 //#include <cstdarg>
 //#include <functional>
 
+#include <map>
+#include <vector>
+
 #include "eckit/utils/MD5.h"
 
 #include "atlas/array.h"
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
 #include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/detail/GatherScatterFieldSet.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/library/config.h"
 #include "atlas/mesh/IsGhostNode.h"
@@ -43,31 +47,6 @@ namespace atlas {
 namespace functionspace {
 namespace detail {
 
-namespace {
-
-template <typename T, typename Field>
-array::LocalView<T, 3> make_leveled_view(Field& field) {
-    using namespace array;
-    if (field.levels()) {
-        if (field.variables()) {
-            return make_view<T, 3>(field).slice(Range::all(), Range::all(), Range::all());
-        }
-        else {
-            return make_view<T, 2>(field).slice(Range::all(), Range::all(), Range::dummy());
-        }
-    }
-    else {
-        if (field.variables()) {
-            return make_view<T, 2>(field).slice(Range::all(), Range::dummy(), Range::all());
-        }
-        else {
-            return make_view<T, 1>(field).slice(Range::all(), Range::dummy(), Range::dummy());
-        }
-    }
-}
-
-}  // namespace
-
 class NodeColumnsHaloExchangeCache : public util::Cache<std::string, parallel::HaloExchange>,
                                      public mesh::detail::MeshObserver {
 private:
@@ -455,37 +434,11 @@ void NodeColumns::gather(const FieldSet& local_fieldset, FieldSet& global_fields
 
     mpi::Scope mpi_scope(mpi_comm());
 
-    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
-        const Field& loc      = local_fieldset[f];
-        Field& glb            = global_fieldset[f];
-        const idx_t nb_fields = 1;
-        idx_t root(0);
-        glb.metadata().get("owner", root);
-
-        if (loc.datatype() == array::DataType::kind<int>()) {
-            parallel::Field<int const> loc_field(make_leveled_view<const int>(loc));
-            parallel::Field<int> glb_field(make_leveled_view<int>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<long>()) {
-            parallel::Field<long const> loc_field(make_leveled_view<const long>(loc));
-            parallel::Field<long> glb_field(make_leveled_view<long>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<float>()) {
-            parallel::Field<float const> loc_field(make_leveled_view<const float>(loc));
-            parallel::Field<float> glb_field(make_leveled_view<float>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<double>()) {
-            parallel::Field<double const> loc_field(make_leveled_view<const double>(loc));
-            parallel::Field<double> glb_field(make_leveled_view<double>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else {
-            throw_Exception("datatype not supported", Here());
-        }
-    }
+    check_datatypes(local_fieldset);
+    gather_fieldset<int>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<long>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<float>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<double>(gather(), local_fieldset, global_fieldset);
 }
 
 void NodeColumns::gather(const Field& local, Field& global) const {
@@ -514,37 +467,17 @@ void NodeColumns::scatter(const FieldSet& global_fieldset, FieldSet& local_field
     ATLAS_ASSERT(local_fieldset.size() == global_fieldset.size());
 
     mpi::Scope mpi_scope(mpi_comm());
+    check_datatypes(local_fieldset);
+    scatter_fieldset<int>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<long>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<float>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<double>(scatter(), global_fieldset, local_fieldset);
+
     for (idx_t f = 0; f < local_fieldset.size(); ++f) {
-        const Field& glb      = global_fieldset[f];
-        Field& loc            = local_fieldset[f];
-        const idx_t nb_fields = 1;
+        const Field& glb = global_fieldset[f];
+        Field& loc       = local_fieldset[f];
         idx_t root(0);
         glb.metadata().get("owner", root);
-
-        if (loc.datatype() == array::DataType::kind<int>()) {
-            parallel::Field<int const> glb_field(make_leveled_view<const int>(glb));
-            parallel::Field<int> loc_field(make_leveled_view<int>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<long>()) {
-            parallel::Field<long const> glb_field(make_leveled_view<const long>(glb));
-            parallel::Field<long> loc_field(make_leveled_view<long>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<float>()) {
-            parallel::Field<float const> glb_field(make_leveled_view<const float>(glb));
-            parallel::Field<float> loc_field(make_leveled_view<float>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<double>()) {
-            parallel::Field<double const> glb_field(make_leveled_view<const double>(glb));
-            parallel::Field<double> loc_field(make_leveled_view<double>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else {
-            throw_Exception("datatype not supported", Here());
-        }
-
         auto name = loc.name();
         glb.metadata().broadcast(loc.metadata(), root);
         loc.metadata().set("global", false);
@@ -609,6 +542,22 @@ std::string NodeColumns::checksum(const Field& field) const {
     return checksum(fieldset);
 }
 
+void NodeColumns::set_halo_exchange(const util::ObjectHandle<parallel::HaloExchange>& halo_exchange) const {
+    ATLAS_ASSERT(halo_exchange);
+    ATLAS_ASSERT(halo_exchange->backdoor.parsize == nb_nodes_,
+                 "HaloExchange was set up for a different number of nodes than this NodeColumns");
+    ATLAS_ASSERT(halo_exchange->comm().name() == mpi_comm());
+    halo_exchange_ = halo_exchange;
+}
+
+void NodeColumns::set_gather_scatter(const util::ObjectHandle<parallel::GatherScatter>& gather_scatter) const {
+    ATLAS_ASSERT(gather_scatter);
+    ATLAS_ASSERT(gather_scatter->loc_dof() <= nodes_.size(),
+                 "GatherScatter was set up for more nodes than this NodeColumns");
+    ATLAS_ASSERT(gather_scatter->comm().name() == mpi_comm());
+    gather_scatter_ = gather_scatter;
+}
+
 const parallel::Checksum& NodeColumns::checksum() const {
     if (checksum_) {
         return *checksum_;
@@ -696,6 +645,14 @@ const parallel::HaloExchange& NodeColumns::halo_exchange() const {
     return functionspace_->halo_exchange();
 }
 
+void NodeColumns::set_halo_exchange(const util::ObjectHandle<parallel::HaloExchange>& halo_exchange) const {
+    functionspace_->set_halo_exchange(halo_exchange);
+}
+
+void NodeColumns::set_gather_scatter(const util::ObjectHandle<parallel::GatherScatter>& gather_scatter) const {
+    functionspace_->set_gather_scatter(gather_scatter);
+}
+
 std::string NodeColumns::checksum(const FieldSet& fieldset) const {
     return functionspace_->checksum(fieldset);
 }
@@ -96,6 +96,12 @@ public:
     void scatter(const Field&, Field&) const override;
     const parallel::GatherScatter& scatter() const override;
 
+    /// @brief Use given halo exchange, e.g. restored with io::decode(), instead of setting it up from the mesh
+    void set_halo_exchange(const util::ObjectHandle<parallel::HaloExchange>&) const;
+
+    /// @brief Use given gather-scatter, e.g. restored with io::decode(), instead of setting it up from the mesh
+    void set_gather_scatter(const util::ObjectHandle<parallel::GatherScatter>&) const;
+
     std::string checksum(const FieldSet&) const;
     std::string checksum(const Field&) const;
     const parallel::Checksum& checksum() const;
@@ -503,6 +509,12 @@ public:
     void haloExchange(const Field&, bool on_device = false) const;
     const parallel::HaloExchange& halo_exchange() const;
 
+    /// @brief Use given halo exchange, e.g. restored with io::decode(), instead of setting it up from the mesh
+    void set_halo_exchange(const util::ObjectHandle<parallel::HaloExchange>&) const;
+
+    /// @brief Use given gather-scatter, e.g. restored with io::decode(), instead of setting it up from the mesh
+    void set_gather_scatter(const util::ObjectHandle<parallel::GatherScatter>&) const;
+
     std::string checksum(const FieldSet&) const;
     std::string checksum(const Field&) const;
     const parallel::Checksum& checksum() const;
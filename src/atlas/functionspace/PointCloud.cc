@@ -10,6 +10,9 @@
  */
 
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -197,77 +200,196 @@ PointCloud::PointCloud(const Grid& grid, const grid::Partitioner& _partitioner,
         }
     }
     else {
+        // Each rank only builds a kd-tree of its owned points. Candidate halo points are exchanged with the ranks
+        // whose bounding box, widened by the halo radius, overlaps the bounding box of this rank, and are kept when
+        // within the halo radius of an owned point. Owned points come first, followed by halo points ordered by
+        // global index, so that remote indices are known without further communication.
+        std::vector<PointLonLat> owned_lonlat;
+        std::vector<gidx_t> owned_gidx;
+        auto kdtree = util::IndexKDTree(config);
+        {
+            ATLAS_TRACE("build kdtree of owned points");
+            owned_lonlat.reserve(size_owned);
+            owned_gidx.reserve(size_owned);
+            gidx_t g{0};
+            for (auto p : grid.lonlat()) {
+                if (distribution.partition(g) == part_) {
+                    owned_lonlat.emplace_back(p);
+                    owned_gidx.emplace_back(g + 1);
+                }
+                ++g;
+            }
+            if (size_owned > 0) {
+                std::vector<idx_t> payloads(size_owned);
+                std::iota(payloads.begin(), payloads.end(), 0);
+                kdtree.build(owned_lonlat, payloads);
+            }
+        }
+
+        std::vector<Point3> owned_xyz(size_owned);
+        std::vector<double> bounding_boxes;
+        {
+            ATLAS_TRACE("exchange bounding boxes");
+            // xmin, ymin, zmin, xmax, ymax, zmax of owned points, in the coordinates of the kd-tree
+            std::vector<double> bounding_box{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                             std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                                             std::numeric_limits<double>::lowest(),
+                                             std::numeric_limits<double>::lowest()};
+            for (idx_t j = 0; j < size_owned; ++j) {
+                kdtree.geometry().lonlat2xyz(owned_lonlat[j], owned_xyz[j]);
+                for (int d = 0; d < 3; ++d) {
+                    bounding_box[d]     = std::min(bounding_box[d], owned_xyz[j][d]);
+                    bounding_box[d + 3] = std::max(bounding_box[d + 3], owned_xyz[j][d]);
+                }
+            }
+            eckit::mpi::Buffer<double> recv_bounding_boxes(nb_partitions_);
+            ATLAS_TRACE_MPI(ALLGATHER) {
+                comm.allGatherv(bounding_box.begin(), bounding_box.end(), recv_bounding_boxes);
+            }
+            bounding_boxes.assign(recv_bounding_boxes.begin(), recv_bounding_boxes.end());
+        }
 
-        std::vector<int> keep;
+        // Point xyz lies within the bounding box of partition p widened by the halo radius
+        auto near_partition = [&](const Point3& xyz, idx_t p) {
+            const double* bounding_box = bounding_boxes.data() + 6 * p;
+            for (int d = 0; d < 3; ++d) {
+                if (xyz[d] < bounding_box[d] - halo_radius || xyz[d] > bounding_box[d + 3] + halo_radius) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // Widened bounding boxes overlap symmetrically, so that neighbours agree on whom to send to
+        std::vector<int> neighbours;
+        for (idx_t p = 0; p < nb_partitions_; ++p) {
+            bool overlap = (p != part_);
+            for (int d = 0; d < 3 && overlap; ++d) {
+                overlap = bounding_boxes[6 * p + d] - halo_radius <= bounding_boxes[6 * part_ + d + 3] &&
+                          bounding_boxes[6 * part_ + d] - halo_radius <= bounding_boxes[6 * p + d + 3];
+            }
+            if (overlap) {
+                neighbours.emplace_back(p);
+            }
+        }
+        const idx_t nb_neighbours = static_cast<idx_t>(neighbours.size());
 
+        struct HaloPoint {
+            gidx_t gidx;
+            double lon;
+            double lat;
+            int partition;
+            idx_t remote_index;
+        };
+        std::vector<HaloPoint> halo_points;
         {
-            ATLAS_TRACE("Build list of points to keep");
-            std::vector<PointLonLat> owned_lonlat;
-            std::vector<idx_t> owned_grid_idx;
-            owned_lonlat.reserve(size_owned);
-            owned_grid_idx.reserve(size_owned);
-
-            auto kdtree = util::IndexKDTree(config);
-            {
-                ATLAS_TRACE("build kdtree");
-                kdtree.reserve(grid.size());
-                idx_t j{0};
-                for (auto p : grid.lonlat()) {
-                    if( distribution.partition(j) == part_ ) {
-                        owned_lonlat.emplace_back(p);
-                        owned_grid_idx.emplace_back(j);
+            ATLAS_TRACE("exchange halo points");
+            std::vector<std::vector<gidx_t>> send_gidx(nb_neighbours);
+            std::vector<std::vector<double>> send_lonlat(nb_neighbours);
+            std::vector<std::vector<idx_t>> send_ridx(nb_neighbours);
+            for (idx_t n = 0; n < nb_neighbours; ++n) {
+                for (idx_t j = 0; j < size_owned; ++j) {
+                    if (near_partition(owned_xyz[j], neighbours[n])) {
+                        send_gidx[n].emplace_back(owned_gidx[j]);
+                        send_lonlat[n].emplace_back(owned_lonlat[j].lon());
+                        send_lonlat[n].emplace_back(owned_lonlat[j].lat());
+                        send_ridx[n].emplace_back(j);
                     }
-                    kdtree.insert(p,j);
-                    ++j;
                 }
-                kdtree.build();
             }
 
-            keep.resize(grid.size());
-            {
-                ATLAS_TRACE("search kdtree");
-                for (idx_t j=0; j<size_owned; ++j) {
-                    idx_t idx = owned_grid_idx[j];
-                    const auto& p = owned_lonlat[j];
-                    auto points = kdtree.closestPointsWithinRadius(p,halo_radius).payloads();
-                    for( idx_t jj: points ) {
-                        keep[jj] = 1;
+            const int tag = 0;
+            std::vector<idx_t> send_size(nb_neighbours);
+            std::vector<idx_t> recv_size(nb_neighbours);
+            std::vector<eckit::mpi::Request> requests;
+            requests.reserve(6 * nb_neighbours);
+            ATLAS_TRACE_MPI(ALLTOALL) {
+                for (idx_t n = 0; n < nb_neighbours; ++n) {
+                    send_size[n] = static_cast<idx_t>(send_gidx[n].size());
+                    requests.emplace_back(comm.iReceive(recv_size[n], neighbours[n], tag));
+                    requests.emplace_back(comm.iSend(send_size[n], neighbours[n], tag));
+                }
+                for (auto& request : requests) {
+                    comm.wait(request);
+                }
+            }
+
+            std::vector<std::vector<gidx_t>> recv_gidx(nb_neighbours);
+            std::vector<std::vector<double>> recv_lonlat(nb_neighbours);
+            std::vector<std::vector<idx_t>> recv_ridx(nb_neighbours);
+            requests.clear();
+            ATLAS_TRACE_MPI(ALLTOALL) {
+                for (idx_t n = 0; n < nb_neighbours; ++n) {
+                    recv_gidx[n].resize(recv_size[n]);
+                    recv_lonlat[n].resize(2 * recv_size[n]);
+                    recv_ridx[n].resize(recv_size[n]);
+                    requests.emplace_back(
+                        comm.iReceive(recv_gidx[n].data(), recv_gidx[n].size(), neighbours[n], tag));
+                    requests.emplace_back(
+                        comm.iReceive(recv_lonlat[n].data(), recv_lonlat[n].size(), neighbours[n], tag + 1));
+                    requests.emplace_back(
+                        comm.iReceive(recv_ridx[n].data(), recv_ridx[n].size(), neighbours[n], tag + 2));
+                }
+                for (idx_t n = 0; n < nb_neighbours; ++n) {
+                    requests.emplace_back(comm.iSend(send_gidx[n].data(), send_gidx[n].size(), neighbours[n], tag));
+                    requests.emplace_back(
+                        comm.iSend(send_lonlat[n].data(), send_lonlat[n].size(), neighbours[n], tag + 1));
+                    requests.emplace_back(
+                        comm.iSend(send_ridx[n].data(), send_ridx[n].size(), neighbours[n], tag + 2));
+                }
+                for (auto& request : requests) {
+                    comm.wait(request);
+                }
+            }
+
+            ATLAS_TRACE_SCOPE("search kdtree")
+            for (idx_t n = 0; n < nb_neighbours; ++n) {
+                for (idx_t j = 0; j < recv_size[n]; ++j) {
+                    PointLonLat p{recv_lonlat[n][2 * j], recv_lonlat[n][2 * j + 1]};
+                    if (not kdtree.closestPointsWithinRadius(p, halo_radius).empty()) {
+                        halo_points.push_back({recv_gidx[n][j], p.lon(), p.lat(), neighbours[n], recv_ridx[n][j]});
                     }
                 }
             }
+            std::sort(halo_points.begin(), halo_points.end(),
+                      [](const HaloPoint& a, const HaloPoint& b) { return a.gidx < b.gidx; });
         }
 
         {
             ATLAS_TRACE("create fields");
 
-            auto size_halo = std::accumulate(keep.begin(),keep.end(),0);
+            const idx_t size_halo = size_owned + static_cast<idx_t>(halo_points.size());
 
             lonlat_         = Field("lonlat", array::make_datatype<double>(), array::make_shape(size_halo, 2));
             partition_      = Field("partition", array::make_datatype<int>(), array::make_shape(size_halo));
             ghost_          = Field("ghost", array::make_datatype<int>(), array::make_shape(size_halo));
             global_index_   = Field("global_index", array::make_datatype<gidx_t>(), array::make_shape(size_halo));
+            remote_index_   = Field("remote_index", array::make_datatype<idx_t>(), array::make_shape(size_halo));
             max_glb_idx_    = grid.size();
             auto lonlat     = array::make_view<double,2>(lonlat_);
             auto partition  = array::make_view<int,1>(partition_);
             auto ghost      = array::make_view<int,1>(ghost_);
             auto glb_idx    = array::make_view<gidx_t,1>(global_index_);
-
-            gidx_t g=0;
-            idx_t j = 0;
-            for (auto p : grid.lonlat()) {
-                if (keep[g]) {
-                    lonlat(j, 0) = p.lon();
-                    lonlat(j, 1) = p.lat();
-                    partition(j) = distribution.partition(g);
-                    ghost(j) = partition(j) != part_;
-                    glb_idx(j) = g+1;
-                    ++j;
-                }
-                ++g;
+            auto ridx       = array::make_indexview<idx_t,1>(remote_index_);
+
+            for (idx_t j = 0; j < size_owned; ++j) {
+                lonlat(j, 0) = owned_lonlat[j].lon();
+                lonlat(j, 1) = owned_lonlat[j].lat();
+                partition(j) = part_;
+                ghost(j)     = 0;
+                glb_idx(j)   = owned_gidx[j];
+                ridx(j)      = j;
+            }
+            for (idx_t h = 0; h < static_cast<idx_t>(halo_points.size()); ++h) {
+                const idx_t j = size_owned + h;
+                lonlat(j, 0)  = halo_points[h].lon;
+                lonlat(j, 1)  = halo_points[h].lat;
+                partition(j)  = halo_points[h].partition;
+                ghost(j)      = 1;
+                glb_idx(j)    = halo_points[h].gidx;
+                ridx(j)       = halo_points[h].remote_index;
             }
-
         }
-
     }
 
     setupHaloExchange();
@@ -8,6 +8,9 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <map>
+#include <vector>
+
 #include "eckit/os/BackTrace.h"
 #include "eckit/utils/MD5.h"
 
@@ -18,6 +21,7 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/Trans.h"
@@ -137,6 +141,84 @@ public:
 };
 #endif
 
+#if ATLAS_HAVE_TRANS
+namespace {
+
+/// Indices of the fields, grouped by the rank owning their global field
+std::map<idx_t, std::vector<idx_t>> fields_per_owner(const FieldSet& global_fieldset) {
+    std::map<idx_t, std::vector<idx_t>> fields;
+    for (idx_t f = 0; f < global_fieldset.size(); ++f) {
+        fields[global_fieldset[f].metadata().getInt("owner", 0)].push_back(f);
+    }
+    return fields;
+}
+
+/// Spectral coefficients of several fields as expected by the IFS trans library, with the levels of all fields
+/// contiguous per coefficient. A single field is used in place, without copies.
+class SpectralBuffer {
+public:
+    SpectralBuffer(const FieldSet& fieldset, const std::vector<idx_t>& fields, idx_t nb_coefficients):
+        fields_(fields), nb_coefficients_(nb_coefficients) {
+        for (idx_t f : fields_) {
+            nfld += levels(fieldset[f]);
+        }
+        if (fields_.size() == 1) {
+            data = const_cast<double*>(fieldset[fields_[0]].array().data<double>());
+        }
+        else {
+            buffer_.resize(size_t(nb_coefficients_) * nfld);
+            data = buffer_.data();
+        }
+    }
+
+    void pack(const FieldSet& fieldset) {
+        if (fields_.size() == 1) {
+            return;
+        }
+        idx_t offset = 0;
+        for (idx_t f : fields_) {
+            const idx_t nlev     = levels(fieldset[f]);
+            const double* values = fieldset[f].array().data<double>();
+            atlas_omp_parallel_for(idx_t n = 0; n < nb_coefficients_; ++n) {
+                for (idx_t l = 0; l < nlev; ++l) {
+                    buffer_[size_t(n) * nfld + offset + l] = values[size_t(n) * nlev + l];
+                }
+            }
+            offset += nlev;
+        }
+    }
+
+    void unpack(FieldSet& fieldset) const {
+        if (fields_.size() == 1) {
+            return;
+        }
+        idx_t offset = 0;
+        for (idx_t f : fields_) {
+            const idx_t nlev = levels(fieldset[f]);
+            double* values   = fieldset[f].array().data<double>();
+            atlas_omp_parallel_for(idx_t n = 0; n < nb_coefficients_; ++n) {
+                for (idx_t l = 0; l < nlev; ++l) {
+                    values[size_t(n) * nlev + l] = buffer_[size_t(n) * nfld + offset + l];
+                }
+            }
+            offset += nlev;
+        }
+    }
+
+    idx_t nfld{0};
+    double* data;
+
+private:
+    static idx_t levels(const Field& field) { return field.rank() > 1 ? field.stride(0) : 1; }
+
+    std::vector<idx_t> fields_;
+    idx_t nb_coefficients_;
+    std::vector<double> buffer_;
+};
+
+}  // namespace
+#endif
+
 void Spectral::set_field_metadata(const eckit::Configuration& config, Field& field) const {
     field.set_functionspace(this);
 
@@ -250,42 +332,48 @@ void Spectral::gather(const FieldSet& local_fieldset, FieldSet& global_fieldset)
             err << "Only " << array::DataType::str<double>() << " supported.";
             throw_Exception(err.str(), Here());
         }
+    }
 
 #if ATLAS_HAVE_TRANS
-        Field& glb = global_fieldset[f];
-        idx_t root = 0;
-        idx_t rank = mpi::rank();
-        glb.metadata().get("owner", root);
+    idx_t rank = mpi::rank();
+    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
+        const Field& loc = local_fieldset[f];
+        const Field& glb = global_fieldset[f];
         ATLAS_ASSERT(loc.shape(0) == nb_spectral_coefficients());
-        if (rank == root) {
+        if (rank == glb.metadata().getInt("owner", 0)) {
             ATLAS_ASSERT(glb.shape(0) == nb_spectral_coefficients_global());
         }
-        std::vector<int> nto(1, root + 1);
-        if (loc.rank() > 1) {
-            nto.resize(loc.stride(0));
-            for (size_t i = 0; i < nto.size(); ++i) {
-                nto[i] = root + 1;
-            }
-        }
-
         if (not loc.contiguous()) {
             throw_Exception("Cannot gather field " + loc.name() +
                             " using IFS trans library as its data is not contiguous");
         }
+    }
+
+    // All fields with the same owner are gathered in a single call
+    for (const auto& owner : fields_per_owner(global_fieldset)) {
+        const idx_t root = owner.first;
+        SpectralBuffer loc_buffer(local_fieldset, owner.second, nb_spectral_coefficients());
+        SpectralBuffer glb_buffer(global_fieldset, owner.second, rank == root ? nb_spectral_coefficients_global() : 0);
+        loc_buffer.pack(local_fieldset);
+
+        std::vector<int> nto(loc_buffer.nfld, root + 1);
 
         struct ::GathSpec_t args = new_gathspec(*parallelisation_);
-        args.nfld                = nto.size();
-        args.rspecg              = glb.array().data<double>();
+        args.nfld                = int(nto.size());
+        args.rspecg              = glb_buffer.data;
         args.nto                 = nto.data();
-        args.rspec               = loc.array().data<double>();
+        args.rspec               = loc_buffer.data;
         TRANS_CHECK(::trans_gathspec(&args));
-#else
 
-        throw_Exception(
-            "Cannot gather spectral fields because Atlas has "
-            "not been compiled with TRANS support.");
-#endif
+        if (rank == root) {
+            glb_buffer.unpack(global_fieldset);
+        }
     }
+#else
+    throw_Exception(
+        "Cannot gather spectral fields because Atlas has "
+        "not been compiled with TRANS support.");
+#endif
 }
 void Spectral::gather(const Field& local, Field& global) const {
     FieldSet local_fields;
@@ -300,51 +388,62 @@ void Spectral::scatter(const FieldSet& global_fieldset, FieldSet& local_fieldset
 
     for (idx_t f = 0; f < local_fieldset.size(); ++f) {
         const Field& glb = global_fieldset[f];
-        Field& loc       = local_fieldset[f];
+        const Field& loc = local_fieldset[f];
         if (loc.datatype() != array::DataType::str<double>()) {
             std::stringstream err;
             err << "Cannot scatter spectral field " << glb.name() << " of datatype " << glb.datatype().str() << ".";
             err << "Only " << array::DataType::str<double>() << " supported.";
             throw_Exception(err.str(), Here());
         }
+    }
 
 #if ATLAS_HAVE_TRANS
-        idx_t root = 0;
-        idx_t rank = mpi::rank();
-
-        glb.metadata().get("owner", root);
+    idx_t rank = mpi::rank();
+    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
+        const Field& glb = global_fieldset[f];
+        const Field& loc = local_fieldset[f];
         ATLAS_ASSERT(loc.shape(0) == nb_spectral_coefficients());
-        if (rank == root) {
+        if (rank == glb.metadata().getInt("owner", 0)) {
             ATLAS_ASSERT(glb.shape(0) == nb_spectral_coefficients_global());
         }
-        std::vector<int> nfrom(1, root + 1);
-        if (loc.rank() > 1) {
-            nfrom.resize(loc.stride(0));
-            for (size_t i = 0; i < nfrom.size(); ++i) {
-                nfrom[i] = root + 1;
-            }
-        }
-
         if (not loc.contiguous()) {
             throw_Exception("Cannot scatter field " + glb.name() +
                             " using IFS trans library as its data is not contiguous");
         }
+    }
+
+    // All fields with the same owner are scattered in a single call
+    for (const auto& owner : fields_per_owner(global_fieldset)) {
+        const idx_t root = owner.first;
+        SpectralBuffer glb_buffer(global_fieldset, owner.second, rank == root ? nb_spectral_coefficients_global() : 0);
+        SpectralBuffer loc_buffer(local_fieldset, owner.second, nb_spectral_coefficients());
+        if (rank == root) {
+            glb_buffer.pack(global_fieldset);
+        }
+
+        std::vector<int> nfrom(loc_buffer.nfld, root + 1);
 
         struct ::DistSpec_t args = new_distspec(*parallelisation_);
         args.nfld                = int(nfrom.size());
-        args.rspecg              = glb.array().data<double>();
+        args.rspecg              = glb_buffer.data;
         args.nfrom               = nfrom.data();
-        args.rspec               = loc.array().data<double>();
+        args.rspec               = loc_buffer.data;
         TRANS_CHECK(::trans_distspec(&args));
 
-        glb.metadata().broadcast(loc.metadata(), root);
+        loc_buffer.unpack(local_fieldset);
+    }
+
+    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
+        const Field& glb = global_fieldset[f];
+        Field& loc       = local_fieldset[f];
+        glb.metadata().broadcast(loc.metadata(), glb.metadata().getInt("owner", 0));
         loc.metadata().set("global", false);
+    }
 #else
-        throw_Exception(
-            "Cannot scatter spectral fields because Atlas has "
-            "not been compiled with TRANS support.");
+    throw_Exception(
+        "Cannot scatter spectral fields because Atlas has "
+        "not been compiled with TRANS support.");
 #endif
-    }
 }
 void Spectral::scatter(const Field& global, Field& local) const {
     FieldSet global_fields;
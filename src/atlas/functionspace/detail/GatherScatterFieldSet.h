@@ -0,0 +1,107 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/parallel/GatherScatter.h"
+#include "atlas/runtime/Exception.h"
+
+// Gather and scatter of FieldSets shared by the NodeColumns and StructuredColumns function spaces
+
+namespace atlas {
+namespace functionspace {
+namespace detail {
+
+/// View of a field with shape (points, levels, variables), with dummy extents for missing levels or variables
+template <typename T, typename Field>
+array::LocalView<T, 3> make_leveled_view(Field& field) {
+    using namespace array;
+    if (field.levels()) {
+        if (field.variables()) {
+            return make_view<T, 3>(field).slice(Range::all(), Range::all(), Range::all());
+        }
+        else {
+            return make_view<T, 2>(field).slice(Range::all(), Range::all(), Range::dummy());
+        }
+    }
+    else {
+        if (field.variables()) {
+            return make_view<T, 2>(field).slice(Range::all(), Range::dummy(), Range::all());
+        }
+        else {
+            return make_view<T, 1>(field).slice(Range::all(), Range::dummy(), Range::dummy());
+        }
+    }
+}
+
+/// Indices of the fields of datatype Value, grouped by the rank owning their global field
+template <typename Value>
+std::map<idx_t, std::vector<idx_t>> fields_per_owner(const FieldSet& local_fieldset, const FieldSet& global_fieldset) {
+    std::map<idx_t, std::vector<idx_t>> fields;
+    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
+        if (local_fieldset[f].datatype() == array::DataType::kind<Value>()) {
+            idx_t root(0);
+            global_fieldset[f].metadata().get("owner", root);
+            fields[root].push_back(f);
+        }
+    }
+    return fields;
+}
+
+/// Gather all fields of datatype Value with the same owner together
+template <typename Value>
+void gather_fieldset(const parallel::GatherScatter& gather, const FieldSet& local_fieldset,
+                     FieldSet& global_fieldset) {
+    for (const auto& owner : fields_per_owner<Value>(local_fieldset, global_fieldset)) {
+        std::vector<parallel::Field<Value const>> loc_fields;
+        std::vector<parallel::Field<Value>> glb_fields;
+        for (idx_t f : owner.second) {
+            loc_fields.emplace_back(make_leveled_view<const Value>(local_fieldset[f]));
+            glb_fields.emplace_back(make_leveled_view<Value>(global_fieldset[f]));
+        }
+        gather.gather(loc_fields.data(), glb_fields.data(), static_cast<idx_t>(owner.second.size()), owner.first);
+    }
+}
+
+/// Scatter all fields of datatype Value with the same owner together
+template <typename Value>
+void scatter_fieldset(const parallel::GatherScatter& scatter, const FieldSet& global_fieldset,
+                      FieldSet& local_fieldset) {
+    for (const auto& owner : fields_per_owner<Value>(local_fieldset, global_fieldset)) {
+        std::vector<parallel::Field<Value const>> glb_fields;
+        std::vector<parallel::Field<Value>> loc_fields;
+        for (idx_t f : owner.second) {
+            glb_fields.emplace_back(make_leveled_view<const Value>(global_fieldset[f]));
+            loc_fields.emplace_back(make_leveled_view<Value>(local_fieldset[f]));
+        }
+        scatter.scatter(glb_fields.data(), loc_fields.data(), static_cast<idx_t>(owner.second.size()), owner.first);
+    }
+}
+
+/// Throw if a field has a datatype which cannot be gathered or scattered
+inline void check_datatypes(const FieldSet& fieldset) {
+    for (idx_t f = 0; f < fieldset.size(); ++f) {
+        const auto datatype = fieldset[f].datatype();
+        if (datatype != array::DataType::kind<int>() && datatype != array::DataType::kind<long>() &&
+            datatype != array::DataType::kind<float>() && datatype != array::DataType::kind<double>()) {
+            throw_Exception("datatype not supported", Here());
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace functionspace
+}  // namespace atlas
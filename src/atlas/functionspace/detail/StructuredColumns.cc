@@ -12,6 +12,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -22,6 +23,7 @@
 #include "atlas/array/MakeView.h"
 #include "atlas/domain.h"
 #include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/detail/GatherScatterFieldSet.h"
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Partitioner.h"
 #include "atlas/grid/StructuredGrid.h"
@@ -49,27 +51,6 @@ namespace detail {
 
 namespace {
 
-template <typename T, typename Field>
-array::LocalView<T, 3> make_leveled_view(Field& field) {
-    using namespace array;
-    if (field.levels()) {
-        if (field.variables()) {
-            return make_view<T, 3>(field).slice(Range::all(), Range::all(), Range::all());
-        }
-        else {
-            return make_view<T, 2>(field).slice(Range::all(), Range::all(), Range::dummy());
-        }
-    }
-    else {
-        if (field.variables()) {
-            return make_view<T, 2>(field).slice(Range::all(), Range::dummy(), Range::all());
-        }
-        else {
-            return make_view<T, 1>(field).slice(Range::all(), Range::dummy(), Range::dummy());
-        }
-    }
-}
-
 template <typename T>
 std::string checksum_3d_field(const parallel::Checksum& checksum, const Field& field) {
     bool disabled_fpe_overflow = library::disable_floating_point_exception(FE_OVERFLOW);
@@ -584,37 +565,11 @@ Field StructuredColumns::createField(const Field& other, const eckit::Configurat
 void StructuredColumns::gather(const FieldSet& local_fieldset, FieldSet& global_fieldset) const {
     ATLAS_ASSERT(local_fieldset.size() == global_fieldset.size());
 
-    for (idx_t f = 0; f < local_fieldset.size(); ++f) {
-        const Field& loc      = local_fieldset[f];
-        Field& glb            = global_fieldset[f];
-        const idx_t nb_fields = 1;
-        idx_t root(0);
-        glb.metadata().get("owner", root);
-
-        if (loc.datatype() == array::DataType::kind<int>()) {
-            parallel::Field<int const> loc_field(make_leveled_view<const int>(loc));
-            parallel::Field<int> glb_field(make_leveled_view<int>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<long>()) {
-            parallel::Field<long const> loc_field(make_leveled_view<const long>(loc));
-            parallel::Field<long> glb_field(make_leveled_view<long>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<float>()) {
-            parallel::Field<float const> loc_field(make_leveled_view<const float>(loc));
-            parallel::Field<float> glb_field(make_leveled_view<float>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<double>()) {
-            parallel::Field<double const> loc_field(make_leveled_view<const double>(loc));
-            parallel::Field<double> glb_field(make_leveled_view<double>(glb));
-            gather().gather(&loc_field, &glb_field, nb_fields, root);
-        }
-        else {
-            throw_Exception("datatype not supported", Here());
-        }
-    }
+    check_datatypes(local_fieldset);
+    gather_fieldset<int>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<long>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<float>(gather(), local_fieldset, global_fieldset);
+    gather_fieldset<double>(gather(), local_fieldset, global_fieldset);
 }
 // ----------------------------------------------------------------------------
 
@@ -636,37 +591,17 @@ void StructuredColumns::gather(const Field& local, Field& global) const {
 void StructuredColumns::scatter(const FieldSet& global_fieldset, FieldSet& local_fieldset) const {
     ATLAS_ASSERT(local_fieldset.size() == global_fieldset.size());
 
+    check_datatypes(local_fieldset);
+    scatter_fieldset<int>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<long>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<float>(scatter(), global_fieldset, local_fieldset);
+    scatter_fieldset<double>(scatter(), global_fieldset, local_fieldset);
+
     for (idx_t f = 0; f < local_fieldset.size(); ++f) {
-        const Field& glb      = global_fieldset[f];
-        Field& loc            = local_fieldset[f];
-        const idx_t nb_fields = 1;
+        const Field& glb = global_fieldset[f];
+        Field& loc       = local_fieldset[f];
         idx_t root(0);
         glb.metadata().get("owner", root);
-
-        if (loc.datatype() == array::DataType::kind<int>()) {
-            parallel::Field<int const> glb_field(make_leveled_view<const int>(glb));
-            parallel::Field<int> loc_field(make_leveled_view<int>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<long>()) {
-            parallel::Field<long const> glb_field(make_leveled_view<const long>(glb));
-            parallel::Field<long> loc_field(make_leveled_view<long>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<float>()) {
-            parallel::Field<float const> glb_field(make_leveled_view<const float>(glb));
-            parallel::Field<float> loc_field(make_leveled_view<float>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else if (loc.datatype() == array::DataType::kind<double>()) {
-            parallel::Field<double const> glb_field(make_leveled_view<const double>(glb));
-            parallel::Field<double> loc_field(make_leveled_view<double>(loc));
-            scatter().scatter(&glb_field, &loc_field, nb_fields, root);
-        }
-        else {
-            throw_Exception("datatype not supported", Here());
-        }
-
         glb.metadata().broadcast(loc.metadata(), root);
         loc.metadata().set("global", false);
     }
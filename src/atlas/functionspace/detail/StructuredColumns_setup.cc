@@ -10,6 +10,7 @@
 
 #include "atlas/functionspace/StructuredColumns.h"
 
+#include <algorithm>
 #include <functional>
 #include <iomanip>
 #include <numeric>
@@ -113,6 +114,7 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
     i_begin_.resize(grid_->ny(), std::numeric_limits<idx_t>::max());
     i_end_.resize(grid_->ny(), std::numeric_limits<idx_t>::min());
     idx_t owned(0);
+    std::vector<grid::Distribution::Range> owned_ranges;
 
     ATLAS_TRACE_SCOPE("Compute bounds owned") {
         if (nb_partitions_ == 1) {
@@ -124,6 +126,31 @@ void StructuredColumns::setup(const grid::Distribution& distribution, const ecki
             }
             owned = grid_->size();
         }
+        else if (distribution.partition_ranges(part_, owned_ranges)) {
+            // Only visit the rows overlapping the owned ranges of global indices
+            std::vector<gidx_t> row_begin(grid_->ny() + 1);
+            row_begin[0] = 0;
+            for (idx_t j = 0; j < grid_->ny(); ++j) {
+                row_begin[j + 1] = row_begin[j] + grid_->nx(j);
+            }
+            for (const auto& range : owned_ranges) {
+                if (range.first >= range.second) {
+                    continue;
+                }
+                idx_t j = static_cast<idx_t>(std::upper_bound(row_begin.begin(), row_begin.end(), range.first) -
+                                             row_begin.begin()) -
+                          1;
+                for (; j < grid_->ny() && row_begin[j] < range.second; ++j) {
+                    idx_t i_begin = static_cast<idx_t>(std::max(range.first, row_begin[j]) - row_begin[j]);
+                    idx_t i_end   = static_cast<idx_t>(std::min(range.second, row_begin[j + 1]) - row_begin[j]);
+                    j_begin_      = std::min<idx_t>(j_begin_, j);
+                    j_end_        = std::max<idx_t>(j_end_, j + 1);
+                    i_begin_[j]   = std::min<idx_t>(i_begin_[j], i_begin);
+                    i_end_[j]     = std::max<idx_t>(i_end_[j], i_end);
+                    owned += i_end - i_begin;
+                }
+            }
+        }
         else {
             size_t num_threads = atlas_omp_get_max_threads();
             if (num_threads == 1) {
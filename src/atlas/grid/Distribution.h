@@ -33,6 +33,7 @@ class Distribution : DOXYGEN_HIDE(public util::ObjectHandle<DistributionImpl>) {
 
 public:
     using Config      = DistributionImpl::Config;
+    using Range       = DistributionImpl::Range;
     using partition_t = atlas::vector<int>;
 
     using Handle::Handle;
@@ -63,6 +64,12 @@ public:
         return get()->partition(begin, end, partitions.data());
     }
 
+    /// @brief Half-open ranges of global indices owned by given partition, in increasing order
+    /// @return false if the distribution can only answer this by testing every global index
+    bool partition_ranges(int partition, std::vector<Range>& ranges) const {
+        return get()->partition_ranges(partition, ranges);
+    }
+
     size_t footprint() const { return get()->footprint(); }
 
     ATLAS_ALWAYS_INLINE idx_t nb_partitions() const { return get()->nb_partitions(); }
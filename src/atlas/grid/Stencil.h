@@ -11,6 +11,8 @@
 #pragma once
 
 #include <array>
+#include <vector>
+
 #include "atlas/library/config.h"
 
 namespace atlas {
@@ -18,9 +20,15 @@ namespace grid {
 
 //---------------------------------------------------------------------------------------------------------------------
 
+template <idx_t StencilWidth>
+class HorizontalStencils;
+
+//---------------------------------------------------------------------------------------------------------------------
+
 template <idx_t StencilWidth>
 class HorizontalStencil {
     friend class ComputeHorizontalStencil;
+    friend class HorizontalStencils<StencilWidth>;
     std::array<idx_t, StencilWidth> i_begin_;
     idx_t j_begin_;
 
@@ -32,6 +40,44 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/// @class HorizontalStencils
+/// @brief Horizontal stencils of a batch of points, stored as structure of arrays
+///
+/// Filled by ComputeHorizontalStencil for many points at once, so that the computation vectorises.
+template <idx_t StencilWidth>
+class HorizontalStencils {
+    friend class ComputeHorizontalStencil;
+    std::array<std::vector<idx_t>, StencilWidth> i_begin_;
+    std::vector<idx_t> j_begin_;
+
+public:
+    HorizontalStencils() = default;
+    explicit HorizontalStencils(idx_t size) { resize(size); }
+
+    void resize(idx_t size) {
+        for (auto& i_begin : i_begin_) {
+            i_begin.resize(size);
+        }
+        j_begin_.resize(size);
+    }
+
+    idx_t size() const { return static_cast<idx_t>(j_begin_.size()); }
+    idx_t i(idx_t n, idx_t offset_i, idx_t offset_j) const { return i_begin_[offset_j][n] + offset_i; }
+    idx_t j(idx_t n, idx_t offset) const { return j_begin_[n] + offset; }
+    constexpr idx_t width() const { return StencilWidth; }
+
+    /// @brief Copy the stencil of point n into a single-point stencil, e.g. HorizontalStencil or Stencil3D
+    template <typename stencil_t>
+    void get(idx_t n, stencil_t& stencil) const {
+        stencil.j_begin_ = j_begin_[n];
+        for (idx_t jj = 0; jj < StencilWidth; ++jj) {
+            stencil.i_begin_[jj] = i_begin_[jj][n];
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+
 template <idx_t StencilWidth>
 class VerticalStencil {
     friend class ComputeVerticalStencil;
@@ -56,6 +102,7 @@ template <idx_t StencilWidth>
 class Stencil3D {
     friend class ComputeHorizontalStencil;
     friend class ComputeVerticalStencil;
+    friend class HorizontalStencils<StencilWidth>;
     std::array<idx_t, StencilWidth> i_begin_;
     idx_t j_begin_;
     idx_t k_begin_;
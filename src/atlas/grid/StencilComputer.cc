@@ -9,6 +9,9 @@
  */
 
 #include "atlas/grid/StencilComputer.h"
+
+#include <limits>
+
 #include "atlas/grid/StructuredGrid.h"
 #include "atlas/runtime/Exception.h"
 
@@ -64,7 +67,34 @@ ComputeNorth::ComputeNorth(const StructuredGrid& grid, idx_t halo) {
         idx_t jj      = 2 * ny_ - j - 1 - south_pole_included;
         y_[halo_ + j] = -180. - grid.y(jj) + tol();
     }
-    dy_ = std::abs(grid.y(1) - grid.y(0));
+
+    // Uniform lookup table, with intervals small enough that an interval and its neighbours contain
+    // at most one distinct row latitude (possibly duplicated in the halo when a pole is included)
+    double dy = std::numeric_limits<double>::max();
+    for (size_t jj = 0; jj + 1 < y_.size(); ++jj) {
+        if (y_[jj] > y_[jj + 1]) {
+            dy = std::min(dy, y_[jj] - y_[jj + 1]);
+        }
+    }
+    const double dy_lookup = 0.25 * dy;
+    y_lookup_begin_        = y_.front();
+    rdy_lookup_            = 1. / dy_lookup;
+    idx_t nb_lookup        = static_cast<idx_t>(std::ceil((y_.front() - y_.back()) * rdy_lookup_)) + 1;
+    lookup_max_            = nb_lookup - 1;
+    lookup_.resize(nb_lookup);
+
+    // Entry k is the southernmost row with latitude >= upper bound of interval k-1
+    idx_t jj = 0;
+    for (idx_t k = 0; k < nb_lookup; ++k) {
+        const double y_upper = y_lookup_begin_ - (k - 1) * dy_lookup;
+        while (jj + 1 < static_cast<idx_t>(y_.size()) && y_[jj + 1] >= y_upper) {
+            ++jj;
+        }
+        lookup_[k] = jj;
+    }
+
+    // Sentinel, so that the row following the southernmost row can always be tested
+    y_.push_back(std::numeric_limits<double>::lowest());
 }
 
 ComputeWest::ComputeWest(const StructuredGrid& grid, idx_t halo) {
@@ -76,20 +106,20 @@ ComputeWest::ComputeWest(const StructuredGrid& grid, idx_t halo) {
     idx_t north_pole_included = 90. - std::abs(grid.y().front()) < tol();
     idx_t south_pole_included = 90. - std::abs(grid.y().back()) < tol();
     ny_                       = grid.ny();
-    dx.resize(ny_ + 2 * halo_);
+    rdx.resize(ny_ + 2 * halo_);
     xref.resize(ny_ + 2 * halo_);
     for (idx_t j = -halo_; j < 0; ++j) {
         idx_t jj        = -j - 1 + north_pole_included;
-        dx[halo_ + j]   = grid.x(1, jj) - grid.x(0, jj);
+        rdx[halo_ + j]  = 1. / (grid.x(1, jj) - grid.x(0, jj));
         xref[halo_ + j] = grid.x(0, jj) - tol();
     }
     for (idx_t j = 0; j < ny_; ++j) {
-        dx[halo_ + j]   = std::abs(grid.x(1, j) - grid.x(0, j));
+        rdx[halo_ + j]  = 1. / std::abs(grid.x(1, j) - grid.x(0, j));
         xref[halo_ + j] = grid.x(0, j) - tol();
     }
     for (idx_t j = ny_; j < ny_ + halo_; ++j) {
         idx_t jj        = 2 * ny_ - j - 1 - south_pole_included;
-        dx[halo_ + j]   = std::abs(grid.x(1, jj) - grid.x(0, jj));
+        rdx[halo_ + j]  = 1. / std::abs(grid.x(1, jj) - grid.x(0, jj));
         xref[halo_ + j] = grid.x(0, jj) - tol();
     }
 }
@@ -10,11 +10,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
+#include "atlas/grid/Stencil.h"
 #include "atlas/grid/Vertical.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 
 namespace atlas {
@@ -52,8 +55,11 @@ public:
 //-----------------------------------------------------------------------------
 
 class ComputeNorth {
-    std::vector<double> y_;
-    double dy_;
+    std::vector<double> y_;        // latitudes of rows including halo, followed by a sentinel
+    std::vector<idx_t> lookup_;    // first guess of the index into y_, per interval of a uniform lookup table
+    double y_lookup_begin_;        // latitude of the start of the lookup table
+    double rdy_lookup_;            // reciprocal spacing of the lookup table
+    double lookup_max_;            // last interval of the lookup table
     idx_t halo_;
     idx_t ny_;
     static constexpr double tol() { return 0.5e-6; }
@@ -63,24 +69,23 @@ public:
 
     ComputeNorth(const StructuredGrid& grid, idx_t halo);
 
+    /// @brief Index j of the southernmost row with latitude y_j >= y (within tolerance), without branches
+    ///
+    /// The lookup table intervals are small enough that the guess is at most two rows north of the result.
+    /// Two rows are needed only where a row is duplicated in the halo, across a pole contained in the grid.
     idx_t operator()(double y) const {
-        idx_t j = static_cast<idx_t>(std::floor((y_[halo_ + 0] - y) / dy_));
-        j       = std::max<idx_t>(halo_, std::min<idx_t>(j, halo_ + ny_ - 1));
-        while (y_[halo_ + j] > y) {
-            ++j;
-        }
-        do {
-            --j;
-        } while (y_[halo_ + j] < y);
-
-        return j;
+        const double k = std::min(std::max((y_lookup_begin_ - y) * rdy_lookup_, 0.), lookup_max_);
+        idx_t jj       = lookup_[static_cast<idx_t>(k)];
+        jj += (y_[jj + 1] >= y);
+        jj += (y_[jj + 1] >= y);
+        return jj - halo_;
     }
 };
 
 //-----------------------------------------------------------------------------
 
 class ComputeWest {
-    std::vector<double> dx;
+    std::vector<double> rdx;
     std::vector<double> xref;
     idx_t halo_;  // halo in north-south direction
     idx_t ny_;
@@ -93,7 +98,7 @@ public:
 
     idx_t operator()(const double& x, idx_t j) const {
         idx_t jj = halo_ + j;
-        idx_t i  = static_cast<idx_t>(std::floor((x - xref[jj]) / dx[jj]));
+        idx_t i  = static_cast<idx_t>(std::floor((x - xref[jj]) * rdx[jj]));
         return i;
     }
 };
@@ -145,6 +150,30 @@ public:
             stencil.i_begin_[jj] = compute_west_(x, stencil.j_begin_ + jj) - stencil_begin_;
         }
     }
+
+    /// @brief Compute the stencils of n points with coordinates (x[p], y[p]) into stencils[p], for p < n
+    ///
+    /// Equivalent to computing each stencil separately, but written as branch-free loops over the points
+    /// so that they vectorise.
+    template <idx_t StencilWidth>
+    void operator()(idx_t n, const double x[], const double y[], HorizontalStencils<StencilWidth>& stencils) const {
+        ATLAS_ASSERT(stencil_width_ == StencilWidth);
+        if (stencils.size() < n) {
+            stencils.resize(n);
+        }
+        idx_t* j_begin = stencils.j_begin_.data();
+        atlas_omp_pragma(omp simd)
+        for (idx_t p = 0; p < n; ++p) {
+            j_begin[p] = compute_north_(y[p]) - stencil_begin_;
+        }
+        for (idx_t jj = 0; jj < StencilWidth; ++jj) {
+            idx_t* i_begin = stencils.i_begin_[jj].data();
+            atlas_omp_pragma(omp simd)
+            for (idx_t p = 0; p < n; ++p) {
+                i_begin[p] = compute_west_(x[p], j_begin[p] + jj) - stencil_begin_;
+            }
+        }
+    }
 };
 
 
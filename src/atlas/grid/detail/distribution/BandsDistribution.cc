@@ -40,6 +40,7 @@ BandsDistribution<Int>::BandsDistribution(const atlas::Grid& grid, atlas::idx_t
     }
 
     this->nb_pts_.reserve(nb_partitions_Int_);
+    part_begin_.reserve(nb_partitions_Int_ + 1);
 
     for (idx_t iproc = 0; iproc < nb_partitions; iproc++) {
         // Approximate values
@@ -74,7 +75,9 @@ BandsDistribution<Int>::BandsDistribution(const atlas::Grid& grid, atlas::idx_t
 
         imax = std::min(imax, (gidx_t)gridsize);
         this->nb_pts_.push_back(imax - imin);
+        part_begin_.push_back(imin);
     }
+    part_begin_.push_back(gridsize);
 
     this->max_pts_ = *std::max_element(this->nb_pts_.begin(), this->nb_pts_.end());
     this->min_pts_ = *std::min_element(this->nb_pts_.begin(), this->nb_pts_.end());
@@ -82,6 +85,16 @@ BandsDistribution<Int>::BandsDistribution(const atlas::Grid& grid, atlas::idx_t
     ATLAS_ASSERT(detectOverflow(gridsize, nb_partitions_Int_, blocksize_) == false);
 }
 
+template <typename Int>
+bool BandsDistribution<Int>::partition_ranges(int partition, std::vector<DistributionImpl::Range>& ranges) const {
+    // Bands are contiguous in global index
+    ranges.clear();
+    if (this->nb_pts_[partition] > 0) {
+        ranges.emplace_back(part_begin_[partition], part_begin_[partition] + this->nb_pts_[partition]);
+    }
+    return true;
+}
+
 template <typename Int>
 bool BandsDistribution<Int>::detectOverflow(size_t gridsize, size_t nb_partitions, size_t blocksize) {
     int64_t size                 = gridsize;
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "atlas/grid/detail/distribution/DistributionFunction.h"
 
@@ -25,6 +26,7 @@ private:
     Int blocksize_;
     Int nb_blocks_;
     Int nb_partitions_Int_;
+    std::vector<gidx_t> part_begin_;  // first global index of each partition, plus total size
 
 public:
     BandsDistribution(const Grid& grid, idx_t nb_partitions, const std::string& type, size_t blocksize = 1);
@@ -34,6 +36,8 @@ public:
         return (iblock * nb_partitions_Int_) / nb_blocks_;
     }
 
+    bool partition_ranges(int partition, std::vector<DistributionImpl::Range>& ranges) const override;
+
     static bool detectOverflow(size_t gridsize, size_t nb_partitions, size_t blocksize);
 };
 
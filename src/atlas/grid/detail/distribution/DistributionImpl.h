@@ -11,6 +11,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "atlas/library/config.h"
@@ -44,6 +45,7 @@ namespace grid {
 class DistributionImpl : public util::Object {
 public:
     using Config = atlas::util::Config;
+    using Range  = std::pair<gidx_t, gidx_t>;
     virtual ~DistributionImpl() {}
     virtual int partition(const gidx_t gidx) const = 0;
     virtual bool functional() const                = 0;
@@ -64,6 +66,10 @@ public:
     virtual void hash(eckit::Hash&) const = 0;
 
     virtual void partition(gidx_t begin, gidx_t end, int partitions[]) const = 0;
+
+    /// @brief Half-open ranges [first, second) of global indices owned by given partition, in increasing order
+    /// @return false if the ranges cannot be computed without testing every global index
+    virtual bool partition_ranges(int /*partition*/, std::vector<Range>& /*ranges*/) const { return false; }
 };
 
 
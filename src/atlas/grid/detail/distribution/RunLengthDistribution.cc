@@ -0,0 +1,135 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "RunLengthDistribution.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "eckit/types/Types.h"
+#include "eckit/utils/Hash.h"
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+RunLengthDistribution::RunLengthDistribution(int nb_partitions, std::vector<gidx_t>&& run_begin,
+                                             std::vector<int>&& run_part, const std::string& type):
+    nb_partitions_(nb_partitions), run_begin_(std::move(run_begin)), run_part_(std::move(run_part)), type_(type) {
+    ATLAS_ASSERT(run_begin_.size() == run_part_.size() + 1);
+    setup();
+}
+
+RunLengthDistribution::RunLengthDistribution(int nb_partitions, gidx_t size, const int partition[],
+                                             const std::string& type):
+    nb_partitions_(nb_partitions), type_(type) {
+    size_t nb_runs = RunLengthDistribution::nb_runs(size, partition);
+    run_begin_.reserve(nb_runs + 1);
+    run_part_.reserve(nb_runs);
+    for (gidx_t n = 0; n < size; ++n) {
+        if (n == 0 || partition[n] != partition[n - 1]) {
+            run_begin_.emplace_back(n);
+            run_part_.emplace_back(partition[n]);
+        }
+    }
+    run_begin_.emplace_back(size);
+    setup();
+}
+
+size_t RunLengthDistribution::nb_runs(gidx_t size, const int partition[]) {
+    size_t nb_runs = size > 0 ? 1 : 0;
+    for (gidx_t n = 1; n < size; ++n) {
+        if (partition[n] != partition[n - 1]) {
+            ++nb_runs;
+        }
+    }
+    return nb_runs;
+}
+
+bool RunLengthDistribution::compressible(gidx_t size, const int partition[]) {
+    return nb_runs(size, partition) * (sizeof(gidx_t) + sizeof(int)) < size * sizeof(int);
+}
+
+void RunLengthDistribution::setup() {
+    ATLAS_ASSERT(run_begin_.front() == 0);
+    nb_pts_.assign(nb_partitions_, 0);
+    for (size_t r = 0; r < run_part_.size(); ++r) {
+        ATLAS_ASSERT(run_begin_[r] < run_begin_[r + 1]);
+        nb_pts_[run_part_[r]] += run_begin_[r + 1] - run_begin_[r];
+    }
+    max_pts_ = *std::max_element(nb_pts_.begin(), nb_pts_.end());
+    min_pts_ = *std::min_element(nb_pts_.begin(), nb_pts_.end());
+}
+
+size_t RunLengthDistribution::run(gidx_t gidx) const {
+    return static_cast<size_t>(std::upper_bound(run_begin_.begin(), run_begin_.end(), gidx) - run_begin_.begin()) - 1;
+}
+
+int RunLengthDistribution::partition(const gidx_t gidx) const {
+    return run_part_[run(gidx)];
+}
+
+void RunLengthDistribution::partition(gidx_t begin, gidx_t end, int partitions[]) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t r = run(begin);
+    for (gidx_t n = begin; n < end; ++r) {
+        gidx_t run_end = std::min(run_begin_[r + 1], end);
+        std::fill(partitions + (n - begin), partitions + (run_end - begin), run_part_[r]);
+        n = run_end;
+    }
+}
+
+bool RunLengthDistribution::partition_ranges(int partition, std::vector<Range>& ranges) const {
+    ranges.clear();
+    for (size_t r = 0; r < run_part_.size(); ++r) {
+        if (run_part_[r] == partition) {
+            ranges.emplace_back(run_begin_[r], run_begin_[r + 1]);
+        }
+    }
+    return true;
+}
+
+size_t RunLengthDistribution::footprint() const {
+    return nb_pts_.size() * sizeof(nb_pts_[0]) + run_begin_.size() * sizeof(run_begin_[0]) +
+           run_part_.size() * sizeof(run_part_[0]);
+}
+
+void RunLengthDistribution::print(std::ostream& s) const {
+    auto print_partition = [&](std::ostream& s) {
+        eckit::output_list<int> list_printer(s);
+        for (size_t r = 0; r < run_part_.size(); ++r) {
+            for (gidx_t n = run_begin_[r]; n < run_begin_[r + 1]; ++n) {
+                list_printer.push_back(run_part_[r]);
+            }
+        }
+    };
+    s << "Distribution( "
+      << "type: " << type_ << ", nb_points: " << size() << ", nb_partitions: " << nb_pts_.size() << ", parts : ";
+    print_partition(s);
+}
+
+void RunLengthDistribution::hash(eckit::Hash& hash) const {
+    // Same hash as the equivalent dense DistributionArray
+    for (size_t r = 0; r < run_part_.size(); ++r) {
+        for (gidx_t n = run_begin_[r]; n < run_begin_[r + 1]; ++n) {
+            hash.add(run_part_[r]);
+        }
+    }
+}
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
@@ -0,0 +1,86 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "atlas/grid/detail/distribution/DistributionImpl.h"
+
+namespace atlas {
+namespace grid {
+namespace detail {
+namespace distribution {
+
+/// @brief Distribution stored as runs of consecutive global indices that belong to the same partition
+///
+/// Run r covers the global indices [ run_begin[r], run_begin[r+1] ) and belongs to partition run_part[r].
+/// Memory scales with the number of runs rather than with the number of grid points.
+class RunLengthDistribution : public DistributionImpl {
+public:
+    RunLengthDistribution(int nb_partitions, std::vector<gidx_t>&& run_begin, std::vector<int>&& run_part,
+                          const std::string& type);
+
+    /// @brief Compress a dense partition array
+    RunLengthDistribution(int nb_partitions, gidx_t size, const int partition[], const std::string& type);
+
+    /// @brief Number of runs needed to represent the dense partition array
+    static size_t nb_runs(gidx_t size, const int partition[]);
+
+    /// @brief True if the run-length representation uses less memory than the dense partition array
+    static bool compressible(gidx_t size, const int partition[]);
+
+    int partition(const gidx_t gidx) const override;
+
+    void partition(gidx_t begin, gidx_t end, int partitions[]) const override;
+
+    bool partition_ranges(int partition, std::vector<Range>& ranges) const override;
+
+    bool functional() const override { return false; }
+
+    idx_t nb_partitions() const override { return nb_partitions_; }
+
+    gidx_t size() const override { return run_begin_.back(); }
+
+    const std::vector<idx_t>& nb_pts() const override { return nb_pts_; }
+
+    idx_t max_pts() const override { return max_pts_; }
+    idx_t min_pts() const override { return min_pts_; }
+
+    const std::string& type() const override { return type_; }
+
+    void print(std::ostream&) const override;
+
+    size_t footprint() const override;
+
+    void hash(eckit::Hash&) const override;
+
+    size_t nb_runs() const { return run_part_.size(); }
+
+private:
+    void setup();
+
+    size_t run(gidx_t gidx) const;
+
+private:
+    idx_t nb_partitions_;
+    std::vector<gidx_t> run_begin_;  // size nb_runs + 1
+    std::vector<int> run_part_;      // size nb_runs
+    std::vector<idx_t> nb_pts_;
+    idx_t max_pts_;
+    idx_t min_pts_;
+    std::string type_;
+};
+
+}  // namespace distribution
+}  // namespace detail
+}  // namespace grid
+}  // namespace atlas
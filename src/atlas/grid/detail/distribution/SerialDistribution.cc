@@ -35,6 +35,14 @@ SerialDistribution::SerialDistribution(const Grid& grid, int part): Distribution
     part_          = part;
 }
 
+bool SerialDistribution::partition_ranges(int partition, std::vector<Range>& ranges) const {
+    ranges.clear();
+    if (partition == part_) {
+        ranges.emplace_back(0, size_);
+    }
+    return true;
+}
+
 
 }  // namespace distribution
 }  // namespace detail
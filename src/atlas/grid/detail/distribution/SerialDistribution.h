@@ -24,6 +24,8 @@ public:
 
     ATLAS_ALWAYS_INLINE int function(gidx_t gidx) const { return part_; }
 
+    bool partition_ranges(int partition, std::vector<Range>& ranges) const override;
+
 private:
     int part_{0};
 };
@@ -15,10 +15,15 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "atlas/grid/Iterator.h"
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/StructuredGrid.h"
+#include "atlas/grid/detail/distribution/RunLengthDistribution.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/sort.h"
@@ -612,6 +617,193 @@ void EqualRegionsPartitioner::partition(int nb_nodes, NodeInt nodes[], int part[
     // ((double)CLOCKS_PER_SEC) << "s)" << std::endl;
 }
 
+namespace {
+
+/// Rows [j_begin, j_end) of a band of a structured grid, with the points [i_begin[j], i_end[j]) of each row
+/// that belong to the band.
+/// Within a band, points are ordered as with compare_WE_NS: west to east, then north to south.
+class StructuredBand {
+public:
+    StructuredBand(const StructuredGrid& grid, const std::vector<gidx_t>& row_begin, gidx_t begin, gidx_t end):
+        grid_(grid) {
+        if (begin >= end) {
+            j_begin_ = j_end_ = 0;
+            return;
+        }
+        j_begin_ = std::upper_bound(row_begin.begin(), row_begin.end(), begin) - row_begin.begin() - 1;
+        j_end_   = std::lower_bound(row_begin.begin(), row_begin.end(), end) - row_begin.begin();
+        for (idx_t j = j_begin_; j < j_end_; ++j) {
+            i_begin_.emplace_back(std::max(begin, row_begin[j]) - row_begin[j]);
+            i_end_.emplace_back(std::min(end, row_begin[j + 1]) - row_begin[j]);
+            y_.emplace_back(microdeg(grid.y(j)));
+        }
+    }
+
+    idx_t j_begin() const { return j_begin_; }
+    idx_t j_end() const { return j_end_; }
+
+    /// For the point at position s in the band ordering, compute for each row the first i that comes at or after
+    /// position s
+    void split(gidx_t s, std::vector<idx_t>& i_split) const {
+        const idx_t nb_rows = j_end_ - j_begin_;
+        i_split.resize(nb_rows);
+
+        // Smallest x for which more than s points have a smaller or equal x
+        int x_lo = std::numeric_limits<int>::max();
+        int x_hi = std::numeric_limits<int>::min();
+        for (idx_t r = 0; r < nb_rows; ++r) {
+            if (i_end_[r] > i_begin_[r]) {
+                x_lo = std::min(x_lo, x(r, i_begin_[r]));
+                x_hi = std::max(x_hi, x(r, i_end_[r] - 1));
+            }
+        }
+        while (x_lo < x_hi) {
+            int x_mid = x_lo + (x_hi - x_lo) / 2;
+            if (count_le(x_mid) > s) {
+                x_hi = x_mid;
+            }
+            else {
+                x_lo = x_mid + 1;
+            }
+        }
+        const int x_split = x_lo;
+
+        // Points with x < x_split come first; points with x == x_split are ordered north to south
+        gidx_t before = 0;
+        std::vector<std::pair<int, idx_t>> equal;  // (y, row)
+        for (idx_t r = 0; r < nb_rows; ++r) {
+            i_split[r] = upper_bound(r, x_split - 1);
+            before += i_split[r] - i_begin_[r];
+            if (upper_bound(r, x_split) > i_split[r]) {
+                equal.emplace_back(y_[r], r);
+            }
+        }
+        std::stable_sort(equal.begin(), equal.end(),
+                         [](const std::pair<int, idx_t>& a, const std::pair<int, idx_t>& b) { return a.first > b.first; });
+        for (const auto& e : equal) {
+            if (before == s) {
+                break;
+            }
+            idx_t r         = e.second;
+            idx_t available = upper_bound(r, x_split) - i_split[r];
+            idx_t take      = static_cast<idx_t>(std::min<gidx_t>(available, s - before));
+            i_split[r] += take;
+            before += take;
+        }
+        ATLAS_ASSERT(before == s);
+    }
+
+    idx_t i_begin(idx_t j) const { return i_begin_[j - j_begin_]; }
+    idx_t i_end(idx_t j) const { return i_end_[j - j_begin_]; }
+
+private:
+    int x(idx_t r, idx_t i) const { return microdeg(grid_.x(i, j_begin_ + r)); }
+
+    /// First i in row r with x(i) > x_max
+    idx_t upper_bound(idx_t r, int x_max) const {
+        idx_t lo = i_begin_[r];
+        idx_t hi = i_end_[r];
+        while (lo < hi) {
+            idx_t mid = lo + (hi - lo) / 2;
+            if (x(r, mid) <= x_max) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    gidx_t count_le(int x_max) const {
+        gidx_t count = 0;
+        for (idx_t r = 0; r < j_end_ - j_begin_; ++r) {
+            count += upper_bound(r, x_max) - i_begin_[r];
+        }
+        return count;
+    }
+
+    const StructuredGrid& grid_;
+    idx_t j_begin_;
+    idx_t j_end_;
+    std::vector<idx_t> i_begin_;
+    std::vector<idx_t> i_end_;
+    std::vector<int> y_;
+};
+
+}  // namespace
+
+Distribution EqualRegionsPartitioner::partition(const Grid& grid) const {
+    StructuredGrid structured_grid(grid);
+    if (N_ == 1 || not structured_grid || coordinates_ != Coordinates::XY) {
+        return Partitioner::partition(grid);
+    }
+    ATLAS_TRACE("EqualRegionsPartitioner::partition");
+    ATLAS_ASSERT(grid.projection().units() == "degrees");
+    ATLAS_ASSERT(structured_grid.x(1, 0) > structured_grid.x(0, 0));
+
+    // Same number of points per partition as EqualRegionsPartitioner::partition(const Grid&, int[])
+    const gidx_t nb_nodes        = grid.size();
+    const gidx_t chunk_size      = nb_nodes / N_;
+    const gidx_t chunk_remainder = nb_nodes - chunk_size * N_;
+    std::vector<gidx_t> displs(N_ + 1);
+    displs[0] = 0;
+    for (int p = 0; p < N_; ++p) {
+        displs[p + 1] = displs[p] + chunk_size + (p < chunk_remainder ? 1 : 0);
+    }
+
+    std::vector<gidx_t> row_begin(structured_grid.ny() + 1);
+    row_begin[0] = 0;
+    for (idx_t j = 0; j < structured_grid.ny(); ++j) {
+        row_begin[j + 1] = row_begin[j] + structured_grid.nx(j);
+    }
+
+    std::vector<gidx_t> run_begin;
+    std::vector<int> run_part;
+    auto add_run = [&](gidx_t begin, gidx_t end, int p) {
+        if (begin == end) {
+            return;
+        }
+        if (not run_part.empty() && run_part.back() == p && run_begin.back() == begin) {
+            run_begin.back() = end;
+            return;
+        }
+        if (run_begin.empty()) {
+            run_begin.emplace_back(begin);
+        }
+        ATLAS_ASSERT(run_begin.back() == begin);
+        run_part.emplace_back(p);
+        run_begin.emplace_back(end);
+    };
+
+    int w0 = 0;
+    for (int b = 0; b < nb_bands(); ++b) {
+        const int nb_sectors = nb_regions(b);
+        StructuredBand band(structured_grid, row_begin, displs[w0], displs[w0 + nb_sectors]);
+
+        // i_split[s] holds for each row of the band the first i of sector s
+        std::vector<std::vector<idx_t>> i_split(nb_sectors + 1);
+        for (idx_t j = band.j_begin(); j < band.j_end(); ++j) {
+            i_split[0].emplace_back(band.i_begin(j));
+            i_split[nb_sectors].emplace_back(band.i_end(j));
+        }
+        atlas_omp_parallel_for(int s = 1; s < nb_sectors; ++s) {
+            band.split(displs[w0 + s] - displs[w0], i_split[s]);
+        }
+
+        for (idx_t j = band.j_begin(); j < band.j_end(); ++j) {
+            const idx_t r = j - band.j_begin();
+            for (int s = 0; s < nb_sectors; ++s) {
+                add_run(row_begin[j] + i_split[s][r], row_begin[j] + i_split[s + 1][r], w0 + s);
+            }
+        }
+        w0 += nb_sectors;
+    }
+    ATLAS_ASSERT(run_begin.back() == nb_nodes);
+
+    return new distribution::RunLengthDistribution{N_, std::move(run_begin), std::move(run_part), type()};
+}
+
 void EqualRegionsPartitioner::partition(const Grid& grid, int part[]) const {
     if (N_ == 1) {  // trivial solution, so much faster
         atlas_omp_parallel_for(idx_t j = 0; j < grid.size(); ++j) { part[j] = 0; }
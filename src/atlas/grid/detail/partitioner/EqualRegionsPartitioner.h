@@ -91,6 +91,10 @@ public:
     using Partitioner::partition;
     virtual void partition(const Grid&, int part[]) const;
 
+    /// For structured grids the distribution is computed directly as runs of global indices per latitude row,
+    /// without a partition array of the size of the grid.
+    Distribution partition(const Grid&) const override;
+
     virtual std::string type() const { return "equal_regions"; }
 
 public:
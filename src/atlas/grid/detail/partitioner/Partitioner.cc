@@ -21,6 +21,7 @@
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Partitioner.h"
 #include "atlas/grid/detail/distribution/DistributionArray.h"
+#include "atlas/grid/detail/distribution/RunLengthDistribution.h"
 #include "atlas/grid/detail/partitioner/BandsPartitioner.h"
 #include "atlas/grid/detail/partitioner/CheckerboardPartitioner.h"
 #include "atlas/grid/detail/partitioner/CubedSpherePartitioner.h"
@@ -107,7 +108,14 @@ idx_t Partitioner::nb_partitions() const {
 }
 
 Distribution Partitioner::partition(const Grid& grid) const {
-    return new distribution::DistributionArray{grid, atlas::grid::Partitioner(this)};
+    auto* array = new distribution::DistributionArray{grid, atlas::grid::Partitioner(this)};
+    Distribution distribution{array};
+    // Partitions made of long runs of consecutive global indices are stored more compactly as runs
+    if (distribution::RunLengthDistribution::compressible(array->size(), array->data())) {
+        return new distribution::RunLengthDistribution{static_cast<int>(array->nb_partitions()), array->size(),
+                                                       array->data(), array->type()};
+    }
+    return distribution;
 }
 
 std::string Partitioner::mpi_comm() const { return mpi_comm_; }
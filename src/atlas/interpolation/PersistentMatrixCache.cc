@@ -0,0 +1,399 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/interpolation/PersistentMatrixCache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "eckit/io/MemoryHandle.h"
+#include "eckit/linalg/allocator/NonOwningAllocator.h"
+#include "eckit/utils/MD5.h"
+
+#include "atlas_io/atlas-io.h"
+#include "atlas_io/detail/ParsedRecord.h"
+
+#include "atlas/grid/Grid.h"
+#include "atlas/interpolation/Interpolation.h"
+#include "atlas/library/Library.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/detail/DirectoryLock.h"
+
+namespace atlas {
+namespace interpolation {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+constexpr int layout_version = 1;
+
+const std::string extension = ".atlas";
+
+using Matrix = PersistentMatrixCache::Matrix;
+using Index  = eckit::linalg::Index;
+using Scalar = eckit::linalg::Scalar;
+
+//-----------------------------------------------------------------------------
+
+/// Read-only shared memory mapping of an entire file
+class MappedFile {
+public:
+    explicit MappedFile(const eckit::PathName& path) {
+        int fd = ::open(path.localPath(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* address = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (address != MAP_FAILED) {
+                data_ = static_cast<const char*>(address);
+                size_ = size_t(info.st_size);
+            }
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    operator bool() const { return data_ != nullptr; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_{nullptr};
+    size_t size_{0};
+};
+
+//-----------------------------------------------------------------------------
+
+/// Parse the record at the start of a memory region, without copying its data sections
+io::Record parse_record(const char* data, size_t size) {
+    eckit::MemoryHandle handle(data, size);
+    handle.openForRead();
+    io::Stream stream(handle);
+    io::Record record;
+    record.read(stream);
+    handle.close();
+    return record;
+}
+
+/// Offset relative to the start of the record where the data of given key begins, or 0 if it cannot be
+/// addressed directly (not present, compressed, or of different endianness)
+size_t data_offset(const io::Record& record, const std::string& key) {
+    const auto& metadata = record.metadata(key);
+    if (not metadata.data || metadata.data.compressed() || metadata.data.endian() != io::Endian::native) {
+        return 0;
+    }
+    const auto& parsed = static_cast<const io::ParsedRecord&>(record);
+    return parsed.data_sections.at(size_t(metadata.data.section() - 1)).offset + sizeof(io::RecordDataSection::Begin);
+}
+
+/// Pointer to the array of given key within the mapped record, or nullptr if it is inconsistent with the layout
+template <typename T>
+const T* mapped_array(const MappedFile& file, const io::Record& record, const std::string& key, size_t size) {
+    const auto& metadata = record.metadata(key);
+    if (metadata.getString("datatype", "") != io::DataType::str<T>() || metadata.data.size() != size * sizeof(T)) {
+        return nullptr;
+    }
+    size_t offset = data_offset(record, key);
+    if (offset == 0 || offset + size * sizeof(T) > file.size()) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+/// Owner of the memory backing a loaded matrix: the mapped record, and copies of arrays which are
+/// not suitably aligned within it to be used in place
+struct MatrixStorage {
+    explicit MatrixStorage(const eckit::PathName& path): file(path) {}
+
+    template <typename T>
+    const T* aligned(const T* array, size_t size, std::vector<T>& copy) {
+        if (reinterpret_cast<std::uintptr_t>(array) % alignof(T) == 0) {
+            return array;
+        }
+        copy.resize(size);
+        std::memcpy(copy.data(), array, size * sizeof(T));
+        return copy.data();
+    }
+
+    MappedFile file;
+    std::vector<Index> outer;
+    std::vector<Index> inner;
+    std::vector<Scalar> values;
+};
+
+//-----------------------------------------------------------------------------
+
+std::string encode_layout(const Matrix& matrix, const std::string& key) {
+    util::Config layout;
+    layout.set("version", layout_version);
+    layout.set("key", key);
+    layout.set("rows", size_t(matrix.rows()));
+    layout.set("cols", size_t(matrix.cols()));
+    layout.set("nonzeros", size_t(matrix.nonZeros()));
+    return layout.json(eckit::JSON::Formatting::compact());
+}
+
+size_t write_record(const Matrix& matrix, const std::string& layout, size_t padding, const eckit::PathName& path) {
+    io::RecordWriter record;
+    record.compression(false);
+    record.set("layout", std::string(layout));
+    record.set("padding", std::string(padding, ' '));
+    record.set("values", io::ArrayReference(matrix.data(), io::ArrayShape(std::vector<size_t>{matrix.nonZeros()})));
+    record.set("outer", io::ArrayReference(matrix.outer(), io::ArrayShape(std::vector<size_t>{matrix.rows() + 1})));
+    record.set("inner", io::ArrayReference(matrix.inner(), io::ArrayShape(std::vector<size_t>{matrix.nonZeros()})));
+    return record.write(path);
+}
+
+/// Write the matrix record such that its values can be used in place once memory-mapped.
+/// The data sections follow the metadata, so growing the padding string in the metadata shifts them all alike.
+void write_aligned_record(const Matrix& matrix, const std::string& layout, const eckit::PathName& path) {
+    write_record(matrix, layout, 0, path);
+    size_t misalignment;
+    {
+        MappedFile file(path);
+        ATLAS_ASSERT(file);
+        misalignment = data_offset(parse_record(file.data(), file.size()), "values") % alignof(Scalar);
+    }
+    if (misalignment) {
+        write_record(matrix, layout, alignof(Scalar) - misalignment, path);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+struct RecordFile {
+    eckit::PathName path;
+    size_t size;
+    std::uint64_t last_used;
+};
+
+std::vector<RecordFile> list_records(const eckit::PathName& directory) {
+    std::vector<RecordFile> records;
+    DIR* dir = ::opendir(directory.localPath());
+    if (dir == nullptr) {
+        return records;
+    }
+    while (const struct dirent* entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() <= extension.size() ||
+            name.compare(name.size() - extension.size(), extension.size(), extension) != 0) {
+            continue;
+        }
+        eckit::PathName path = directory / name;
+        struct stat info;
+        if (::stat(path.localPath(), &info) == 0 && S_ISREG(info.st_mode)) {
+            records.push_back({path, size_t(info.st_size), std::uint64_t(info.st_mtime)});
+        }
+    }
+    ::closedir(dir);
+    return records;
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+PersistentMatrixCache::PersistentMatrixCache(const eckit::PathName& directory, const eckit::Configuration& config):
+    directory_(directory), max_size_(size_t(4) << 30) {
+    config.get("max_size", max_size_);
+    if (not directory_.exists()) {
+        directory_.mkdir();
+    }
+}
+
+std::string PersistentMatrixCache::key(const eckit::Configuration& config, const Grid& source,
+                                       const Grid& target) const {
+    const auto& comm = config.has("mpi_comm") ? mpi::comm(config.getString("mpi_comm")) : mpi::comm();
+
+    eckit::MD5 hash;
+    hash.add(std::string("atlas::interpolation::PersistentMatrixCache"));
+    hash.add(layout_version);
+    hash.add(atlas::Library::instance().version());
+    hash.add(util::Config(config).json(eckit::JSON::Formatting::compact()));
+    source.hash(hash);
+    target.hash(hash);
+    hash.add(int(comm.size()));
+    hash.add(int(comm.rank()));
+    return hash.digest();
+}
+
+eckit::PathName PersistentMatrixCache::path(const std::string& key) const {
+    return directory_ / (key + extension);
+}
+
+MatrixCache PersistentMatrixCache::load(const std::string& key) const {
+    ATLAS_TRACE("PersistentMatrixCache::load");
+    eckit::PathName file = path(key);
+
+    auto storage = std::make_shared<MatrixStorage>(file);
+    if (not storage->file) {
+        return MatrixCache();
+    }
+
+    size_t rows, cols, nonzeros;
+    const Index* outer;
+    const Index* inner;
+    const Scalar* values;
+    try {
+        io::Record record = parse_record(storage->file.data(), storage->file.size());
+
+        std::string json;
+        io::decode(record.metadata("layout"), io::Data(), json);
+        std::istringstream json_stream(json);
+        util::Config layout(json_stream);
+        if (layout.getInt("version") != layout_version || layout.getString("key") != key) {
+            Log::warning() << "Ignoring incompatible interpolation matrix cache record " << file << std::endl;
+            return MatrixCache();
+        }
+        rows     = layout.getUnsigned("rows");
+        cols     = layout.getUnsigned("cols");
+        nonzeros = layout.getUnsigned("nonzeros");
+
+        outer  = mapped_array<Index>(storage->file, record, "outer", rows + 1);
+        inner  = mapped_array<Index>(storage->file, record, "inner", nonzeros);
+        values = mapped_array<Scalar>(storage->file, record, "values", nonzeros);
+    }
+    catch (const eckit::Exception& e) {
+        Log::warning() << "Ignoring unreadable interpolation matrix cache record " << file << ": " << e.what()
+                       << std::endl;
+        return MatrixCache();
+    }
+    if (outer == nullptr || inner == nullptr || values == nullptr) {
+        Log::warning() << "Ignoring inconsistent interpolation matrix cache record " << file << std::endl;
+        return MatrixCache();
+    }
+
+    outer  = storage->aligned(outer, rows + 1, storage->outer);
+    inner  = storage->aligned(inner, nonzeros, storage->inner);
+    values = storage->aligned(values, nonzeros, storage->values);
+
+    // Mark the record as recently used, for eviction
+    ::utimes(file.localPath(), nullptr);
+
+    // The matrix does not own its arrays; the storage lives as long as the matrix is referenced
+    auto* allocator = new eckit::linalg::allocator::NonOwningAllocator(
+        rows, cols, nonzeros, const_cast<Index*>(outer), const_cast<Index*>(inner), const_cast<Scalar*>(values));
+    std::shared_ptr<const Matrix> matrix(new Matrix(allocator), [storage](const Matrix* m) { delete m; });
+    return MatrixCache(matrix, key);
+}
+
+void PersistentMatrixCache::store(const std::string& key, const MatrixCache& cache) const {
+    if (not cache) {
+        return;
+    }
+    ATLAS_TRACE("PersistentMatrixCache::store");
+    util::detail::DirectoryLock lock(directory_);
+
+    eckit::PathName file = path(key);
+    if (file.exists()) {
+        // Stored meanwhile by another process
+        return;
+    }
+
+    eckit::PathName tmp = directory_ / (key + ".tmp." + std::to_string(::getpid()));
+    write_aligned_record(cache.matrix(), encode_layout(cache.matrix(), key), tmp);
+    if (::rename(tmp.localPath(), file.localPath()) != 0) {
+        int error = errno;
+        ::unlink(tmp.localPath());
+        throw_Exception("Could not rename " + tmp.asString() + " to " + file.asString() + ": " + std::strerror(error),
+                        Here());
+    }
+
+    evict(file);
+}
+
+MatrixCache PersistentMatrixCache::operator()(const eckit::Configuration& config, const Grid& source,
+                                              const Grid& target) const {
+    const auto& comm = config.has("mpi_comm") ? mpi::comm(config.getString("mpi_comm")) : mpi::comm();
+
+    std::string k = key(config, source, target);
+    auto cache    = load(k);
+
+    // Records are stored per rank and may be missing on some ranks only, e.g. after eviction, while computing
+    // the matrix is collective: a miss on any rank is a miss on all ranks
+    int hit = cache ? 1 : 0;
+    comm.allReduceInPlace(hit, eckit::mpi::min());
+    if (hit) {
+        return cache;
+    }
+    MatrixCache computed(Interpolation(config, source, target));
+    store(k, computed);
+    return computed;
+}
+
+size_t PersistentMatrixCache::footprint() const {
+    size_t footprint{0};
+    for (const auto& record : list_records(directory_)) {
+        footprint += record.size;
+    }
+    return footprint;
+}
+
+void PersistentMatrixCache::evict(const eckit::PathName& keep) const {
+    if (max_size_ == 0) {
+        return;
+    }
+    auto records = list_records(directory_);
+
+    size_t footprint{0};
+    for (const auto& record : records) {
+        footprint += record.size;
+    }
+    if (footprint <= max_size_) {
+        return;
+    }
+
+    // Least recently used first; processes still mapping a removed record keep their pages
+    std::sort(records.begin(), records.end(), [](const RecordFile& a, const RecordFile& b) {
+        return a.last_used < b.last_used || (a.last_used == b.last_used && a.path.asString() < b.path.asString());
+    });
+    for (const auto& record : records) {
+        if (footprint <= max_size_) {
+            break;
+        }
+        if (record.path.asString() == keep.asString()) {
+            continue;
+        }
+        if (::unlink(record.path.localPath()) == 0) {
+            footprint -= record.size;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace interpolation
+}  // namespace atlas
@@ -0,0 +1,94 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/interpolation/Cache.h"
+#include "atlas/util/Config.h"
+
+//-----------------------------------------------------------------------------
+// Forward declarations
+
+namespace atlas {
+class Grid;
+}  // namespace atlas
+
+//-----------------------------------------------------------------------------
+
+namespace atlas {
+namespace interpolation {
+
+//-----------------------------------------------------------------------------
+
+/// @brief File-backed cache of interpolation matrices, shared between processes
+///
+/// Each matrix is stored as an uncompressed atlas-io record in the cache directory, under a key which
+/// hashes the interpolation configuration, the source and target grids, and the MPI task within its
+/// communicator (which determines the distribution of the grids).
+/// Loaded matrices are memory-mapped read-only, so that all processes on a node share the same pages.
+///
+/// Writers are serialised with an advisory lock on the directory and publish a record with an atomic
+/// rename, so that readers never see a partially written record. When the records in the directory exceed
+/// the configured "max_size" (in bytes, default 4 GiB, 0 for unbounded), the least recently used ones
+/// are removed.
+///
+/// Usage:
+/// @code{.cpp}
+///     interpolation::PersistentMatrixCache persistent_cache("/path/to/cache");
+///     Interpolation interpolation(config, source, target, persistent_cache(config, source, target));
+/// @endcode
+class PersistentMatrixCache {
+public:
+    using Matrix = MatrixCache::Matrix;
+
+    PersistentMatrixCache(const eckit::PathName& directory, const eckit::Configuration& = util::NoConfig());
+
+    /// @brief Key of the matrix interpolating from source to target grid on this MPI task
+    std::string key(const eckit::Configuration&, const Grid& source, const Grid& target) const;
+
+    /// @brief Path of the record stored for given key
+    eckit::PathName path(const std::string& key) const;
+
+    /// @brief Memory-mapped matrix stored for given key, or an empty MatrixCache when not present
+    MatrixCache load(const std::string& key) const;
+
+    /// @brief Store matrix for given key unless already present, and evict least recently used records
+    void store(const std::string& key, const MatrixCache&) const;
+
+    /// @brief Matrix cache for given interpolation, loaded from disk, or computed and stored when not present
+    ///
+    /// Collective over the communicator of the interpolation: the matrix is computed on all ranks as soon as
+    /// its record is missing on any rank.
+    MatrixCache operator()(const eckit::Configuration&, const Grid& source, const Grid& target) const;
+
+    /// @brief Total size in bytes of the records in the cache directory
+    size_t footprint() const;
+
+    const eckit::PathName& directory() const { return directory_; }
+
+    size_t max_size() const { return max_size_; }
+
+private:
+    void evict(const eckit::PathName& keep) const;
+
+private:
+    eckit::PathName directory_;
+    size_t max_size_;
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace interpolation
+}  // namespace atlas
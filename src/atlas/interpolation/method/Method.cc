@@ -9,6 +9,8 @@
  */
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "atlas/interpolation/method/Method.h"
 
@@ -20,6 +22,7 @@
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/linalg/sparse.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -95,6 +98,47 @@ void set_missing_values(Field& tgt, const std::vector<idx_t>& missing) {
     }
 }
 
+/// Contiguous field seen as a 2D array of shape (points, values per point)
+template <typename Value>
+struct FusedField {
+    FusedField(const Field& src, Field& tgt):
+        src_{src.array().data<Value>()}, tgt_{tgt.array().data<Value>()}, size_{size_t(src.stride(0))} {}
+    const Value* src_;
+    Value* tgt_;
+    size_t size_;
+};
+
+/// Apply each row of the matrix to all fields and levels while the row is in cache, rather than
+/// streaming the matrix once per field. The summation order per value is that of the openmp backend.
+template <typename Matrix, typename Value>
+void fused_sparse_matrix_multiply(const Matrix& W, const std::vector<FusedField<Value>>& fields) {
+    if (fields.empty()) {
+        return;
+    }
+    ATLAS_TRACE("fused_sparse_matrix_multiply");
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    const idx_t rows  = static_cast<idx_t>(W.rows());
+
+    atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+        for (const auto& field : fields) {
+            const size_t Nk = field.size_;
+            Value* tgt      = field.tgt_ + size_t(r) * Nk;
+            for (size_t k = 0; k < Nk; ++k) {
+                tgt[k] = 0.;
+            }
+            for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                const Value* src = field.src_ + size_t(index[c]) * Nk;
+                const Value w    = static_cast<Value>(weight[c]);
+                for (size_t k = 0; k < Nk; ++k) {
+                    tgt[k] += w * src[k];
+                }
+            }
+        }
+    }
+}
+
 }  // anonymous namespace
 
 
@@ -168,76 +212,53 @@ void Method::interpolate_field_rank3(const Field& src, Field& tgt, const Matrix&
 
 template <typename Value>
 void Method::adjoint_interpolate_field_rank1(Field& src, const Field& tgt, const Matrix& W) const {
-    array::ArrayT<Value> tmp(src.shape());
-
-    auto tmp_v = array::make_view<Value, 1>(tmp);
     auto src_v = array::make_view<Value, 1>(src);
     auto tgt_v = array::make_view<Value, 1>(tgt);
-
-    tmp_v.assign(0.);
-
-    if (std::is_same<Value, float>::value) {
-        sparse_matrix_multiply(W, tgt_v, tmp_v, sparse::backend::openmp());
+    if (transpose_plan_ && transpose_plan_->valid_for(W)) {
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v, *transpose_plan_);
     }
     else {
-        sparse_matrix_multiply(W, tgt_v, tmp_v, sparse::Backend{linalg_backend_});
-    }
-
-
-    for (idx_t t = 0; t < tmp.shape(0); ++t) {
-        src_v(t) += tmp_v(t);
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v);
     }
 }
 
 template <typename Value>
 void Method::adjoint_interpolate_field_rank2(Field& src, const Field& tgt, const Matrix& W) const {
-    array::ArrayT<Value> tmp(src.shape());
-
-    auto tmp_v = array::make_view<Value, 2>(tmp);
     auto src_v = array::make_view<Value, 2>(src);
     auto tgt_v = array::make_view<Value, 2>(tgt);
-
-    tmp_v.assign(0.);
-
-    sparse_matrix_multiply(W, tgt_v, tmp_v, sparse::backend::openmp());
-
-    for (idx_t t = 0; t < tmp.shape(0); ++t) {
-        for (idx_t k = 0; k < tmp.shape(1); ++k) {
-            src_v(t, k) += tmp_v(t, k);
-        }
+    if (transpose_plan_ && transpose_plan_->valid_for(W)) {
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v, *transpose_plan_);
+    }
+    else {
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v);
     }
 }
 
 template <typename Value>
 void Method::adjoint_interpolate_field_rank3(Field& src, const Field& tgt, const Matrix& W) const {
-    array::ArrayT<Value> tmp(src.shape());
-
-    auto tmp_v = array::make_view<Value, 3>(tmp);
     auto src_v = array::make_view<Value, 3>(src);
     auto tgt_v = array::make_view<Value, 3>(tgt);
-
-    tmp_v.assign(0.);
-
-    sparse_matrix_multiply(W, tgt_v, tmp_v, sparse::backend::openmp());
-
-    for (idx_t t = 0; t < tmp.shape(0); ++t) {
-        for (idx_t j = 0; j < tmp.shape(1); ++j) {
-            for (idx_t k = 0; k < tmp.shape(2); ++k) {
-                src_v(t, j, k) += tmp_v(t, j, k);
-            }
-        }
+    if (transpose_plan_ && transpose_plan_->valid_for(W)) {
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v, *transpose_plan_);
+    }
+    else {
+        sparse_matrix_transpose_multiply_add(W, tgt_v, src_v);
     }
 }
 
 void Method::check_compatibility(const Field& src, const Field& tgt, const Matrix& W) const {
+    ATLAS_ASSERT(!W.empty());
+    check_compatibility(src, tgt, W.rows(), W.cols());
+}
+
+void Method::check_compatibility(const Field& src, const Field& tgt, size_t rows, size_t cols) const {
     ATLAS_ASSERT(src.datatype() == tgt.datatype());
     ATLAS_ASSERT(src.rank() == tgt.rank());
     ATLAS_ASSERT(src.levels() == tgt.levels());
     ATLAS_ASSERT(src.variables() == tgt.variables());
 
-    ATLAS_ASSERT(!W.empty());
-    ATLAS_ASSERT(tgt.shape(0) >= static_cast<idx_t>(W.rows()));
-    ATLAS_ASSERT(src.shape(0) >= static_cast<idx_t>(W.cols()));
+    ATLAS_ASSERT(tgt.shape(0) >= static_cast<idx_t>(rows));
+    ATLAS_ASSERT(src.shape(0) >= static_cast<idx_t>(cols));
 }
 
 template <typename Value>
@@ -263,6 +284,34 @@ void Method::interpolate_field(const Field& src, Field& tgt, const Matrix& W) co
     }
 }
 
+template <typename Value, typename CompactMatrix>
+void Method::interpolate_field_compact(const Field& src, Field& tgt, const CompactMatrix& W) const {
+    if (tgt.shape(0) == 0) {
+        return;
+    }
+    ATLAS_ASSERT(not W.empty());
+    check_compatibility(src, tgt, W.rows(), W.cols());
+
+    if (src.rank() == 1) {
+        auto src_v = array::make_view<Value, 1>(src);
+        auto tgt_v = array::make_view<Value, 1>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v);
+    }
+    else if (src.rank() == 2) {
+        auto src_v = array::make_view<Value, 2>(src);
+        auto tgt_v = array::make_view<Value, 2>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v);
+    }
+    else if (src.rank() == 3) {
+        auto src_v = array::make_view<Value, 3>(src);
+        auto tgt_v = array::make_view<Value, 3>(tgt);
+        sparse_matrix_multiply(W, src_v, tgt_v);
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
 template <typename Value>
 void Method::adjoint_interpolate_field(Field& src, const Field& tgt, const Matrix& W) const {
     // do nothing if there are no observations to interpolate (W will be NULL
@@ -270,7 +319,7 @@ void Method::adjoint_interpolate_field(Field& src, const Field& tgt, const Matri
     if (tgt.shape(0) == 0) {
         return;
     }
-    check_compatibility(tgt, src, W);
+    check_compatibility(src, tgt, W);
 
     if (src.rank() == 1) {
         adjoint_interpolate_field_rank1<Value>(src, tgt, W);
@@ -295,40 +344,92 @@ Method::Method(const Method::Config& config) {
     }
 
     config.get("adjoint", adjoint_);
+
+    config.get("matrix_compact_indices", matrix_compact_indices_);
+    config.get("matrix_single_precision", matrix_single_precision_);
+    config.get("matrix_keep_full", matrix_keep_full_);
 }
 
 void Method::setup(const FunctionSpace& source, const FunctionSpace& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, FunctionSpace)");
     this->do_setup(source, target);
-
-    if (adjoint_) {
-        Matrix tmp(*matrix_);
-
-        // if interpolation is matrix free then matrix->nonZeros() will be zero.
-        if (tmp.nonZeros() > 0) {
-            matrix_transpose_ = tmp.transpose();
-        }
-    }
+    setup_matrix_storage();
 }
 
 void Method::setup(const Grid& source, const Grid& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(Grid, Grid)");
     this->do_setup(source, target, Cache());
+    setup_matrix_storage();
 }
 
 void Method::setup(const FunctionSpace& source, const Field& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, Field)");
     this->do_setup(source, target);
+    setup_matrix_storage();
 }
 
 void Method::setup(const FunctionSpace& source, const FieldSet& target) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(FunctionSpace, FieldSet)");
     this->do_setup(source, target);
+    setup_matrix_storage();
 }
 
 void Method::setup(const Grid& source, const Grid& target, const Cache& cache) {
     ATLAS_TRACE("atlas::interpolation::method::Method::setup(Grid, Grid, Cache)");
     this->do_setup(source, target, cache);
+    setup_matrix_storage();
+}
+
+void Method::setup_matrix_storage() {
+    compact_matrix_.reset();
+    compact_matrix_single_precision_.reset();
+    transpose_plan_.reset();
+    matrix_released_ = false;
+    if (adjoint_ && matrix_ != nullptr && not matrix_->empty()) {
+        transpose_plan_ = std::make_shared<linalg::sparse::TransposeMultiplyPlan>(*matrix_);
+    }
+    if (not(matrix_compact_indices_ || matrix_single_precision_) || matrix_ == nullptr || matrix_->empty()) {
+        return;
+    }
+    if (not linalg::CompactSparseMatrix<double>::fits(*matrix_)) {
+        Log::warning() << "Interpolation matrix too large for 32-bit indices, using default matrix storage"
+                       << std::endl;
+        return;
+    }
+    ATLAS_TRACE("atlas::interpolation::method::Method::setup_matrix_storage()");
+    auto report = [&](const auto& compact) {
+        Log::debug() << "Interpolation matrix with " << compact.nonZeros() << " nonzeros stored in "
+                     << compact.footprint() << " bytes instead of " << matrix_->footprint()
+                     << " bytes; max weight error: " << compact.weight_error()
+                     << ", max row sum error: " << compact.row_sum_error() << std::endl;
+    };
+    if (matrix_single_precision_) {
+        compact_matrix_single_precision_ = std::make_shared<linalg::CompactSparseMatrix<float>>(*matrix_);
+        report(*compact_matrix_single_precision_);
+    }
+    else {
+        compact_matrix_ = std::make_shared<linalg::CompactSparseMatrix<double>>(*matrix_);
+        report(*compact_matrix_);
+    }
+
+    // The full matrix is only released when owned by this method, and not used by the adjoint, for non-linear
+    // interpolation, or by the derived method. It keeps its shape for compatibility checks.
+    const bool keep = matrix_keep_full_ || adjoint_ || nonLinear_ || matrix_required();
+    if (not keep && matrix_shared_ && matrix_shared_.get() == matrix_) {
+        Matrix shape(matrix_->rows(), matrix_->cols(), Triplets());
+        matrix_shared_->swap(shape);
+        matrix_released_ = true;
+    }
+}
+
+bool Method::matrix_empty() const {
+    if (compact_matrix_single_precision_) {
+        return compact_matrix_single_precision_->empty();
+    }
+    if (compact_matrix_) {
+        return compact_matrix_->empty();
+    }
+    return matrix_ == nullptr || matrix_->empty();
 }
 
 Method::Metadata Method::execute(const FieldSet& source, FieldSet& target) const {
@@ -373,8 +474,76 @@ void Method::do_execute(const FieldSet& fieldsSource, FieldSet& fieldsTarget, Me
     const idx_t N = fieldsSource.size();
     ATLAS_ASSERT(N == fieldsTarget.size());
 
-    for (idx_t i = 0; i < fieldsSource.size(); ++i) {
-        Method::do_execute(fieldsSource[i], fieldsTarget[i], metadata);
+    haloExchange(fieldsSource);
+
+    // Linear interpolation of contiguous fields is done in one pass over the matrix per datatype,
+    // the remaining fields are interpolated one by one
+    std::vector<bool> fused(N, false);
+    if (matrix_) {
+        std::vector<FusedField<double>> fields_double;
+        std::vector<FusedField<float>> fields_float;
+        for (idx_t i = 0; i < N; ++i) {
+            const Field& src = fieldsSource[i];
+            Field& tgt       = fieldsTarget[i];
+            if (not fusable(src, tgt)) {
+                continue;
+            }
+            check_compatibility(src, tgt, matrix_->rows(), matrix_->cols());
+            if (src.datatype().kind() == array::DataType::KIND_REAL64) {
+                fields_double.emplace_back(src, tgt);
+            }
+            else {
+                fields_float.emplace_back(src, tgt);
+            }
+            fused[i] = true;
+        }
+        if (compact_matrix_single_precision_) {
+            fused_sparse_matrix_multiply(*compact_matrix_single_precision_, fields_double);
+            fused_sparse_matrix_multiply(*compact_matrix_single_precision_, fields_float);
+        }
+        else if (compact_matrix_) {
+            fused_sparse_matrix_multiply(*compact_matrix_, fields_double);
+            fused_sparse_matrix_multiply(*compact_matrix_, fields_float);
+        }
+        else {
+            fused_sparse_matrix_multiply(*matrix_, fields_double);
+            fused_sparse_matrix_multiply(*matrix_, fields_float);
+        }
+    }
+
+    for (idx_t i = 0; i < N; ++i) {
+        if (fused[i]) {
+            finalise(fieldsSource[i], fieldsTarget[i]);
+        }
+        else {
+            Method::do_execute(fieldsSource[i], fieldsTarget[i], metadata);
+        }
+    }
+}
+
+bool Method::fusable(const Field& src, const Field& tgt) const {
+    if (matrix_empty() || tgt.shape(0) == 0) {
+        return false;
+    }
+    if (src.datatype() != tgt.datatype() || src.rank() != tgt.rank() || src.rank() > 3) {
+        return false;
+    }
+    if (not src.contiguous() || not tgt.contiguous() || src.shape(0) == 0 || src.stride(0) != tgt.stride(0)) {
+        return false;
+    }
+    if (nonLinear_(src)) {
+        return false;
+    }
+    switch (src.datatype().kind()) {
+        case array::DataType::KIND_REAL64:
+            // Rank-1 double precision fields honour the configured sparse_matrix_multiply backend,
+            // unless a compact matrix is used which always uses the openmp kernels
+            return src.rank() > 1 || compact_matrix_ || compact_matrix_single_precision_ ||
+                   sparse::Backend{linalg_backend_}.type() == sparse::backend::openmp::type();
+        case array::DataType::KIND_REAL32:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -384,7 +553,30 @@ void Method::do_execute(const Field& src, Field& tgt, Metadata&) const {
     haloExchange(src);
 
     if( matrix_ ) { // (matrix == nullptr) when a partition is empty
-        if (src.datatype().kind() == array::DataType::KIND_REAL64) {
+        const bool linear = not nonLinear_(src);
+        if (linear && compact_matrix_single_precision_) {
+            if (src.datatype().kind() == array::DataType::KIND_REAL64) {
+                interpolate_field_compact<double>(src, tgt, *compact_matrix_single_precision_);
+            }
+            else if (src.datatype().kind() == array::DataType::KIND_REAL32) {
+                interpolate_field_compact<float>(src, tgt, *compact_matrix_single_precision_);
+            }
+            else {
+                ATLAS_NOTIMPLEMENTED;
+            }
+        }
+        else if (linear && compact_matrix_) {
+            if (src.datatype().kind() == array::DataType::KIND_REAL64) {
+                interpolate_field_compact<double>(src, tgt, *compact_matrix_);
+            }
+            else if (src.datatype().kind() == array::DataType::KIND_REAL32) {
+                interpolate_field_compact<float>(src, tgt, *compact_matrix_);
+            }
+            else {
+                ATLAS_NOTIMPLEMENTED;
+            }
+        }
+        else if (src.datatype().kind() == array::DataType::KIND_REAL64) {
             interpolate_field<double>(src, tgt, *matrix_);
         }
         else if (src.datatype().kind() == array::DataType::KIND_REAL32) {
@@ -395,6 +587,10 @@ void Method::do_execute(const Field& src, Field& tgt, Metadata&) const {
         }
     }
 
+    finalise(src, tgt);
+}
+
+void Method::finalise(const Field& src, Field& tgt) const {
     // carry over missing value metadata
     if (not tgt.metadata().has("missing_value")) {
         field::MissingValue mv_src(src);
@@ -438,15 +634,17 @@ void Method::do_execute_adjoint(Field& src, const Field& tgt, Metadata&) const {
         throw_NotImplemented("Adjoint Interpolation does not work for fields that have missing data. ", Here());
     }
 
-    if (matrix_transpose_.empty()) {
+    // if interpolation is matrix free then matrix->nonZeros() will be zero.
+    if (not adjoint_ || matrix_ == nullptr || matrix_->nonZeros() == 0) {
         throw_AssertionFailed("Need to set 'adjoint coefficients' to true in config for adjoint interpolation to work");
     }
 
+    // The transpose of the forward matrix is applied directly, accumulating into the source field
     if (src.datatype().kind() == array::DataType::KIND_REAL64) {
-        adjoint_interpolate_field<double>(src, tgt, matrix_transpose_);
+        adjoint_interpolate_field<double>(src, tgt, *matrix_);
     }
     else if (src.datatype().kind() == array::DataType::KIND_REAL32) {
-        adjoint_interpolate_field<float>(src, tgt, matrix_transpose_);
+        adjoint_interpolate_field<float>(src, tgt, *matrix_);
     }
     else {
         ATLAS_NOTIMPLEMENTED;
@@ -474,8 +672,18 @@ void Method::normalise(Triplets& triplets) {
 }
 
 void Method::haloExchange(const FieldSet& fields) const {
+    if (not allow_halo_exchange_) {
+        return;
+    }
+    // Exchange all dirty fields in one call, so the function space can combine them
+    FieldSet dirty;
     for (auto& field : fields) {
-        haloExchange(field);
+        if (field.dirty()) {
+            dirty.add(field);
+        }
+    }
+    if (dirty.size()) {
+        source().haloExchange(dirty);
     }
 }
 void Method::haloExchange(const Field& field) const {
@@ -496,6 +704,12 @@ void Method::adjointHaloExchange(const Field& field) const {
 }
 
 interpolation::Cache Method::createCache() const {
+    if (matrix_released_) {
+        // Rebuild the full matrix from the compact copy, with its weights
+        auto matrix = compact_matrix_single_precision_ ? compact_matrix_single_precision_->to_sparse_matrix()
+                                                       : compact_matrix_->to_sparse_matrix();
+        return interpolation::MatrixCache(std::make_shared<const Matrix>(std::move(matrix)), matrix_cache_.uid());
+    }
     return matrix_cache_;
 }
 
@@ -11,11 +11,14 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "atlas/interpolation/Cache.h"
 #include "atlas/interpolation/NonLinear.h"
+#include "atlas/linalg/sparse/CompactSparseMatrix.h"
+#include "atlas/linalg/sparse/SparseMatrixTransposeMultiply.h"
 #include "atlas/util/Metadata.h"
 #include "atlas/util/Object.h"
 #include "eckit/config/Configuration.h"
@@ -122,6 +125,10 @@ protected:
 
     const Matrix& matrix() const { return *matrix_; }
 
+    /// True if the method uses the full matrix after setup, other than through Method::do_execute.
+    /// Otherwise the full matrix is released once a compact copy is created, see setup_matrix_storage().
+    virtual bool matrix_required() const { return false; }
+
     virtual void do_setup(const FunctionSpace& source, const FunctionSpace& target) = 0;
     virtual void do_setup(const Grid& source, const Grid& target, const Cache&)     = 0;
     virtual void do_setup(const FunctionSpace& source, const Field& target);
@@ -130,6 +137,21 @@ protected:
     void check_compatibility(const Field& src, const Field& tgt, const Matrix& W) const;
 
 private:
+    /// Create the compact copy of the matrix used for execution, if configured, and the schedule of the adjoint.
+    /// The compact copy replaces the full matrix unless that is still needed, or kept with "matrix_keep_full".
+    void setup_matrix_storage();
+
+    /// True if there is no matrix, or it has no nonzeros
+    bool matrix_empty() const;
+
+    void check_compatibility(const Field& src, const Field& tgt, size_t rows, size_t cols) const;
+
+    /// True if the field can be interpolated together with others in a single pass over the matrix
+    bool fusable(const Field& src, const Field& tgt) const;
+
+    /// Carry over missing value metadata and set missing values of an interpolated target field
+    void finalise(const Field& src, Field& tgt) const;
+
     template <typename Value>
     void interpolate_field(const Field& src, Field& tgt, const Matrix&) const;
 
@@ -142,6 +164,9 @@ private:
     template <typename Value>
     void interpolate_field_rank3(const Field& src, Field& tgt, const Matrix&) const;
 
+    template <typename Value, typename CompactMatrix>
+    void interpolate_field_compact(const Field& src, Field& tgt, const CompactMatrix&) const;
+
     template <typename Value>
     void adjoint_interpolate_field(Field& src, const Field& tgt, const Matrix&) const;
 
@@ -161,7 +186,18 @@ private:
     NonLinear nonLinear_;
     std::string linalg_backend_;
     bool adjoint_{false};
-    Matrix matrix_transpose_;
+
+    // Compact copies of the matrix with 32-bit indices, used for linear interpolation when configured.
+    // The full matrix is then released, keeping only its shape, unless matrix_keep_full_ or otherwise required.
+    bool matrix_compact_indices_{false};
+    bool matrix_single_precision_{false};
+    bool matrix_keep_full_{false};
+    bool matrix_released_{false};
+    std::shared_ptr<linalg::CompactSparseMatrix<double>> compact_matrix_;
+    std::shared_ptr<linalg::CompactSparseMatrix<float>> compact_matrix_single_precision_;
+
+    // Schedule of the rows of the matrix for the adjoint, computed once when the adjoint is configured
+    std::shared_ptr<linalg::sparse::TransposeMultiplyPlan> transpose_plan_;
 
 protected:
     bool allow_halo_exchange_{true};
@@ -13,6 +13,7 @@
 #include "atlas/interpolation/method/knn/GridBox.h"
 
 #include <algorithm>
+#include <cmath>
 #include <ostream>
 #include <vector>
 
@@ -197,6 +198,9 @@ GridBoxes::GridBoxes(const Grid& grid, bool gaussianWeightedLatitudes) {
 
     clear();
     reserve(gridSize);
+    parallels_ = lat;
+    bands_.clear();
+    bands_.reserve(x.nx().size());
     for (size_t j = 0; j < x.nx().size(); ++j) {
         eckit::Fraction dx(x.dx()[j]);
         eckit::Fraction xmin(x.xmin()[j]);
@@ -211,6 +215,7 @@ GridBoxes::GridBoxes(const Grid& grid, bool gaussianWeightedLatitudes) {
 
         eckit::Fraction lon0 = (n * dx) - (dx / 2);
         eckit::Fraction lon1 = lon0;
+        bands_.push_back({size(), size_t(x.nx()[j]), double(lon0), double(dx)});
         for (idx_t i = 0; i < x.nx()[j]; ++i) {
             double lon0 = lon1;
             lon1 += dx;
@@ -234,6 +239,49 @@ GridBoxes::GridBoxes(const Grid& grid, bool gaussianWeightedLatitudes) {
 GridBoxes::GridBoxes() = default;
 
 
+void GridBoxes::candidates(const GridBox& box, std::vector<size_t>& indices) const {
+    indices.clear();
+
+    // Bands overlapping [south, north] of the box, band j is bounded by parallels j (north) and j + 1 (south)
+    if (bands_.empty()) {
+        return;
+    }
+    auto first = std::partition_point(parallels_.begin() + 1, parallels_.end(),
+                                      [&](double lat) { return lat > box.north(); });
+    auto last  = std::partition_point(parallels_.begin(), parallels_.end() - 1,
+                                      [&](double lat) { return lat >= box.south(); });
+    auto j0    = size_t(first - (parallels_.begin() + 1));
+    auto j1    = size_t(last - parallels_.begin());
+
+    // Longitude ranges within each band, with one grid box margin for rounding, and the part of the box
+    // wrapping past the date line of the band
+    auto index = [](double lon, const Band& band) { return long(std::floor((lon - band.west) / band.dx)); };
+    for (auto j = j0; j < j1; ++j) {
+        const auto& band = bands_[j];
+        const auto nx    = long(band.nx);
+
+        double w = normalise(box.west(), band.west);
+        double e = w + (box.east() - box.west());
+
+        long i0 = std::max(0L, index(w, band) - 1);
+        long i1 = std::min(nx - 1, index(e, band) + 1);
+        long k1 = std::min(nx - 1, index(e - GLOBE, band) + 1);  // wrapped part, from the first grid box
+        if (k1 >= i0 - 1) {
+            i0 = 0;
+            i1 = std::max(i1, k1);
+        }
+        else {
+            for (long i = 0; i <= k1; ++i) {
+                indices.push_back(band.offset + size_t(i));
+            }
+        }
+        for (long i = i0; i <= i1; ++i) {
+            indices.push_back(band.offset + size_t(i));
+        }
+    }
+}
+
+
 double GridBoxes::getLongestGridBoxDiagonal() const {
     ATLAS_ASSERT(!empty());
 
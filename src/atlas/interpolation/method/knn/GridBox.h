@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iosfwd>
 #include <vector>
 
@@ -116,6 +117,21 @@ struct GridBoxes : std::vector<GridBox> {
     GridBoxes(const Grid&, bool gaussianWeightedLatitudes = true);
     GridBoxes();
     double getLongestGridBoxDiagonal() const;
+
+    /// @brief Indices of grid boxes possibly intersecting a box (a superset of those that do), found from
+    /// the latitude bands and the regular longitude spacing within each band of the structured grid
+    void candidates(const GridBox&, std::vector<size_t>& indices) const;
+
+private:
+    struct Band {
+        size_t offset;  // index of the first grid box
+        size_t nx;
+        double west;  // western meridian of the first grid box, before clipping
+        double dx;
+    };
+
+    std::vector<double> parallels_;  // band boundaries, north to south
+    std::vector<Band> bands_;
 };
 
 
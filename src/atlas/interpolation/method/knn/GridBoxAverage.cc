@@ -13,8 +13,6 @@
 
 #include <vector>
 
-#include "eckit/log/ProgressTimer.h"
-
 #include "atlas/array.h"
 #include "atlas/functionspace/PointCloud.h"
 #include "atlas/interpolation/method/MethodFactory.h"
@@ -61,7 +59,6 @@ void GridBoxAverage::do_execute(const Field& source, Field& target, Metadata& me
     functionspace::PointCloud tgt = target_;
     ATLAS_ASSERT(tgt);
 
-    ATLAS_ASSERT(searchRadius_ > 0.);
     ATLAS_ASSERT(!sourceBoxes_.empty());
     ATLAS_ASSERT(!targetBoxes_.empty());
 
@@ -76,30 +73,15 @@ void GridBoxAverage::do_execute(const Field& source, Field& target, Metadata& me
     ATLAS_ASSERT(yarray.size() == targetBoxes_.size());
 
     yarray.assign(0.);
-    failures_.clear();
 
 
     // interpolate
-    eckit::ProgressTimer progress("Intersecting", targetBoxes_.size(), "grid box", double(5.));
-
-    std::vector<Triplet> triplets;
-    size_t i = 0;
-    for (auto p : tgt.iterate().lonlat()) {
-        ++progress;
-
-        if (intersect(i, targetBoxes_.at(i), pTree_.closestPointsWithinRadius(p, searchRadius_), triplets)) {
-            auto& y = yarray[i];
-            for (auto& t : triplets) {
-                y += xarray[t.col()] * t.value();
-            }
+    intersectGridBoxes([&](size_t i, const std::vector<Triplet>& triplets) {
+        auto& y = yarray[i];
+        for (auto& t : triplets) {
+            y += xarray[t.col()] * t.value();
         }
-
-        ++i;
-    }
-
-    if (!failures_.empty()) {
-        giveUp(failures_);
-    }
+    });
 }
 
 
@@ -15,7 +15,6 @@
 #include <limits>
 #include <vector>
 
-#include "eckit/log/ProgressTimer.h"
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/array.h"
@@ -56,7 +55,6 @@ void GridBoxMaximum::do_execute(const Field& source, Field& target, Metadata&) c
     ATLAS_ASSERT(yarray.size() == targetBoxes_.size());
 
     yarray.assign(0.);
-    failures_.clear();
 
 
     if (!matrixFree_) {
@@ -88,33 +86,18 @@ void GridBoxMaximum::do_execute(const Field& source, Field& target, Metadata&) c
     functionspace::PointCloud tgt = target_;
     ATLAS_ASSERT(tgt);
 
-    ATLAS_ASSERT(searchRadius_ > 0.);
     ATLAS_ASSERT(!sourceBoxes_.empty());
     ATLAS_ASSERT(!targetBoxes_.empty());
 
 
     // interpolate
-    eckit::ProgressTimer progress("Intersecting", targetBoxes_.size(), "grid box", double(5.));
+    intersectGridBoxes([&](size_t i, const std::vector<Triplet>& triplets) {
+        auto triplet = std::max_element(triplets.begin(), triplets.end(), [](const Triplet& a, const Triplet& b) {
+            return !eckit::types::is_approximately_greater_or_equal(a.value(), b.value());
+        });
 
-    std::vector<Triplet> triplets;
-    size_t i = 0;
-    for (auto p : tgt.iterate().lonlat()) {
-        ++progress;
-
-        if (intersect(i, targetBoxes_.at(i), pTree_.closestPointsWithinRadius(p, searchRadius_), triplets)) {
-            auto triplet = std::max_element(triplets.begin(), triplets.end(), [](const Triplet& a, const Triplet& b) {
-                return !eckit::types::is_approximately_greater_or_equal(a.value(), b.value());
-            });
-
-            yarray[i] = xarray[triplet->col()];
-        }
-
-        ++i;
-    }
-
-    if (!failures_.empty()) {
-        giveUp(failures_);
-    }
+        yarray[i] = xarray[triplet->col()];
+    });
 }
 
 
@@ -26,6 +26,9 @@ public:
 private:
     void do_execute(const FieldSet& source, FieldSet& target, Metadata&) const override;
     void do_execute(const Field& source, Field& target, Metadata&) const override;
+
+    // The maximum is taken over the nonzeros of the full matrix
+    bool matrix_required() const override { return true; }
 };
 
 
@@ -12,6 +12,7 @@
 #include "atlas/interpolation/method/knn/GridBoxMethod.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 
 #include "eckit/log/Plural.h"
@@ -21,6 +22,7 @@
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -72,22 +74,16 @@ void GridBoxMethod::do_setup(const FunctionSpace& source, const FunctionSpace& t
     do_setup(src_grid,tgt_grid,Cache());
 }
 
-bool GridBoxMethod::intersect(size_t i, const GridBox& box, const util::IndexKDTree::ValueList& closest,
+bool GridBoxMethod::intersect(size_t i, const GridBox& box, const std::vector<size_t>& candidates,
                               std::vector<eckit::linalg::Triplet>& triplets) const {
-    ASSERT(!closest.empty());
-
     triplets.clear();
-    triplets.reserve(closest.size());
 
     double area = box.area();
     ASSERT(area > 0.);
 
     double sumSmallAreas = 0.;
-    for (auto& c : closest) {
-        auto j = c.payload();
-        ASSERT(j >= 0);
-
-        auto smallBox = sourceBoxes_.at(size_t(j));
+    for (auto j : candidates) {
+        auto smallBox = sourceBoxes_[j];
         if (box.intersects(smallBox)) {
             double smallArea = smallBox.area();
             ASSERT(smallArea > 0.);
@@ -101,17 +97,71 @@ bool GridBoxMethod::intersect(size_t i, const GridBox& box, const util::IndexKDT
         }
     }
 
-    if (failEarly_) {
-        Log::error() << "Failed to intersect grid box " << i << ", " << box << std::endl;
-        throw_Exception("Failed to intersect grid box");
-    }
-
-    failures_.push_front(i);
     triplets.clear();
     return false;
 }
 
 
+namespace {
+constexpr size_t CHUNK = 1024;  // target grid boxes per chunk
+}
+
+
+void GridBoxMethod::intersectGridBoxes(const std::function<void(size_t, const std::vector<Triplet>&)>& f) const {
+    ATLAS_ASSERT(!sourceBoxes_.empty());
+    ATLAS_ASSERT(!targetBoxes_.empty());
+
+    // Candidate source grid boxes come from the structure of the source grid (latitude bands and longitude
+    // ranges), chunks are dynamically scheduled over threads and failures collected per chunk, in order
+    const auto N         = targetBoxes_.size();
+    const idx_t nbChunks = idx_t((N + CHUNK - 1) / CHUNK);
+    std::vector<std::vector<size_t>> chunkFailures(size_t(nbChunks));
+    std::atomic<bool> failed{false};
+
+    constexpr double TIMED = 5.;
+    eckit::ProgressTimer progress("Intersecting", size_t(nbChunks), "chunk", TIMED);
+
+    atlas_omp_parallel_for(idx_t c = 0; c < nbChunks; ++c) {
+        std::vector<size_t> candidates;
+        std::vector<Triplet> triplets;
+        for (size_t i = size_t(c) * CHUNK; i < std::min(N, size_t(c + 1) * CHUNK); ++i) {
+            if (failEarly_ && failed) {
+                break;
+            }
+
+            const auto& box = targetBoxes_[i];
+            sourceBoxes_.candidates(box, candidates);
+            if (intersect(i, box, candidates, triplets)) {
+                f(i, triplets);
+            }
+            else {
+                chunkFailures[size_t(c)].push_back(i);
+                failed = true;
+            }
+        }
+        atlas_omp_critical {
+            ++progress;
+        }
+    }
+
+    failures_.clear();
+    for (auto c = chunkFailures.rbegin(); c != chunkFailures.rend(); ++c) {
+        for (auto i = c->rbegin(); i != c->rend(); ++i) {
+            failures_.push_front(*i);
+        }
+    }
+
+    if (!failures_.empty()) {
+        if (failEarly_) {
+            auto i = failures_.front();
+            Log::error() << "Failed to intersect grid box " << i << ", " << targetBoxes_[i] << std::endl;
+            throw_Exception("Failed to intersect grid box");
+        }
+        giveUp(failures_);
+    }
+}
+
+
 void GridBoxMethod::do_setup(const Grid& source, const Grid& target, const Cache& cache) {
     ATLAS_TRACE("GridBoxMethod::setup()");
 
@@ -136,14 +186,14 @@ void GridBoxMethod::do_setup(const Grid& source, const Grid& target, const Cache
         return;
     }
 
-    if (not extractTreeFromCache(cache)) {
+    // Not used for intersecting, but kept for the cache (see createCache)
+    if (not extractTreeFromCache(cache, src)) {
         buildPointSearchTree(src);
     }
 
     sourceBoxes_ = GridBoxes(source, gaussianWeightedLatitudes_);
     targetBoxes_ = GridBoxes(target, gaussianWeightedLatitudes_);
 
-    searchRadius_ = sourceBoxes_.getLongestGridBoxDiagonal() + targetBoxes_.getLongestGridBoxDiagonal();
     failures_.clear();
 
     if (matrixFree_) {
@@ -155,23 +205,21 @@ void GridBoxMethod::do_setup(const Grid& source, const Grid& target, const Cache
     {
         ATLAS_TRACE("GridBoxMethod::setup: intersecting grid boxes");
 
-        constexpr double TIMED = 5.;
-        eckit::ProgressTimer progress("Intersecting", targetBoxes_.size(), "grid box", TIMED);
+        // Chunks are processed by a single thread each, so their triplets are in row order
+        std::vector<std::vector<Triplet>> chunkTriplets((targetBoxes_.size() + CHUNK - 1) / CHUNK);
+        intersectGridBoxes([&](size_t i, const std::vector<Triplet>& triplets) {
+            auto& chunk = chunkTriplets[i / CHUNK];
+            chunk.insert(chunk.end(), triplets.begin(), triplets.end());
+        });
 
-        std::vector<Triplet> triplets;
-        size_t i = 0;
-        for (auto p : tgt.iterate().lonlat()) {
-            ++progress;
-
-            if (intersect(i, targetBoxes_.at(i), pTree_.closestPointsWithinRadius(p, searchRadius_), triplets)) {
-                std::copy(triplets.begin(), triplets.end(), std::back_inserter(allTriplets));
-            }
-
-            ++i;
+        size_t nbTriplets = 0;
+        for (const auto& chunk : chunkTriplets) {
+            nbTriplets += chunk.size();
         }
-
-        if (!failures_.empty()) {
-            giveUp(failures_);
+        allTriplets.reserve(nbTriplets);
+        for (auto& chunk : chunkTriplets) {
+            allTriplets.insert(allTriplets.end(), chunk.begin(), chunk.end());
+            std::vector<Triplet>().swap(chunk);
         }
     }
 
@@ -204,8 +252,9 @@ void GridBoxMethod::giveUp(const std::forward_list<size_t>& failures) {
 Cache GridBoxMethod::createCache() const {
     Cache cache;
     cache.add(interpolation::IndexKDTreeCache(pTree_));
-    if (not matrix().empty()) {
-        cache.add(Method::createCache());
+    interpolation::MatrixCache matrix_cache(Method::createCache());
+    if (matrix_cache) {
+        cache.add(matrix_cache);
     }
     return cache;
 }
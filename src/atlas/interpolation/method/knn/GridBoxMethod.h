@@ -14,6 +14,8 @@
 #include "atlas/interpolation/method/knn/KNearestNeighboursBase.h"
 
 #include <forward_list>
+#include <functional>
+#include <vector>
 
 #include "atlas/functionspace.h"
 #include "atlas/interpolation/method/knn/GridBox.h"
@@ -44,7 +46,21 @@ protected:
     virtual const FunctionSpace& source() const override { return source_; }
     virtual const FunctionSpace& target() const override { return target_; }
 
-    bool intersect(size_t i, const GridBox& iBox, const util::IndexKDTree::ValueList&, std::vector<Triplet>&) const;
+    /**
+     * @brief Intersect a target grid box with source grid boxes, filling triplets with the intersected area fractions
+     * @param i target grid box index
+     * @param iBox target grid box
+     * @param candidates source grid box indices, a superset of the intersecting source grid boxes
+     * @return if the intersected areas add up to the target grid box area
+     */
+    bool intersect(size_t i, const GridBox& iBox, const std::vector<size_t>& candidates, std::vector<Triplet>&) const;
+
+    /**
+     * @brief Intersect all target grid boxes with the source grid boxes, concurrently in chunks of consecutive target
+     * grid boxes, then give up if any failed
+     * @param f called with (i, triplets) for each intersected target grid box i, in ascending order within a chunk
+     */
+    void intersectGridBoxes(const std::function<void(size_t, const std::vector<Triplet>&)>& f) const;
 
     virtual void do_execute(const FieldSet& source, FieldSet& target, Metadata&) const override = 0;
     virtual void do_execute(const Field& source, Field& target, Metadata&) const override       = 0;
@@ -60,8 +76,6 @@ protected:
     GridBoxes sourceBoxes_;
     GridBoxes targetBoxes_;
 
-    double searchRadius_;
-
     mutable std::forward_list<size_t> failures_;
 
     bool matrixFree_;
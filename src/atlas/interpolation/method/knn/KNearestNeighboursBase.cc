@@ -20,6 +20,7 @@
 #include "atlas/library/Library.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 
@@ -125,9 +126,13 @@ void KNearestNeighboursBase::buildPointSearchTree(const FunctionSpace& functions
     pTree_.build();
 }
 
-bool KNearestNeighboursBase::extractTreeFromCache(const Cache& c) {
+bool KNearestNeighboursBase::extractTreeFromCache(const Cache& c, const FunctionSpace& source) {
     IndexKDTreeCache cache(c);
     if (cache) {
+        // Payloads are local indices of the source, e.g. grid indices of util::PersistentKDTree, which only
+        // coincide for a source which is not distributed
+        ATLAS_ASSERT(source.nb_parts() == 1 && cache.tree().size() == size_t(source.size()),
+                     "Cached kd-tree does not match the source; it only applies to non-distributed sources");
         pTree_ = cache.tree();
         return true;
     }
@@ -30,7 +30,9 @@ protected:
     void buildPointSearchTree(Mesh& meshSource) { buildPointSearchTree(meshSource, mesh::Halo(meshSource)); }
     void buildPointSearchTree(Mesh& meshSource, const mesh::Halo&);
     void buildPointSearchTree(const FunctionSpace&);
-    bool extractTreeFromCache(const Cache&);
+    /// Use the tree of the cache, if any. Its payloads are local indices of the source, so that a cached tree
+    /// only applies to the same, non-distributed, source function space.
+    bool extractTreeFromCache(const Cache&, const FunctionSpace& source);
 
     util::IndexKDTree pTree_;
 };
@@ -17,6 +17,7 @@
 
 #include "atlas/array.h"
 #include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/PointCloud.h"
 #include "atlas/grid.h"
 #include "atlas/interpolation/method/MethodFactory.h"
 #include "atlas/mesh/Nodes.h"
@@ -38,7 +39,7 @@ MethodBuilder<NearestNeighbour> __builder("nearest-neighbour");
 
 }  // namespace
 
-void NearestNeighbour::do_setup(const Grid& source, const Grid& target, const Cache&) {
+void NearestNeighbour::do_setup(const Grid& source, const Grid& target, const Cache& cache) {
     if (mpi::size() > 1) {
         ATLAS_NOTIMPLEMENTED;
     }
@@ -53,16 +54,29 @@ void NearestNeighbour::do_setup(const Grid& source, const Grid& target, const Ca
         return functionspace::NodeColumns(mesh);
     };
 
+    // The payloads of a cached tree, e.g. of util::PersistentKDTree, are grid indices, which are the indices of
+    // the non-distributed PointCloud of the source grid
+    if (IndexKDTreeCache(cache)) {
+        FunctionSpace src = functionspace::PointCloud(source);
+        extractTreeFromCache(cache, src);
+        setup_matrix(src, functionspace(target));
+        return;
+    }
+
     do_setup(functionspace(source), functionspace(target));
 }
 
 void NearestNeighbour::do_setup(const FunctionSpace& source, const FunctionSpace& target) {
-    source_                        = source;
-    target_                        = target;
-
     // build point-search tree
     buildPointSearchTree(source);
 
+    setup_matrix(source, target);
+}
+
+void NearestNeighbour::setup_matrix(const FunctionSpace& source, const FunctionSpace& target) {
+    source_ = source;
+    target_ = target;
+
     array::ArrayView<double, 2> lonlat = array::make_view<double, 2>(target.lonlat());
 
     size_t inp_npts = source.size();
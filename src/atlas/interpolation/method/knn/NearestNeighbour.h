@@ -42,6 +42,9 @@ private:
 
     virtual void do_setup(const Grid& source, const Grid& target, const Cache&) override;
 
+    /// Compute the weights with the point-search tree of the source
+    void setup_matrix(const FunctionSpace& source, const FunctionSpace& target);
+
     FunctionSpace source_;
     FunctionSpace target_;
 };
@@ -81,6 +81,9 @@ class SphericalVector : public Method {
                 const FunctionSpace& target) override;
   void do_setup(const Grid& source, const Grid& target, const Cache&) override;
 
+  // Vector fields are checked against the full matrix
+  bool matrix_required() const override { return true; }
+
   eckit::LocalConfiguration interpolationScheme_;
 
   FunctionSpace source_;
@@ -12,6 +12,7 @@
 
 #include "StructuredInterpolation2D.h"
 
+#include <array>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -215,6 +216,25 @@ namespace {
             ATLAS_THROW_EXCEPTION(err.str());
         }
     }
+
+    /// Thread private batch of consecutive target points, whose stencils are computed together
+    template <typename Kernel>
+    struct StencilBatch {
+        static constexpr idx_t size = 64;
+        std::array<double, size> x;
+        std::array<double, size> y;
+        typename Kernel::Stencils stencils{size};
+
+        template <typename LonLat>
+        void compute_stencils(const Kernel& kernel, idx_t begin, idx_t end, LonLat lonlat) {
+            for (idx_t n = begin; n < end; ++n) {
+                PointLonLat p = lonlat(n);
+                x[n - begin]  = p.lon();
+                y[n - begin]  = p.lat();
+            }
+            kernel.compute_stencils(end - begin, x.data(), y.data(), stencils);
+        }
+    };
 }
 }
 
@@ -354,7 +374,7 @@ void StructuredInterpolation2D<Kernel>::setup( const FunctionSpace& source ) {
         using WorkSpace = typename Kernel::WorkSpace;
         auto interpolate_point = [&]( idx_t n, PointLonLat&& p, WorkSpace& workspace ) -> int {
             try {
-                kernel_->insert_triplets( n, p, triplets, workspace );
+                kernel_->insert_triplets_with_stencil( n, p.lon(), p.lat(), triplets, workspace );
                 return 0;
             }
             catch(const eckit::Exception& e) {}
@@ -364,14 +384,21 @@ void StructuredInterpolation2D<Kernel>::setup( const FunctionSpace& source ) {
             return 1;
         };
 
-        auto interpolate_omp = [&failed_points,interpolate_point]( idx_t out_npts, auto lonlat, auto ghost) {
+        const Kernel& kernel = *kernel_;
+        auto interpolate_omp = [&failed_points,&kernel,interpolate_point]( idx_t out_npts, auto lonlat, auto ghost) {
             atlas_omp_parallel {
                 WorkSpace workspace;
-                atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
-                    if( not ghost(n) ) {
-                        if (interpolate_point(n, lonlat(n), workspace) != 0) {
-                            atlas_omp_critical {
-                                failed_points.emplace_back(n);
+                StencilBatch<Kernel> batch;
+                atlas_omp_for( idx_t begin = 0; begin < out_npts; begin += batch.size ) {
+                    const idx_t end = std::min( begin + batch.size, out_npts );
+                    batch.compute_stencils( kernel, begin, end, lonlat );
+                    for( idx_t n = begin; n < end; ++n ) {
+                        if( not ghost(n) ) {
+                            batch.stencils.get( n - begin, workspace.stencil );
+                            if (interpolate_point(n, lonlat(n), workspace) != 0) {
+                                atlas_omp_critical {
+                                    failed_points.emplace_back(n);
+                                }
                             }
                         }
                     }
@@ -503,7 +530,6 @@ void StructuredInterpolation2D<Kernel>::execute_impl( const Kernel& kernel, cons
 
     auto interpolate_point = [&]( idx_t n, PointLonLat&& p, WorkSpace& workspace ) -> int {
         try {
-            kernel.compute_stencil( p.lon(), p.lat(), workspace.stencil );
             kernel.compute_weights( p.lon(), p.lat(), workspace.stencil, workspace.weights );
             kernel.make_valid_stencil( p.lon(), p.lat(), workspace.stencil );
             for ( idx_t i = 0; i < N; ++i ) {
@@ -520,14 +546,20 @@ void StructuredInterpolation2D<Kernel>::execute_impl( const Kernel& kernel, cons
 
     std::vector<idx_t> failed_points;
 
-    auto interpolate_omp = [&failed_points,interpolate_point]( idx_t out_npts, auto lonlat, auto ghost) {
+    auto interpolate_omp = [&failed_points,&kernel,interpolate_point]( idx_t out_npts, auto lonlat, auto ghost) {
         atlas_omp_parallel {
             WorkSpace workspace;
-            atlas_omp_for( idx_t n = 0; n < out_npts; ++n ) {
-                if( not ghost(n) ) {
-                    if (interpolate_point(n, lonlat(n), workspace) != 0) {
-                        atlas_omp_critical {
-                            failed_points.emplace_back(n);
+            StencilBatch<Kernel> batch;
+            atlas_omp_for( idx_t begin = 0; begin < out_npts; begin += batch.size ) {
+                const idx_t end = std::min( begin + batch.size, out_npts );
+                batch.compute_stencils( kernel, begin, end, lonlat );
+                for( idx_t n = begin; n < end; ++n ) {
+                    if( not ghost(n) ) {
+                        batch.stencils.get( n - begin, workspace.stencil );
+                        if (interpolate_point(n, lonlat(n), workspace) != 0) {
+                            atlas_omp_critical {
+                                failed_points.emplace_back(n);
+                            }
                         }
                     }
                 }
@@ -61,7 +61,8 @@ public:
     }
 
 public:
-    using Stencil = grid::HorizontalStencil<4>;
+    using Stencil  = grid::HorizontalStencil<4>;
+    using Stencils = grid::HorizontalStencils<4>;
     struct Weights {
         std::array<std::array<double, 4>, 4> weights_i;
         std::array<double, 4> weights_j;
@@ -78,6 +79,11 @@ public:
         compute_horizontal_stencil_(x, y, stencil);
     }
 
+    /// Compute the stencils of n points at once
+    void compute_stencils(idx_t n, const double x[], const double y[], Stencils& stencils) const {
+        compute_horizontal_stencil_(n, x, y, stencils);
+    }
+
     template <typename stencil_t>
     void make_valid_stencil(double& x, double y, stencil_t& stencil, bool retry = true) const {
         for (idx_t j = 0; j < stencil_width(); ++j) {
@@ -325,6 +331,11 @@ public:
 
     void insert_triplets(const idx_t row, double x, double y, Triplets& triplets, WorkSpace& ws) const {
         compute_stencil(x, y, ws.stencil);
+        insert_triplets_with_stencil(row, x, y, triplets, ws);
+    }
+
+    /// Insert triplets of a point whose stencil is already computed in the workspace
+    void insert_triplets_with_stencil(const idx_t row, double x, double y, Triplets& triplets, WorkSpace& ws) const {
         compute_weights(x, y, ws.stencil, ws.weights);
 
         make_valid_stencil(x, y, ws.stencil);
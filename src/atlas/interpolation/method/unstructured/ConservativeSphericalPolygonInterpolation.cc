@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <numeric>
 #include <vector>
 #include <sys/stat.h> // for mkdir
 
@@ -25,6 +26,7 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
+#include "atlas/parallel/omp/sort.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -182,25 +184,66 @@ Mesh extract_mesh(FunctionSpace fs) {
 
 void sort_and_accumulate_triplets(std::vector<eckit::linalg::Triplet>& triplets) {
     ATLAS_TRACE();
-    std::map<std::pair<int, int>, double> triplet_map;
-    ATLAS_TRACE_SCOPE("accumulate in map")
-    for (auto& triplet : triplets) {
-        auto loc   = std::make_pair<int, int>(triplet.row(), triplet.col());
-        auto entry = triplet_map.find(loc);
-        if (entry == triplet_map.end()) {
-            triplet_map[loc] = triplet.value();
-        }
-        else {
-            entry->second += triplet.value();
+    // Duplicates are ordered by their original position, so that they are accumulated in the same order
+    // for any number of threads
+    std::vector<size_t> order(triplets.size());
+    std::iota(order.begin(), order.end(), 0);
+    ATLAS_TRACE_SCOPE("sort") {
+        omp::sort(order.begin(), order.end(), [&triplets](size_t a, size_t b) {
+            const auto& ta = triplets[a];
+            const auto& tb = triplets[b];
+            if (ta.row() != tb.row()) {
+                return ta.row() < tb.row();
+            }
+            if (ta.col() != tb.col()) {
+                return ta.col() < tb.col();
+            }
+            return a < b;
+        });
+    }
+    std::vector<eckit::linalg::Triplet> accumulated;
+    accumulated.reserve(triplets.size());
+    ATLAS_TRACE_SCOPE("accumulate") {
+        for (size_t i = 0; i < order.size();) {
+            const auto& first = triplets[order[i]];
+            double value      = first.value();
+            size_t j          = i + 1;
+            for (; j < order.size(); ++j) {
+                const auto& next = triplets[order[j]];
+                if (next.row() != first.row() || next.col() != first.col()) {
+                    break;
+                }
+                value += next.value();
+            }
+            accumulated.emplace_back(first.row(), first.col(), value);
+            i = j;
         }
     }
-    triplets.clear();
-    ATLAS_TRACE_SCOPE("recontruct sorted vector from map")
-    for (auto& triplet : triplet_map) {
-        auto& row = triplet.first.first;
-        auto& col = triplet.first.second;
-        auto& val = triplet.second;
-        triplets.emplace_back(row, col, val);
+    triplets.swap(accumulated);
+}
+
+/// Assemble triplets with a parallel loop over [0, size). Each thread handles a contiguous block of indices and
+/// the blocks are concatenated in order, so that the triplets are the same as those of a serial loop.
+template <typename Functor>
+void assemble_triplets(idx_t size, std::vector<eckit::linalg::Triplet>& triplets, const Functor& assemble) {
+    std::vector<std::vector<eckit::linalg::Triplet>> thread_triplets(atlas_omp_get_max_threads());
+    atlas_omp_parallel {
+        const size_t num_threads = atlas_omp_get_num_threads();
+        const size_t thread_num  = atlas_omp_get_thread_num();
+        const idx_t begin        = static_cast<idx_t>(thread_num * size_t(size) / num_threads);
+        const idx_t end          = static_cast<idx_t>((thread_num + 1) * size_t(size) / num_threads);
+        auto& local_triplets     = thread_triplets[thread_num];
+        for (idx_t i = begin; i < end; ++i) {
+            assemble(i, local_triplets);
+        }
+    }
+    size_t size_triplets = triplets.size();
+    for (const auto& local_triplets : thread_triplets) {
+        size_triplets += local_triplets.size();
+    }
+    triplets.reserve(size_triplets);
+    for (const auto& local_triplets : thread_triplets) {
+        triplets.insert(triplets.end(), local_triplets.begin(), local_triplets.end());
     }
 }
 
@@ -949,16 +992,15 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
         return false;
     };
 
-    std::set<PointXYZ, decltype(compare_pointxyz)> src_cent(compare_pointxyz);
-    auto src_already_in = [&](const PointXYZ& halo_cent) {
-        if (src_cent.find(halo_cent) == src_cent.end()) {
-            atlas_omp_critical{
-              src_cent.insert(halo_cent);
-            }
-            return false;
+    // Source polygons that appear more than once (same centroid) are only intersected for their first occurrence.
+    // This is decided before the parallel loop so that the result does not depend on the number of threads.
+    std::vector<char> src_already_in(src_csp.size(), false);
+    {
+        std::set<PointXYZ, decltype(compare_pointxyz)> src_cent(compare_pointxyz);
+        for (idx_t scell = 0; scell < src_csp.size(); ++scell) {
+            src_already_in[scell] = not src_cent.insert(std::get<0>(src_csp[scell]).centroid()).second;
         }
-        return true;
-    };
+    }
     stopwatch_src_already_in.stop();
 
     enum MeshSizeId
@@ -979,8 +1021,13 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
     src_iparam_.resize(src_csp.size());
 
     std::vector<InterpolationParameters> tgt_iparam;  // only used for debugging
+    // per source cell: the intersected target cells with intersection areas, and the coverage error
+    std::vector<std::vector<std::pair<idx_t, double>>> src_tgt_intersections;
+    std::vector<double> src_cover_errors;
     if (validate_) {
         tgt_iparam.resize(tgt_csp.size());
+        src_tgt_intersections.resize(src_csp.size());
+        src_cover_errors.resize(src_csp.size(), 0.);
     }
 
     // the worst target polygon coverage for analysis of intersection
@@ -997,32 +1044,34 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
     eckit::Channel blackhole;
     eckit::ProgressTimer progress("Intersecting polygons ", src_csp.size() / atlas_omp_get_max_threads(), " (cell/thread)", double(10),
                                   src_csp.size() / atlas_omp_get_max_threads() > 50 ? Log::info() : blackhole);
+    // Each source cell only writes its own interpolation parameters, so the weights do not depend on the number
+    // of threads. Timings are sampled on the master thread.
     atlas_omp_parallel_for (idx_t scell = 0; scell < src_csp.size(); ++scell) {
-        if ( atlas_omp_get_thread_num() == 0 ) {
+        const bool master_thread = (atlas_omp_get_thread_num() == 0);
+        if (master_thread) {
             ++progress;
-            stopwatch_src_already_in.start();
-        }
-        bool already_in = src_already_in((std::get<0>(src_csp[scell]).centroid()));
-        if ( atlas_omp_get_thread_num() == 0 ) {
-            stopwatch_src_already_in.stop();
         }
-        if (not already_in) {
+        if (not src_already_in[scell]) {
             const auto& s_csp       = std::get<0>(src_csp[scell]);
             const double s_csp_area = s_csp.area();
             double src_cover_area   = 0.;
 
-            stopwatch_kdtree_search.start();
+            if (master_thread) {
+                stopwatch_kdtree_search.start();
+            }
             auto tgt_cells = kdt_search.closestPointsWithinRadius(s_csp.centroid(), s_csp.radius() + max_tgtcell_rad);
-            stopwatch_kdtree_search.stop();
+            if (master_thread) {
+                stopwatch_kdtree_search.stop();
+            }
             for (idx_t ttcell = 0; ttcell < tgt_cells.size(); ++ttcell) {
                 auto tcell        = tgt_cells[ttcell].payload();
                 const auto& t_csp = std::get<0>(tgt_csp[tcell]);
-                if( atlas_omp_get_thread_num() == 0 ) {
+                if (master_thread) {
                     stopwatch_polygon_intersections.start();
-               }
+                }
                 ConvexSphericalPolygon csp_i = s_csp.intersect(t_csp, nullptr, pointsSameEPS);
                 double csp_i_area            = csp_i.area();
-                if( atlas_omp_get_thread_num() == 0 ) {
+                if (master_thread) {
                     stopwatch_polygon_intersections.stop();
                 }
                 if (validate_) {
@@ -1032,10 +1081,7 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
                         dump_intersection("Zero area intersections with inside_vertices", s_csp, tgt_csp, tgt_cells);
                     }
                     // TODO: assuming intersector search works fine, this should be move under "if (csp_i_area > 0)"
-                    atlas_omp_critical {
-                        tgt_iparam[tcell].cell_idx.emplace_back(scell);
-                        tgt_iparam[tcell].tgt_weights.emplace_back(csp_i_area);
-                    }
+                    src_tgt_intersections[scell].emplace_back(tcell, csp_i_area);
                 }
                 if (csp_i_area > 0) {
                     src_iparam_[scell].cell_idx.emplace_back(tcell);
@@ -1065,12 +1111,7 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
                 // TODO: mark these source cells beforehand and compute error in them among the processes
                 if (validate_ and mpi::size() == 1) {
                     dump_intersection("Source cell not exactly covered", s_csp, tgt_csp, tgt_cells);
-                    if (statistics_intersection_) {
-                        atlas_omp_critical{
-                            area_coverage[TOTAL_SRC] += src_cover_err;
-                            area_coverage[MAX_SRC] = std::max(area_coverage[MAX_SRC], src_cover_err);
-                        }
-                    }
+                    src_cover_errors[scell] = src_cover_err;
                 }
             }
             if (src_iparam_[scell].cell_idx.size() == 0 and statistics_intersection_) {
@@ -1092,6 +1133,19 @@ void ConservativeSphericalPolygonInterpolation::intersect_polygons(const CSPolyg
             }
         } // already in
     }
+    if (validate_) {
+        // merged in order of source cells, as a serial loop would
+        for (idx_t scell = 0; scell < src_csp.size(); ++scell) {
+            for (const auto& intersection : src_tgt_intersections[scell]) {
+                tgt_iparam[intersection.first].cell_idx.emplace_back(scell);
+                tgt_iparam[intersection.first].tgt_weights.emplace_back(intersection.second);
+            }
+            if (statistics_intersection_) {
+                area_coverage[TOTAL_SRC] += src_cover_errors[scell];
+                area_coverage[MAX_SRC] = std::max(area_coverage[MAX_SRC], src_cover_errors[scell]);
+            }
+        }
+    }
     timings.polygon_intersections  = stopwatch_polygon_intersections.elapsed();
     timings.target_kdtree_search   = stopwatch_kdtree_search.elapsed();
     timings.source_polygons_filter = stopwatch_src_already_in.elapsed();
@@ -1252,70 +1306,50 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_1
     ATLAS_TRACE("ConservativeMethod::setup: build cons-1 interpolant matrix");
     ATLAS_ASSERT(not matrix_free_);
     Triplets triplets;
-    size_t triplets_size    = 0;
     const auto& src_iparam_ = data_->src_iparam_;
-    // determine the size of array of triplets used to define the sparse matrix
-    if (src_cell_data_) {
-        for (idx_t scell = 0; scell < n_spoints_; ++scell) {
-            triplets_size += src_iparam_[scell].cell_idx.size();
-        }
-    }
-    else {
-        auto& src_node2csp_ = data_->src_node2csp_;
-        for (idx_t snode = 0; snode < n_spoints_; ++snode) {
-            for (idx_t isubcell = 0; isubcell < src_node2csp_[snode].size(); ++isubcell) {
-                idx_t subcell = src_node2csp_[snode][isubcell];
-                triplets_size += src_iparam_[subcell].tgt_weights.size();
-            }
-        }
-    }
-    triplets.reserve(triplets_size);
     // assemble triplets to define the sparse matrix
     const auto& src_areas_v = data_->src_areas_;
     const auto& tgt_areas_v = data_->tgt_areas_;
     if (src_cell_data_ && tgt_cell_data_) {
-        for (idx_t scell = 0; scell < n_spoints_; ++scell) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t scell, Triplets& local_triplets) {
             const auto& iparam = src_iparam_[scell];
             for (idx_t icell = 0; icell < iparam.cell_idx.size(); ++icell) {
                 idx_t tcell = iparam.cell_idx[icell];
-                triplets.emplace_back(tcell, scell, iparam.tgt_weights[icell]);
+                local_triplets.emplace_back(tcell, scell, iparam.tgt_weights[icell]);
             }
-        }
+        });
     }
     else if (not src_cell_data_ && tgt_cell_data_) {
         auto& src_node2csp_ = data_->src_node2csp_;
-        for (idx_t snode = 0; snode < n_spoints_; ++snode) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t snode, Triplets& local_triplets) {
             for (idx_t isubcell = 0; isubcell < src_node2csp_[snode].size(); ++isubcell) {
                 const idx_t subcell = src_node2csp_[snode][isubcell];
                 const auto& iparam  = src_iparam_[subcell];
                 for (idx_t icell = 0; icell < iparam.cell_idx.size(); ++icell) {
                     idx_t tcell = iparam.cell_idx[icell];
                     ATLAS_ASSERT(tcell < n_tpoints_);
-                    triplets.emplace_back(tcell, snode, iparam.tgt_weights[icell]);
+                    local_triplets.emplace_back(tcell, snode, iparam.tgt_weights[icell]);
                 }
             }
-        }
+        });
     }
     else if (src_cell_data_ && not tgt_cell_data_) {
         auto& tgt_csp2node_ = data_->tgt_csp2node_;
-        for (idx_t scell = 0; scell < n_spoints_; ++scell) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t scell, Triplets& local_triplets) {
             const auto& iparam = src_iparam_[scell];
             for (idx_t icell = 0; icell < iparam.cell_idx.size(); ++icell) {
                 idx_t tcell            = iparam.cell_idx[icell];
                 idx_t tnode            = tgt_csp2node_[tcell];
-                if (tnode >= n_tpoints_) {
-                    Log::info() << "tnode, n_tpoints = " << tnode << ", " << n_tpoints_ << std::endl;
-                    ATLAS_ASSERT(false);
-                }
+                ATLAS_ASSERT(tnode < n_tpoints_);
                 double inv_node_weight = (tgt_areas_v[tnode] > 0. ? 1. / tgt_areas_v[tnode] : 0.);
-                triplets.emplace_back(tnode, scell, iparam.weights[icell] * inv_node_weight);
+                local_triplets.emplace_back(tnode, scell, iparam.weights[icell] * inv_node_weight);
             }
-        }
+        });
     }
     else if (not src_cell_data_ && not tgt_cell_data_) {
         auto& src_node2csp_ = data_->src_node2csp_;
         auto& tgt_csp2node_ = data_->tgt_csp2node_;
-        for (idx_t snode = 0; snode < n_spoints_; ++snode) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t snode, Triplets& local_triplets) {
             for (idx_t isubcell = 0; isubcell < src_node2csp_[snode].size(); ++isubcell) {
                 const idx_t subcell = src_node2csp_[snode][isubcell];
                 const auto& iparam  = src_iparam_[subcell];
@@ -1324,14 +1358,10 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_1
                     idx_t tnode            = tgt_csp2node_[tcell];
                     ATLAS_ASSERT(tnode < n_tpoints_);
                     double inv_node_weight = (tgt_areas_v[tnode] > 0. ? 1. / tgt_areas_v[tnode] : 0.);
-                    triplets.emplace_back(tnode, snode, iparam.weights[icell] * inv_node_weight);
-                    if( tnode >= n_tpoints_) {
-                        Log::info() << tnode << " = tnode, " << n_tpoints_ << " = n_tpoints\n";;
-                        ATLAS_ASSERT(false);
-                    }
+                    local_triplets.emplace_back(tnode, snode, iparam.weights[icell] * inv_node_weight);
                 }
             }
-        }
+        });
     }
     sort_and_accumulate_triplets(triplets);  // Very expensive!!! (90% of this routine). We need to avoid it
 
@@ -1365,19 +1395,17 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_2
     const auto& src_iparam_ = data_->src_iparam_;
 
     Triplets triplets;
-    size_t triplets_size    = 0;
     const auto& tgt_areas_v = data_->tgt_areas_;
+    // get_cell_neighbours and get_node_neighbours would otherwise build this connectivity inside the parallel loop
+    if (src_mesh_.nodes().cell_connectivity().rows() == 0) {
+        mesh::actions::build_node_to_cell_connectivity(src_mesh_);
+    }
     if (src_cell_data_) {
         const auto src_halo = array::make_view<int, 1>(src_mesh_.cells().halo());
-        for (idx_t scell = 0; scell < n_spoints_; ++scell) {
-            const auto nb_cells = get_cell_neighbours(src_mesh_, scell);
-            triplets_size += (2 * nb_cells.size() + 1) * src_iparam_[scell].cell_idx.size();
-        }
-        triplets.reserve(triplets_size);
-        for (idx_t scell = 0; scell < n_spoints_; ++scell) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t scell, Triplets& local_triplets) {
             const auto& iparam  = src_iparam_[scell];
             if (iparam.cell_idx.size() == 0 && not src_halo(scell)) {
-                continue;
+                return;
             }
             /* // better conservation after Kritsikis et al. (2017)
             // NOTE: ommited here at cost of conservation due to more involved implementation in parallel
@@ -1432,10 +1460,10 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_2
                         idx_t nj  = next_index(j, nb_cells.size());
                         idx_t sj  = nb_cells[j];
                         idx_t nsj = nb_cells[nj];
-                        triplets.emplace_back(tcell, sj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
-                        triplets.emplace_back(tcell, nsj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
+                        local_triplets.emplace_back(tcell, sj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
+                        local_triplets.emplace_back(tcell, nsj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
                     }
-                    triplets.emplace_back(tcell, scell, iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell]));
+                    local_triplets.emplace_back(tcell, scell, iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell]));
                 }
             }
             else {
@@ -1449,27 +1477,18 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_2
                         idx_t nj  = next_index(j, nb_cells.size());
                         idx_t sj  = nb_cells[j];
                         idx_t nsj = nb_cells[nj];
-                        triplets.emplace_back(tnode, sj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
-                        triplets.emplace_back(tnode, nsj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
+                        local_triplets.emplace_back(tnode, sj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
+                        local_triplets.emplace_back(tnode, nsj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
                     }
-                    triplets.emplace_back(tnode, scell,
+                    local_triplets.emplace_back(tnode, scell,
                                           (iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell])) * csp2node_coef);
                 }
             }
-        }
+        });
     }
     else {  // if ( not src_cell_data_ )
         auto& src_node2csp_ = data_->src_node2csp_;
-        const auto src_halo = array::make_view<int, 1>(src_mesh_.nodes().halo());
-        for (idx_t snode = 0; snode < n_spoints_; ++snode) {
-            const auto nb_nodes = get_node_neighbours(src_mesh_, snode);
-            for (idx_t isubcell = 0; isubcell < src_node2csp_[snode].size(); ++isubcell) {
-                idx_t subcell = src_node2csp_[snode][isubcell];
-                triplets_size += (2 * nb_nodes.size() + 1) * src_iparam_[subcell].cell_idx.size();
-            }
-        }
-        triplets.reserve(triplets_size);
-        for (idx_t snode = 0; snode < n_spoints_; ++snode) {
+        assemble_triplets(n_spoints_, triplets, [&](idx_t snode, Triplets& local_triplets) {
             const auto nb_nodes = get_node_neighbours(src_mesh_, snode);
             // get the barycentre of the dual cell
             /* // better conservation
@@ -1533,10 +1552,10 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_2
                             idx_t nj  = next_index(j, nb_nodes.size());
                             idx_t sj  = nb_nodes[j];
                             idx_t snj = nb_nodes[nj];
-                            triplets.emplace_back(tcell, sj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
-                            triplets.emplace_back(tcell, snj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
+                            local_triplets.emplace_back(tcell, sj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
+                            local_triplets.emplace_back(tcell, snj, 0.5 * PointXYZ::dot(Rsj[j], Aik[icell]));
                         }
-                        triplets.emplace_back(tcell, snode, iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell]));
+                        local_triplets.emplace_back(tcell, snode, iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell]));
                     }
                 }
                 else {
@@ -1550,16 +1569,16 @@ eckit::linalg::SparseMatrix ConservativeSphericalPolygonInterpolation::compute_2
                             idx_t nj  = next_index(j, nb_nodes.size());
                             idx_t sj  = nb_nodes[j];
                             idx_t snj = nb_nodes[nj];
-                            triplets.emplace_back(tnode, sj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
-                            triplets.emplace_back(tnode, snj,
+                            local_triplets.emplace_back(tnode, sj, (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
+                            local_triplets.emplace_back(tnode, snj,
                                                   (0.5 * PointXYZ::dot(Rsj[j], Aik[icell])) * csp2node_coef);
                         }
-                        triplets.emplace_back(
+                        local_triplets.emplace_back(
                             tnode, snode, (iparam.tgt_weights[icell] - PointXYZ::dot(Rs, Aik[icell])) * csp2node_coef);
                     }
                 }
             }
-        }
+        });
     }
     sort_and_accumulate_triplets(triplets);  // Very expensive!!! (90% of this routine). We need to avoid it
     return Matrix(n_tpoints_, n_spoints_, triplets);
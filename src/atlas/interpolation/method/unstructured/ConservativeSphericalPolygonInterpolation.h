@@ -151,6 +151,9 @@ public:
     interpolation::Cache createCache() const override;
 
 private:
+    // Statistics and footprint are computed from the full matrix
+    bool matrix_required() const override { return true; }
+
     using ConvexSphericalPolygon = util::ConvexSphericalPolygon;
     using PolygonArray           = std::vector<std::pair<ConvexSphericalPolygon, int>>;
     using CSPolygonArray         = std::vector<std::tuple<ConvexSphericalPolygon, int>>;
@@ -8,9 +8,12 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iomanip>
 #include <limits>
+#include <sstream>
 
 #include "FiniteElement.h"
 
@@ -26,6 +29,8 @@
 #include "atlas/interpolation/method/MethodFactory.h"
 #include "atlas/interpolation/method/Ray.h"
 #include "atlas/mesh/ElementType.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildCellCentres.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
@@ -33,6 +38,7 @@
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
@@ -52,6 +58,136 @@ MethodBuilder<FiniteElement> __builder("finite-element");
 // epsilon used to scale edge tolerance when projecting ray to intesect element
 static const double parametricEpsilon = 1e-15;
 
+// Locates candidate cells of a mesh generated from a StructuredGrid, without k-d tree.
+// The latitude band between two grid rows is found by binary search on the row latitudes, and the cells of a band
+// are sorted west to east, so that a longitude maps to a small window of cells in that band.
+// The polar caps beyond the first and last rows, where cells may span all longitudes, return all their cells.
+// The locator is empty (false) when the mesh nodes do not lie on the grid rows, e.g. for unstructured meshes.
+class StructuredCellLocator {
+public:
+    StructuredCellLocator() = default;
+
+    StructuredCellLocator(const Mesh& mesh) {
+        StructuredGrid grid(mesh.grid());
+        if (not grid) {
+            return;
+        }
+        ATLAS_TRACE("StructuredCellLocator");
+        y_ = grid.y();
+        y_.emplace_back(90.);
+        y_.emplace_back(-90.);
+        std::sort(y_.begin(), y_.end(), std::greater<double>());
+        y_.erase(std::unique(y_.begin(), y_.end()), y_.end());
+
+        // index in y_ of the row at given latitude, or -1
+        auto row = [&](double lat) -> idx_t {
+            auto it = std::lower_bound(y_.begin(), y_.end(), lat - tol(), std::greater<double>());
+            if (it != y_.begin() && std::abs(*(it - 1) - lat) <= tol()) {
+                return static_cast<idx_t>(it - y_.begin()) - 1;
+            }
+            return -1;
+        };
+
+        const idx_t nb_bands = static_cast<idx_t>(y_.size()) - 1;
+        std::vector<std::vector<std::pair<double, idx_t>>> bands(nb_bands);
+
+        const auto lonlat        = array::make_view<double, 2>(mesh.nodes().lonlat());
+        const auto& connectivity = mesh.cells().node_connectivity();
+        for (idx_t c = 0; c < connectivity.rows(); ++c) {
+            const idx_t nb_nodes = connectivity.cols(c);
+            idx_t row_min        = nb_bands + 1;
+            idx_t row_max        = -1;
+            for (idx_t n = 0; n < nb_nodes; ++n) {
+                idx_t r = row(lonlat(connectivity(c, n), LAT));
+                if (r < 0) {
+                    return;  // node not on a grid row: not a structured mesh, leave the locator empty
+                }
+                row_min = std::min(row_min, r);
+                row_max = std::max(row_max, r);
+            }
+            // Cells patching a pole only connect nodes of the first or last row
+            idx_t band = row_min;
+            if (row_min == row_max) {
+                if (row_min == 1) {
+                    band = 0;
+                }
+                else if (row_max == nb_bands - 1) {
+                    band = nb_bands - 1;
+                }
+                else {
+                    return;
+                }
+            }
+            else if (row_max != row_min + 1) {
+                return;
+            }
+
+            // westmost longitude of the cell, in [0,360)
+            const double lon_ref = lonlat(connectivity(c, 0), LON);
+            double west          = lon_ref;
+            for (idx_t n = 1; n < nb_nodes; ++n) {
+                double lon = lonlat(connectivity(c, n), LON);
+                while (lon - lon_ref > 180.) {
+                    lon -= 360.;
+                }
+                while (lon - lon_ref < -180.) {
+                    lon += 360.;
+                }
+                west = std::min(west, lon);
+            }
+            bands[band].emplace_back(normalise(west), c);
+        }
+
+        bands_.resize(nb_bands);
+        for (idx_t b = 0; b < nb_bands; ++b) {
+            std::sort(bands[b].begin(), bands[b].end());
+            bands_[b].west.reserve(bands[b].size());
+            bands_[b].cells.reserve(bands[b].size());
+            for (const auto& cell : bands[b]) {
+                bands_[b].west.emplace_back(cell.first);
+                bands_[b].cells.emplace_back(cell.second);
+            }
+            bands_[b].polar = (y_[b] == 90. || y_[b + 1] == -90.);
+        }
+    }
+
+    operator bool() const { return not bands_.empty(); }
+
+    /// Append candidate cells possibly containing (lon,lat) to cells
+    void operator()(double lon, double lat, std::vector<idx_t>& cells) const {
+        auto it    = std::upper_bound(y_.begin(), y_.end(), lat, std::greater<double>());
+        idx_t band = std::max<idx_t>(0, std::min<idx_t>(bands_.size() - 1, static_cast<idx_t>(it - y_.begin()) - 1));
+
+        const auto& b        = bands_[band];
+        const idx_t nb_cells = static_cast<idx_t>(b.cells.size());
+        if (nb_cells == 0) {
+            return;
+        }
+        if (b.polar || nb_cells <= 4) {
+            cells.insert(cells.end(), b.cells.begin(), b.cells.end());
+            return;
+        }
+        // last cell starting west of lon, and its neighbours, which may overlap in longitude
+        idx_t i = static_cast<idx_t>(std::upper_bound(b.west.begin(), b.west.end(), normalise(lon)) - b.west.begin()) - 1;
+        for (idx_t k = i - 2; k <= i + 1; ++k) {
+            cells.emplace_back(b.cells[(k + nb_cells) % nb_cells]);
+        }
+    }
+
+private:
+    static constexpr double tol() { return 1.e-9; }
+
+    static double normalise(double lon) { return lon - 360. * std::floor(lon / 360.); }
+
+    struct Band {
+        std::vector<double> west;
+        std::vector<idx_t> cells;
+        bool polar;
+    };
+    std::vector<double> y_;  // latitudes of grid rows and poles, from north to south
+    std::vector<Band> bands_;
+};
+
 }  // namespace
 
 
@@ -133,6 +269,7 @@ void FiniteElement::print(std::ostream& out) const {
     out << "atlas::interpolation::method::FiniteElement{" << std::endl;
     out << "max_fraction_elems_to_try: " << max_fraction_elems_to_try_;
     out << ", treat_failure_as_missing_value: " << treat_failure_as_missing_value_;
+    out << ", use_structured_locator: " << use_structured_locator_;
     if (not tgt) {
         out << "}" << std::endl;
         return;
@@ -140,7 +277,10 @@ void FiniteElement::print(std::ostream& out) const {
     out << ", NodeColumns to NodeColumns stencil weights: " << std::endl;
     auto gidx_src = array::make_view<gidx_t, 1>(src.nodes().global_index());
 
-    ATLAS_ASSERT(tgt.nodes().size() == idx_t(matrix().rows()));
+    // The full matrix may have been released after setup, and is then rebuilt from its compact copy
+    interpolation::MatrixCache matrix_cache(Method::createCache());
+    const Matrix& full_matrix = matrix_cache.matrix();
+    ATLAS_ASSERT(tgt.nodes().size() == idx_t(full_matrix.rows()));
 
 
     auto field_stencil_points_loc  = tgt.createField<gidx_t>(option::variables(Stencil::max_stencil_size));
@@ -152,7 +292,7 @@ void FiniteElement::print(std::ostream& out) const {
     auto stencil_size_loc    = array::make_view<idx_t, 1>(field_stencil_size_loc);
     stencil_size_loc.assign(0);
 
-    for (auto it = matrix().begin(); it != matrix().end(); ++it) {
+    for (auto it = full_matrix.begin(); it != full_matrix.end(); ++it) {
         idx_t p                   = idx_t(it.row());
         idx_t& i                  = stencil_size_loc(p);
         stencil_points_loc(p, i)  = gidx_src(it.col());
@@ -206,13 +346,21 @@ void FiniteElement::setup(const FunctionSpace& source) {
     // generate 3D point coordinates
     Field source_xyz = mesh::actions::BuildXYZField("xyz")(meshSource);
 
-    // generate barycenters of each triangle & insert them on a kd-tree
-    util::Config config;
-    config.set("name", "centre ");
-    config.set("flatten_virtual_elements", false);
-    Field cell_centres = mesh::actions::BuildCellCentres(config)(meshSource);
+    // cells of meshes generated from structured grids are located directly, others with a k-d tree
+    StructuredCellLocator locator = use_structured_locator_ ? StructuredCellLocator(meshSource) : StructuredCellLocator();
 
-    std::unique_ptr<ElemIndex3> eTree(create_element_kdtree(meshSource, cell_centres));
+    // generate barycenters of each triangle & insert them on a kd-tree
+    std::unique_ptr<ElemIndex3> eTree;
+    auto build_kdtree = [&]() {
+        util::Config config;
+        config.set("name", "centre ");
+        config.set("flatten_virtual_elements", false);
+        Field cell_centres = mesh::actions::BuildCellCentres(config)(meshSource);
+        eTree.reset(create_element_kdtree(meshSource, cell_centres));
+    };
+    if (not locator) {
+        build_kdtree();
+    }
 
     trace_setup_source.stop();
 
@@ -240,15 +388,9 @@ void FiniteElement::setup(const FunctionSpace& source) {
 
     idx_t Nelements = meshSource.cells().size();
 
-    // weights -- one per vertex of element, triangles (3) or quads (4)
-
-    Triplets weights_triplets;               // structure to fill-in sparse matrix
-    weights_triplets.reserve(out_npts * 4);  // preallocate space as if all elements where quads
-
     // search nearest k cell centres
 
     const idx_t maxNbElemsToTry = std::max<idx_t>(8, idx_t(Nelements * max_fraction_elems_to_try_));
-    idx_t max_neighbours        = 0;
 
     double search_radius = 0.;
     if (meshSource.metadata().has("cell_maximum_diagonal_on_unit_sphere")) {
@@ -257,59 +399,154 @@ void FiniteElement::setup(const FunctionSpace& source) {
         Log::debug() << "k-d tree: search radius = " << search_radius/1000. << " km" << std::endl;
     }
 
-    std::vector<size_t> failures;
+    struct Weights {
+        Triplets triplets;               // structure to fill-in sparse matrix
+        std::vector<size_t> failures;    // points that could not be projected
+        std::vector<size_t> unresolved;  // points not found with the structured locator
+        idx_t max_neighbours{0};
+    };
 
-    ATLAS_TRACE_SCOPE("Computing interpolation matrix") {
-        eckit::ProgressTimer progress("Computing interpolation weights", out_npts, "point", double(5), Log::debug());
-        for (idx_t ip = 0; ip < out_npts; ++ip, ++progress) {
-            if (out_ghosts(ip)) {
-                continue;
-            }
+    // Compute weights for the target points point(0:nb_points), which must be in ascending order.
+    // Points are processed in chunks, dynamically scheduled over threads. Each chunk collects its own
+    // weights (one per vertex of element, triangles (3) or quads (4)) and failures, which are concatenated in
+    // chunk order afterwards, so that the matrix does not depend on the number of threads.
+    auto compute_weights = [&](idx_t nb_points, auto&& point, bool use_locator) {
+        constexpr idx_t chunk_size = 1024;
+        const idx_t nb_chunks      = (nb_points + chunk_size - 1) / chunk_size;
+        std::vector<Weights> chunks(nb_chunks);
+        std::vector<std::string> chunks_failures_log(nb_chunks);
+
+        eckit::ProgressTimer progress("Computing interpolation weights", nb_chunks, "chunk", double(5), Log::debug());
+        atlas_omp_parallel_for (idx_t c = 0; c < nb_chunks; ++c) {
+            auto& chunk = chunks[c];
+            chunk.triplets.reserve(chunk_size * 4);  // preallocate space as if all elements where quads
+            std::ostringstream chunk_failures_log;
+            std::vector<idx_t> cells;
+            const idx_t k_end = std::min(nb_points, (c + 1) * chunk_size);
+            for (idx_t k = c * chunk_size; k < k_end; ++k) {
+                const idx_t ip = point(k);
+                if (out_ghosts(ip)) {
+                    continue;
+                }
+
+                bool success = false;
+                std::ostringstream failures_log;
+
+                if (use_locator) {
+                    cells.clear();
+                    locator(out_lonlat(ip, LON), out_lonlat(ip, LAT), cells);
+                    if (cells.size()) {
+                        Triplets triplets = projectPointToElements(ip, cells, failures_log);
+                        if (triplets.size()) {
+                            std::copy(triplets.begin(), triplets.end(), std::back_inserter(chunk.triplets));
+                            success = true;
+                        }
+                    }
+                    if (!success) {
+                        chunk.unresolved.push_back(ip);
+                    }
+                    continue;
+                }
 
-            PointXYZ p{(*ocoords_)(ip, 0), (*ocoords_)(ip, 1), (*ocoords_)(ip, 2)};  // lookup point
+                PointXYZ p{(*ocoords_)(ip, 0), (*ocoords_)(ip, 1), (*ocoords_)(ip, 2)};  // lookup point
 
-            idx_t kpts   = 1;
-            bool success = false;
-            std::ostringstream failures_log;
+                idx_t kpts = 1;
 
-            if (search_radius != 0.) {
-                ElemIndex3::NodeList cs = eTree->findInSphere(p,search_radius);
-                if (cs.size()) {
-                    Triplets triplets       = projectPointToElements(ip, cs, failures_log);
+                if (search_radius != 0.) {
+                    ElemIndex3::NodeList cs = eTree->findInSphere(p, search_radius);
+                    if (cs.size()) {
+                        Triplets triplets = projectPointToElements(ip, cs, failures_log);
 
-                    if (triplets.size()) {
-                        std::copy(triplets.begin(), triplets.end(), std::back_inserter(weights_triplets));
-                        success = true;
+                        if (triplets.size()) {
+                            std::copy(triplets.begin(), triplets.end(), std::back_inserter(chunk.triplets));
+                            success = true;
+                        }
                     }
                 }
-            }
-            else {
-                while (!success && kpts <= maxNbElemsToTry) {
-                    max_neighbours = std::max(kpts, max_neighbours);
-                    ElemIndex3::NodeList cs = eTree->kNearestNeighbours(p, kpts);
-                    Triplets triplets       = projectPointToElements(ip, cs, failures_log);
-
-                    if (triplets.size()) {
-                        std::copy(triplets.begin(), triplets.end(), std::back_inserter(weights_triplets));
-                        success = true;
+                else {
+                    while (!success && kpts <= maxNbElemsToTry) {
+                        chunk.max_neighbours    = std::max(kpts, chunk.max_neighbours);
+                        ElemIndex3::NodeList cs = eTree->kNearestNeighbours(p, kpts);
+                        Triplets triplets       = projectPointToElements(ip, cs, failures_log);
+
+                        if (triplets.size()) {
+                            std::copy(triplets.begin(), triplets.end(), std::back_inserter(chunk.triplets));
+                            success = true;
+                        }
+                        kpts *= 2;
                     }
-                    kpts *= 2;
                 }
-            }
 
-            if (!success) {
-                failures.push_back(ip);
-                if (not treat_failure_as_missing_value_) {
-                    Log::debug() << "------------------------------------------------------"
-                                    "---------------------\n";
-                    const PointLonLat pll{out_lonlat(ip, 0), out_lonlat(ip, 1)};
-                    Log::debug() << "Failed to project point (lon,lat)=" << pll << '\n';
-                    Log::debug() << failures_log.str();
+                if (!success) {
+                    chunk.failures.push_back(ip);
+                    if (not treat_failure_as_missing_value_) {
+                        chunk_failures_log << "------------------------------------------------------"
+                                              "---------------------\n";
+                        const PointLonLat pll{out_lonlat(ip, 0), out_lonlat(ip, 1)};
+                        chunk_failures_log << "Failed to project point (lon,lat)=" << pll << '\n';
+                        chunk_failures_log << failures_log.str();
+                    }
                 }
             }
+            chunks_failures_log[c] = chunk_failures_log.str();
+            atlas_omp_critical {
+                ++progress;
+            }
+        }
+
+        Weights weights;
+        size_t nb_triplets   = 0;
+        size_t nb_failures   = 0;
+        size_t nb_unresolved = 0;
+        for (const auto& chunk : chunks) {
+            nb_triplets += chunk.triplets.size();
+            nb_failures += chunk.failures.size();
+            nb_unresolved += chunk.unresolved.size();
+        }
+        weights.triplets.reserve(nb_triplets);
+        weights.failures.reserve(nb_failures);
+        weights.unresolved.reserve(nb_unresolved);
+        for (idx_t c = 0; c < nb_chunks; ++c) {
+            auto& chunk = chunks[c];
+            weights.triplets.insert(weights.triplets.end(), chunk.triplets.begin(), chunk.triplets.end());
+            weights.failures.insert(weights.failures.end(), chunk.failures.begin(), chunk.failures.end());
+            weights.unresolved.insert(weights.unresolved.end(), chunk.unresolved.begin(), chunk.unresolved.end());
+            weights.max_neighbours = std::max(weights.max_neighbours, chunk.max_neighbours);
+            Log::debug() << chunks_failures_log[c];
+            Triplets().swap(chunk.triplets);
+        }
+        return weights;
+    };
+
+    Weights weights;
+    ATLAS_TRACE_SCOPE("Computing interpolation matrix") {
+        weights = compute_weights(out_npts, [](idx_t ip) { return ip; }, bool(locator));
+
+        if (weights.unresolved.size()) {
+            // Points that were not located directly are searched for with the k-d tree
+            Log::debug() << "Searching " << eckit::Plural(weights.unresolved.size(), "point")
+                         << " not located in structured mesh with k-d tree" << std::endl;
+            ATLAS_TRACE_SCOPE("Build element k-d tree") {
+                build_kdtree();
+            }
+            const auto& unresolved = weights.unresolved;
+            Weights searched       = compute_weights(
+                unresolved.size(), [&](idx_t k) { return static_cast<idx_t>(unresolved[k]); }, false);
+
+            // Both lists of triplets are ordered by row (target point), and contain distinct rows
+            Triplets triplets;
+            triplets.reserve(weights.triplets.size() + searched.triplets.size());
+            std::merge(weights.triplets.begin(), weights.triplets.end(), searched.triplets.begin(),
+                       searched.triplets.end(), std::back_inserter(triplets),
+                       [](const Triplet& a, const Triplet& b) { return a.row() < b.row(); });
+            weights.triplets.swap(triplets);
+            weights.failures       = std::move(searched.failures);
+            weights.max_neighbours = searched.max_neighbours;
         }
     }
-    Log::debug() << "Maximum neighbours searched was " << eckit::Plural(max_neighbours, "element") << std::endl;
+    Log::debug() << "Maximum neighbours searched was " << eckit::Plural(weights.max_neighbours, "element") << std::endl;
+
+    const auto& failures = weights.failures;
 
     if (failures.size()) {
         if (treat_failure_as_missing_value_) {
@@ -331,7 +568,7 @@ void FiniteElement::setup(const FunctionSpace& source) {
     }
 
     // fill sparse matrix and return
-    Matrix A(out_npts, inp_npts, weights_triplets);
+    Matrix A(out_npts, inp_npts, weights.triplets);
     setMatrix(A);
 }
 
@@ -345,6 +582,16 @@ struct ElementEdge {
 };
 
 Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemIndex3::NodeList& elems,
+                                                       std::ostream& failures_log) const {
+    std::vector<idx_t> elem_ids;
+    elem_ids.reserve(elems.size());
+    for (const auto& elem : elems) {
+        elem_ids.emplace_back(idx_t(elem.value().payload()));
+    }
+    return projectPointToElements(ip, elem_ids, failures_log);
+}
+
+Method::Triplets FiniteElement::projectPointToElements(size_t ip, const std::vector<idx_t>& elems,
                                                        std::ostream& /* failures_log */) const {
     ATLAS_ASSERT(elems.begin() != elems.end());
 
@@ -358,8 +605,7 @@ Method::Triplets FiniteElement::projectPointToElements(size_t ip, const ElemInde
     const Vector3D p{(*ocoords_)(ip, size_t(0)), (*ocoords_)(ip, size_t(1)), (*ocoords_)(ip, size_t(2))};
     ElementEdge edge;
     idx_t single_point;
-    for (ElemIndex3::NodeList::const_iterator itc = elems.begin(); itc != elems.end(); ++itc) {
-        const idx_t elem_id = idx_t((*itc).value().payload());
+    for (const idx_t elem_id : elems) {
         ATLAS_ASSERT(elem_id < connectivity_->rows());
 
         const idx_t nb_cols = [&]() {
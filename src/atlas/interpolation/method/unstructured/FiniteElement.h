@@ -13,6 +13,7 @@
 #include "atlas/interpolation/method/Method.h"
 
 #include <string>
+#include <vector>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/memory/NonCopyable.h"
@@ -31,6 +32,7 @@ public:
     FiniteElement(const Config& config): Method(config) {
         config.get("max_fraction_elems_to_try", max_fraction_elems_to_try_);
         config.get("treat_failure_as_missing_value", treat_failure_as_missing_value_);
+        config.get("use_structured_locator", use_structured_locator_);
     }
 
     virtual ~FiniteElement() override {}
@@ -58,6 +60,7 @@ protected:
    * weights
    */
     Triplets projectPointToElements(size_t ip, const ElemIndex3::NodeList& elems, std::ostream& failures_log) const;
+    Triplets projectPointToElements(size_t ip, const std::vector<idx_t>& elems, std::ostream& failures_log) const;
 
     virtual const FunctionSpace& source() const override { return source_; }
     virtual const FunctionSpace& target() const override { return target_; }
@@ -83,6 +86,7 @@ protected:
 
     bool treat_failure_as_missing_value_{true};
     double max_fraction_elems_to_try_{0.2};
+    bool use_structured_locator_{true};  // locate cells of meshes from structured grids without k-d tree
 };
 
 }  // namespace method
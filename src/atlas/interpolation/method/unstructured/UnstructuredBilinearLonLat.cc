@@ -136,7 +136,10 @@ void UnstructuredBilinearLonLat::print(std::ostream& out) const {
     out << ", NodeColumns to NodeColumns stencil weights: " << std::endl;
     auto gidx_src = array::make_view<gidx_t, 1>(src.nodes().global_index());
 
-    ATLAS_ASSERT(tgt.nodes().size() == idx_t(matrix().rows()));
+    // The full matrix may have been released after setup, and is then rebuilt from its compact copy
+    interpolation::MatrixCache matrix_cache(Method::createCache());
+    const Matrix& full_matrix = matrix_cache.matrix();
+    ATLAS_ASSERT(tgt.nodes().size() == idx_t(full_matrix.rows()));
 
 
     auto field_stencil_points_loc  = tgt.createField<gidx_t>(option::variables(Stencil::max_stencil_size));
@@ -148,7 +151,7 @@ void UnstructuredBilinearLonLat::print(std::ostream& out) const {
     auto stencil_size_loc    = array::make_view<idx_t, 1>(field_stencil_size_loc);
     stencil_size_loc.assign(0);
 
-    for (auto it = matrix().begin(); it != matrix().end(); ++it) {
+    for (auto it = full_matrix.begin(); it != full_matrix.end(); ++it) {
         idx_t p                   = idx_t(it.row());
         idx_t& i                  = stencil_size_loc(p);
         stencil_points_loc(p, i)  = gidx_src(it.col());
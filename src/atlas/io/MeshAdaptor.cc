@@ -0,0 +1,299 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "MeshAdaptor.h"
+
+#include <sstream>
+#include <vector>
+
+#include "atlas/array/Array.h"
+#include "atlas/field/Field.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/io/ArrayAdaptor.h"
+#include "atlas/mesh/Connectivity.h"
+#include "atlas/mesh/ElementType.h"
+#include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/projection/Projection.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+
+namespace atlas {
+namespace io {
+
+namespace {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+constexpr int layout_version = 1;
+
+std::string field_key(const std::string& key, const Field& field) {
+    return key + ".field." + field.name();
+}
+
+std::string connectivity_key(const std::string& key, const std::string& name) {
+    return key + ".connectivity." + name;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+template <typename Container>
+std::vector<util::Config> encode_fields(const Container& container, RecordWriter& record, const std::string& key) {
+    std::vector<util::Config> fields;
+    fields.reserve(container.nb_fields());
+    for (idx_t f = 0; f < container.nb_fields(); ++f) {
+        const Field& field = container.field(f);
+        ATLAS_ASSERT(field.contiguous());
+        util::Config config;
+        config.set("name", field.name());
+        config.set("datatype", field.datatype().str());
+        config.set("shape", std::vector<idx_t>(field.shape().begin(), field.shape().end()));
+        config.set("metadata", field.metadata());
+        fields.emplace_back(config);
+        record.set(field_key(key, field), io::ref(field.array()));
+    }
+    return fields;
+}
+
+template <typename Container>
+void decode_fields(const std::vector<eckit::LocalConfiguration>& fields, Container& container, RecordReader& record,
+                   const std::string& key) {
+    for (const auto& config : fields) {
+        std::string name = config.getString("name");
+        std::vector<idx_t> shape;
+        config.get("shape", shape);
+        if (not container.has_field(name)) {
+            container.add(Field(name, array::DataType(config.getString("datatype")), array::ArrayShape(shape)));
+        }
+        Field field = container.field(name);
+        field.metadata().set(config.getSubConfiguration("metadata"));
+        record.read(field_key(key, field), field.array());
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void encode_connectivity(const mesh::IrregularConnectivity& connectivity, RecordWriter& record,
+                         const std::string& key) {
+    std::vector<idx_t> counts(connectivity.rows());
+    std::vector<idx_t> values;
+    values.reserve(connectivity.size());
+    for (idx_t r = 0; r < connectivity.rows(); ++r) {
+        counts[r] = connectivity.cols(r);
+        for (idx_t c = 0; c < counts[r]; ++c) {
+            values.emplace_back(connectivity(r, c));
+        }
+    }
+    record.set(connectivity_key(key, connectivity.name()) + ".counts", io::copy(std::move(counts)));
+    record.set(connectivity_key(key, connectivity.name()) + ".values", io::copy(std::move(values)));
+}
+
+void decode_connectivity(const std::vector<idx_t>& counts, const std::vector<idx_t>& values,
+                         mesh::IrregularConnectivity& connectivity) {
+    ATLAS_ASSERT(connectivity.rows() == 0);
+    connectivity.add(static_cast<idx_t>(counts.size()), counts.data());
+    size_t offset = 0;
+    for (idx_t r = 0; r < connectivity.rows(); ++r) {
+        connectivity.set(r, values.data() + offset);
+        offset += counts[r];
+    }
+    ATLAS_ASSERT(offset == values.size());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+util::Config encode_connectivity(const mesh::MultiBlockConnectivity& connectivity, RecordWriter& record,
+                                 const std::string& key) {
+    std::vector<util::Config> blocks;
+    std::vector<idx_t> values;
+    values.reserve(connectivity.size());
+    for (idx_t b = 0; b < connectivity.blocks(); ++b) {
+        const auto& block = connectivity.block(b);
+        blocks.emplace_back(util::Config("rows", block.rows())("cols", block.cols()));
+        for (idx_t r = 0; r < block.rows(); ++r) {
+            for (idx_t c = 0; c < block.cols(); ++c) {
+                values.emplace_back(block(r, c));
+            }
+        }
+    }
+    record.set(connectivity_key(key, connectivity.name()), io::copy(std::move(values)));
+    util::Config config;
+    config.set("blocks", blocks);
+    return config;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void encode_elements(const mesh::HybridElements& elements, RecordWriter& record, const std::string& key,
+                     util::Config& layout) {
+    std::vector<util::Config> types;
+    for (idx_t t = 0; t < elements.nb_types(); ++t) {
+        types.emplace_back(
+            util::Config("name", elements.element_type(t).name())("size", elements.elements(t).size()));
+    }
+    util::Config connectivities;
+    connectivities.set("node", encode_connectivity(elements.node_connectivity(), record, key));
+    connectivities.set("edge", encode_connectivity(elements.edge_connectivity(), record, key));
+    connectivities.set("cell", encode_connectivity(elements.cell_connectivity(), record, key));
+
+    layout.set("size", elements.size());
+    layout.set("types", types);
+    layout.set("connectivities", connectivities);
+    layout.set("metadata", elements.metadata());
+    layout.set("fields", encode_fields(elements, record, key));
+}
+
+struct DecodedElements {
+    std::vector<idx_t> node_connectivity;
+    std::vector<idx_t> edge_connectivity;
+    std::vector<idx_t> cell_connectivity;
+};
+
+void read_elements(RecordReader& record, const std::string& key, DecodedElements& decoded) {
+    record.read(connectivity_key(key, "node"), decoded.node_connectivity);
+    record.read(connectivity_key(key, "edge"), decoded.edge_connectivity);
+    record.read(connectivity_key(key, "cell"), decoded.cell_connectivity);
+}
+
+void add_blocks(const util::Config& layout, const std::vector<idx_t>& values, mesh::MultiBlockConnectivity& connectivity) {
+    size_t offset = 0;
+    for (const auto& block : layout.getSubConfigurations("blocks")) {
+        idx_t rows = block.getInt("rows");
+        idx_t cols = block.getInt("cols");
+        connectivity.add(rows, cols, values.data() + offset);
+        offset += rows * cols;
+    }
+    ATLAS_ASSERT(offset == values.size());
+}
+
+void create_elements(const util::Config& layout, const DecodedElements& decoded, mesh::HybridElements& elements) {
+    ATLAS_ASSERT(elements.size() == 0);
+    auto connectivities = layout.getSubConfiguration("connectivities");
+
+    // Element types define the blocks of the node connectivity
+    size_t offset = 0;
+    for (const auto& type : layout.getSubConfigurations("types")) {
+        auto* element_type = mesh::ElementType::create(type.getString("name"));
+        idx_t size         = type.getInt("size");
+        elements.add(element_type, size, decoded.node_connectivity.data() + offset);
+        offset += size * element_type->nb_nodes();
+    }
+    ATLAS_ASSERT(offset == decoded.node_connectivity.size());
+    ATLAS_ASSERT(elements.size() == layout.getInt("size"));
+
+    add_blocks(connectivities.getSubConfiguration("edge"), decoded.edge_connectivity, elements.edge_connectivity());
+    add_blocks(connectivities.getSubConfiguration("cell"), decoded.cell_connectivity, elements.cell_connectivity());
+    elements.metadata().set(layout.getSubConfiguration("metadata"));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void encode(const Mesh& mesh, RecordWriter& record, const std::string& key) {
+    ATLAS_TRACE("io::encode(Mesh)");
+    util::Config layout;
+    layout.set("version", layout_version);
+    layout.set("metadata", mesh.metadata());
+    if (mesh.projection()) {
+        layout.set("projection", mesh.projection().spec());
+    }
+    if (mesh.grid()) {
+        layout.set("grid", mesh.grid().spec());
+    }
+
+    {
+        const auto& nodes = mesh.nodes();
+        util::Config config;
+        config.set("size", nodes.size());
+        config.set("metadata", nodes.metadata());
+        config.set("fields", encode_fields(nodes, record, key + ".nodes"));
+        encode_connectivity(nodes.edge_connectivity(), record, key + ".nodes");
+        encode_connectivity(nodes.cell_connectivity(), record, key + ".nodes");
+        layout.set("nodes", config);
+    }
+    {
+        util::Config config;
+        encode_elements(mesh.cells(), record, key + ".cells", config);
+        layout.set("cells", config);
+    }
+    {
+        util::Config config;
+        encode_elements(mesh.edges(), record, key + ".edges", config);
+        layout.set("edges", config);
+    }
+
+    record.set(key + ".layout", layout.json(eckit::JSON::Formatting::compact()));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void decode(RecordReader& record, Mesh& mesh, const std::string& key) {
+    ATLAS_TRACE("io::decode(Mesh)");
+    ATLAS_ASSERT(not mesh.generated());
+
+    std::string json;
+    record.read(key + ".layout", json).wait();
+    std::istringstream json_stream(json);
+    util::Config layout(json_stream);
+    if (layout.getInt("version") != layout_version) {
+        throw_Exception("Cannot decode Mesh with layout version " + std::to_string(layout.getInt("version")), Here());
+    }
+
+    mesh.metadata().set(layout.getSubConfiguration("metadata"));
+    if (layout.has("projection")) {
+        mesh.setProjection(Projection(layout.getSubConfiguration("projection")));
+    }
+    if (layout.has("grid")) {
+        mesh.setGrid(Grid(util::Config(layout.getSubConfiguration("grid"))));
+    }
+
+    // Connectivity tables are needed to create the elements, before the element fields can be read
+    std::vector<idx_t> node_edge_counts, node_edge_values, node_cell_counts, node_cell_values;
+    DecodedElements cells, edges;
+    record.read(connectivity_key(key + ".nodes", "edge") + ".counts", node_edge_counts);
+    record.read(connectivity_key(key + ".nodes", "edge") + ".values", node_edge_values);
+    record.read(connectivity_key(key + ".nodes", "cell") + ".counts", node_cell_counts);
+    record.read(connectivity_key(key + ".nodes", "cell") + ".values", node_cell_values);
+    read_elements(record, key + ".cells", cells);
+    read_elements(record, key + ".edges", edges);
+    record.wait();
+
+    auto& nodes = mesh.nodes();
+    {
+        auto config = layout.getSubConfiguration("nodes");
+        nodes.resize(config.getInt("size"));
+        nodes.metadata().set(config.getSubConfiguration("metadata"));
+        decode_connectivity(node_edge_counts, node_edge_values, nodes.edge_connectivity());
+        decode_connectivity(node_cell_counts, node_cell_values, nodes.cell_connectivity());
+        decode_fields(config.getSubConfigurations("fields"), nodes, record, key + ".nodes");
+    }
+    {
+        auto config = layout.getSubConfiguration("cells");
+        create_elements(config, cells, mesh.cells());
+        decode_fields(config.getSubConfigurations("fields"), mesh.cells(), record, key + ".cells");
+    }
+    {
+        auto config = layout.getSubConfiguration("edges");
+        create_elements(config, edges, mesh.edges());
+        decode_fields(config.getSubConfigurations("fields"), mesh.edges(), record, key + ".edges");
+    }
+    record.wait();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,46 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "atlas-io.h"
+
+namespace atlas {
+class Mesh;
+}  // namespace atlas
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Add the local partition of a Mesh to a record
+///
+/// Nodes, cells and edges are written with all their fields, connectivity tables and metadata, so that
+/// the partition can be restored with decode() without regenerating the mesh or rebuilding halos, edges,
+/// dual mesh or parallel fields.
+/// All record items are prefixed with given key.
+///
+/// @note Fields are referenced, not copied: the mesh must outlive the call to RecordWriter::write()
+void encode(const Mesh&, RecordWriter&, const std::string& key);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Restore the local partition of a Mesh from a record written with encode(const Mesh&, RecordWriter&, ...)
+///
+/// The given mesh must be empty, e.g. default constructed.
+void decode(RecordReader&, Mesh&, const std::string& key);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
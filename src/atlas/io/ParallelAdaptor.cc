@@ -0,0 +1,169 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "ParallelAdaptor.h"
+
+#include <sstream>
+#include <vector>
+
+#include "atlas/parallel/GatherScatter.h"
+#include "atlas/parallel/HaloExchange.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace io {
+
+namespace {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+const mpi::Comm& decode_comm(RecordReader& record, const std::string& key) {
+    std::string mpi_comm;
+    int nproc;
+    int myproc;
+    record.read(key + ".mpi_comm", mpi_comm);
+    record.read(key + ".nproc", nproc);
+    record.read(key + ".myproc", myproc);
+    record.wait();
+
+    const auto& comm = mpi::comm(mpi_comm);
+    if (nproc != static_cast<int>(comm.size()) || myproc != static_cast<int>(comm.rank())) {
+        std::stringstream err;
+        err << "Cannot decode " << key << " written by rank " << myproc << " of " << nproc << " tasks on rank "
+            << comm.rank() << " of " << comm.size() << " tasks.";
+        throw_Exception(err.str(), Here());
+    }
+    return comm;
+}
+
+void encode_comm(const mpi::Comm& comm, RecordWriter& record, const std::string& key) {
+    record.set(key + ".mpi_comm", comm.name());
+    record.set(key + ".nproc", static_cast<int>(comm.size()));
+    record.set(key + ".myproc", static_cast<int>(comm.rank()));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void encode(const parallel::HaloExchange& h, RecordWriter& record, const std::string& key) {
+    ATLAS_ASSERT(h.is_setup_);
+    encode_comm(h.comm(), record, key);
+    record.set(key + ".parsize", h.parsize_);
+    record.set(key + ".sendcounts", h.sendcounts_);
+    record.set(key + ".senddispls", h.senddispls_);
+    record.set(key + ".recvcounts", h.recvcounts_);
+    record.set(key + ".recvdispls", h.recvdispls_);
+    record.set(key + ".sendmap", io::copy(std::vector<int>(h.sendmap_.data(), h.sendmap_.data() + h.sendmap_.size())));
+    record.set(key + ".recvmap", io::copy(std::vector<int>(h.recvmap_.data(), h.recvmap_.data() + h.recvmap_.size())));
+}
+
+void decode(RecordReader& record, parallel::HaloExchange& h, const std::string& key) {
+    h.comm_  = &decode_comm(record, key);
+    h.myproc = h.comm().rank();
+    h.nproc  = h.comm().size();
+
+    std::vector<int> sendmap;
+    std::vector<int> recvmap;
+    record.read(key + ".parsize", h.parsize_);
+    record.read(key + ".sendcounts", h.sendcounts_);
+    record.read(key + ".senddispls", h.senddispls_);
+    record.read(key + ".recvcounts", h.recvcounts_);
+    record.read(key + ".recvdispls", h.recvdispls_);
+    record.read(key + ".sendmap", sendmap);
+    record.read(key + ".recvmap", recvmap);
+    record.wait();
+
+    h.sendcnt_ = static_cast<int>(sendmap.size());
+    h.recvcnt_ = static_cast<int>(recvmap.size());
+    h.sendmap_.resize(h.sendcnt_);
+    h.recvmap_.resize(h.recvcnt_);
+    std::copy(sendmap.begin(), sendmap.end(), h.sendmap_.data());
+    std::copy(recvmap.begin(), recvmap.end(), h.recvmap_.data());
+
+    h.is_setup_        = true;
+    h.backdoor.parsize = h.parsize_;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+void encode(const parallel::GatherScatter& gs, RecordWriter& record, const std::string& key) {
+    ATLAS_ASSERT(gs.is_setup_);
+    encode_comm(gs.comm(), record, key);
+    record.set(key + ".parsize", static_cast<int>(gs.parsize_));
+    record.set(key + ".loccnt", gs.loccnt_);
+    record.set(key + ".glbcnt", gs.glbcnt_);
+    record.set(key + ".glbcounts", gs.glbcounts_);
+    record.set(key + ".glbdispls", gs.glbdispls_);
+    record.set(key + ".locmap", gs.locmap_);
+    record.set(key + ".glbmap", gs.glbmap_);
+    record.set(key + ".max_batch_bytes", static_cast<unsigned long>(gs.max_batch_bytes_));
+
+    // Writer slabs, set up with setup_writers()
+    record.set(key + ".nb_writers", static_cast<int>(gs.writers_.size()));
+    if (not gs.writers_.empty()) {
+        record.set(key + ".writers", gs.writers_);
+        record.set(key + ".writer", gs.writer_);
+        record.set(key + ".slab_displs", gs.slab_displs_);
+        record.set(key + ".slab_sendmap", gs.slab_sendmap_);
+        record.set(key + ".slab_sendcounts", gs.slab_sendcounts_);
+        record.set(key + ".slab_senddispls", gs.slab_senddispls_);
+        record.set(key + ".slab_recvmap", gs.slab_recvmap_);
+        record.set(key + ".slab_recvcounts", gs.slab_recvcounts_);
+        record.set(key + ".slab_recvdispls", gs.slab_recvdispls_);
+    }
+}
+
+void decode(RecordReader& record, parallel::GatherScatter& gs, const std::string& key) {
+    gs.comm_  = &decode_comm(record, key);
+    gs.myproc = gs.comm().rank();
+    gs.nproc  = gs.comm().size();
+
+    int parsize;
+    record.read(key + ".parsize", parsize);
+    record.read(key + ".loccnt", gs.loccnt_);
+    record.read(key + ".glbcnt", gs.glbcnt_);
+    record.read(key + ".glbcounts", gs.glbcounts_);
+    record.read(key + ".glbdispls", gs.glbdispls_);
+    record.read(key + ".locmap", gs.locmap_);
+    record.read(key + ".glbmap", gs.glbmap_);
+    unsigned long max_batch_bytes;
+    int nb_writers;
+    record.read(key + ".max_batch_bytes", max_batch_bytes);
+    record.read(key + ".nb_writers", nb_writers);
+    record.wait();
+
+    gs.writers_.clear();
+    gs.writer_ = -1;
+    if (nb_writers > 0) {
+        record.read(key + ".writers", gs.writers_);
+        record.read(key + ".writer", gs.writer_);
+        record.read(key + ".slab_displs", gs.slab_displs_);
+        record.read(key + ".slab_sendmap", gs.slab_sendmap_);
+        record.read(key + ".slab_sendcounts", gs.slab_sendcounts_);
+        record.read(key + ".slab_senddispls", gs.slab_senddispls_);
+        record.read(key + ".slab_recvmap", gs.slab_recvmap_);
+        record.read(key + ".slab_recvcounts", gs.slab_recvcounts_);
+        record.read(key + ".slab_recvdispls", gs.slab_recvdispls_);
+        record.wait();
+    }
+
+    gs.parsize_         = parsize;
+    gs.max_batch_bytes_ = max_batch_bytes;
+    gs.is_setup_        = true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -0,0 +1,50 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "atlas-io.h"
+
+namespace atlas {
+namespace parallel {
+class HaloExchange;
+class GatherScatter;
+}  // namespace parallel
+}  // namespace atlas
+
+namespace atlas {
+namespace io {
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Add the communication pattern computed by HaloExchange::setup() to a record
+void encode(const parallel::HaloExchange&, RecordWriter&, const std::string& key);
+
+/// @brief Restore a HaloExchange written with encode(), instead of calling HaloExchange::setup()
+///
+/// The record must have been written by the same MPI rank of a communicator with the same size.
+void decode(RecordReader&, parallel::HaloExchange&, const std::string& key);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+/// @brief Add the communication pattern computed by GatherScatter::setup() to a record
+void encode(const parallel::GatherScatter&, RecordWriter&, const std::string& key);
+
+/// @brief Restore a GatherScatter written with encode(), instead of calling GatherScatter::setup()
+///
+/// The record must have been written by the same MPI rank of a communicator with the same size.
+void decode(RecordReader&, parallel::GatherScatter&, const std::string& key);
+
+//---------------------------------------------------------------------------------------------------------------------
+
+}  // namespace io
+}  // namespace atlas
@@ -14,3 +14,9 @@
 
 #include "atlas/io/ArrayAdaptor.h"
 #include "atlas/io/VectorAdaptor.h"
+
+#include "atlas/library/defines.h"
+#if ATLAS_HAVE_FUNCTIONSPACE
+#include "atlas/io/MeshAdaptor.h"
+#include "atlas/io/ParallelAdaptor.h"
+#endif
@@ -10,7 +10,9 @@
 #pragma once
 
 #include "sparse/Backend.h"
+#include "sparse/CompactSparseMatrix.h"
 #include "sparse/SparseMatrixMultiply.h"
+#include "sparse/SparseMatrixTransposeMultiply.h"
 
 namespace atlas {
 namespace linalg {}  // namespace linalg
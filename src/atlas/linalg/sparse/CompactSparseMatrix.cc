@@ -0,0 +1,203 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/linalg/sparse/CompactSparseMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "eckit/linalg/Triplet.h"
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+
+template <typename Weight>
+bool CompactSparseMatrix<Weight>::fits(const eckit::linalg::SparseMatrix& W) {
+    constexpr size_t max = static_cast<size_t>(std::numeric_limits<Index>::max());
+    return W.rows() <= max && W.cols() <= max && W.nonZeros() <= max;
+}
+
+template <typename Weight>
+CompactSparseMatrix<Weight>::CompactSparseMatrix(const eckit::linalg::SparseMatrix& W):
+    rows_(W.rows()), cols_(W.cols()), outer_(W.rows() + 1), inner_(W.nonZeros()), data_(W.nonZeros()) {
+    ATLAS_ASSERT(fits(W), "Sparse matrix too large to be stored with 32-bit indices");
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    const idx_t rows  = static_cast<idx_t>(rows_);
+
+    outer_[0] = static_cast<Index>(outer[0]);
+    double weight_error  = 0.;
+    double row_sum_error = 0.;
+    atlas_omp_parallel {
+        // Maxima of this thread, merged once after the loop
+        double thread_weight_error  = 0.;
+        double thread_row_sum_error = 0.;
+        atlas_omp_for(idx_t r = 0; r < rows; ++r) {
+            outer_[r + 1]       = static_cast<Index>(outer[r + 1]);
+            double row_sum      = 0.;
+            double row_sum_conv = 0.;
+            for (auto c = outer[r]; c < outer[r + 1]; ++c) {
+                inner_[c]           = static_cast<Index>(index[c]);
+                data_[c]            = static_cast<Scalar>(weight[c]);
+                thread_weight_error = std::max(thread_weight_error, std::abs(double(data_[c]) - weight[c]));
+                row_sum += weight[c];
+                row_sum_conv += data_[c];
+            }
+            thread_row_sum_error = std::max(thread_row_sum_error, std::abs(row_sum_conv - row_sum));
+        }
+        atlas_omp_critical {
+            weight_error  = std::max(weight_error, thread_weight_error);
+            row_sum_error = std::max(row_sum_error, thread_row_sum_error);
+        }
+    }
+    weight_error_  = weight_error;
+    row_sum_error_ = row_sum_error;
+}
+
+template <typename Weight>
+size_t CompactSparseMatrix<Weight>::footprint() const {
+    return sizeof(*this) + outer_.capacity() * sizeof(Index) + inner_.capacity() * sizeof(Index) +
+           data_.capacity() * sizeof(Scalar);
+}
+
+template <typename Weight>
+eckit::linalg::SparseMatrix CompactSparseMatrix<Weight>::to_sparse_matrix() const {
+    std::vector<eckit::linalg::Triplet> triplets;
+    triplets.reserve(nonZeros());
+    for (size_t r = 0; r < rows_; ++r) {
+        for (Index c = outer_[r]; c < outer_[r + 1]; ++c) {
+            triplets.emplace_back(r, inner_[c], data_[c]);
+        }
+    }
+    return eckit::linalg::SparseMatrix(rows_, cols_, triplets);
+}
+
+namespace sparse {
+
+template <Indexing indexing, int Rank, typename Weight, typename SourceValue, typename TargetValue>
+void CompactSparseMatrixMultiply<indexing, Rank, Weight, SourceValue, TargetValue>::apply(
+    const CompactSparseMatrix<Weight>& W, const View<SourceValue, Rank>& src, View<TargetValue, Rank>& tgt) {
+    using Value             = TargetValue;
+    constexpr bool left     = (indexing == Indexing::layout_left);
+    constexpr int point_dim = left ? 0 : Rank - 1;
+    const auto outer        = W.outer();
+    const auto index        = W.inner();
+    const auto weight       = W.data();
+    const idx_t rows        = static_cast<idx_t>(W.rows());
+
+    ATLAS_ASSERT(src.shape(point_dim) >= W.cols());
+    ATLAS_ASSERT(tgt.shape(point_dim) >= W.rows());
+
+    if constexpr (Rank == 1) {
+        atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+            Value sum = 0.;
+            for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                sum += static_cast<Value>(weight[c]) * src[index[c]];
+            }
+            tgt[r] = sum;
+        }
+    }
+    else if constexpr (Rank == 2) {
+        const idx_t Nk = src.shape(left ? 1 : 0);
+        atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+            for (idx_t k = 0; k < Nk; ++k) {
+                if constexpr (left) {
+                    tgt(r, k) = 0.;
+                }
+                else {
+                    tgt(k, r) = 0.;
+                }
+            }
+            for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                const idx_t n = index[c];
+                const Value w = static_cast<Value>(weight[c]);
+                for (idx_t k = 0; k < Nk; ++k) {
+                    if constexpr (left) {
+                        tgt(r, k) += w * src(n, k);
+                    }
+                    else {
+                        tgt(k, r) += w * src(k, n);
+                    }
+                }
+            }
+        }
+    }
+    else if constexpr (Rank == 3) {
+        if (src.contiguous() && tgt.contiguous()) {
+            // We can take a more optimized route by reducing rank
+            auto shape = [](const auto& v) {
+                return left ? array::make_shape(v.shape(0), v.shape(1) * v.shape(2))
+                            : array::make_shape(v.shape(0) * v.shape(1), v.shape(2));
+            };
+            auto src_v = View<SourceValue, 2>(src.data(), shape(src));
+            auto tgt_v = View<TargetValue, 2>(tgt.data(), shape(tgt));
+            CompactSparseMatrixMultiply<indexing, 2, Weight, SourceValue, TargetValue>::apply(W, src_v, tgt_v);
+            return;
+        }
+        const idx_t Nk = src.shape(1);
+        const idx_t Nl = src.shape(left ? 2 : 0);
+        atlas_omp_parallel_for(idx_t r = 0; r < rows; ++r) {
+            for (idx_t k = 0; k < Nk; ++k) {
+                for (idx_t l = 0; l < Nl; ++l) {
+                    if constexpr (left) {
+                        tgt(r, k, l) = 0.;
+                    }
+                    else {
+                        tgt(l, k, r) = 0.;
+                    }
+                }
+            }
+            for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                const idx_t n = index[c];
+                const Value w = static_cast<Value>(weight[c]);
+                for (idx_t k = 0; k < Nk; ++k) {
+                    for (idx_t l = 0; l < Nl; ++l) {
+                        if constexpr (left) {
+                            tgt(r, k, l) += w * src(n, k, l);
+                        }
+                        else {
+                            tgt(l, k, r) += w * src(l, k, n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION(WEIGHT, TYPE)                                                 \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_left, 1, WEIGHT, TYPE const, TYPE>;  \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_left, 2, WEIGHT, TYPE const, TYPE>;  \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_left, 3, WEIGHT, TYPE const, TYPE>;  \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_right, 1, WEIGHT, TYPE const, TYPE>; \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_right, 2, WEIGHT, TYPE const, TYPE>; \
+    template struct CompactSparseMatrixMultiply<Indexing::layout_right, 3, WEIGHT, TYPE const, TYPE>;
+
+EXPLICIT_TEMPLATE_INSTANTIATION(double, double);
+EXPLICIT_TEMPLATE_INSTANTIATION(double, float);
+EXPLICIT_TEMPLATE_INSTANTIATION(float, double);
+EXPLICIT_TEMPLATE_INSTANTIATION(float, float);
+
+}  // namespace sparse
+
+template class CompactSparseMatrix<double>;
+template class CompactSparseMatrix<float>;
+
+}  // namespace linalg
+}  // namespace atlas
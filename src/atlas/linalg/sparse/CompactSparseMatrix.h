@@ -0,0 +1,136 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/linalg/SparseMatrix.h"
+
+#include "atlas/linalg/Indexing.h"
+#include "atlas/linalg/Introspection.h"
+#include "atlas/linalg/View.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+
+/// @brief Read-only CSR matrix with 32-bit row pointers and column indices, and weights of type Weight
+///
+/// A copy of an eckit::linalg::SparseMatrix which needs 8 (Weight = float) or 12 (Weight = double) bytes
+/// per nonzero instead of 16, reducing the memory traffic of the bandwidth-bound sparse matrix multiply.
+/// The matrix can only be converted if its number of columns and nonzeros fit in a 32-bit index, see fits().
+template <typename Weight>
+class CompactSparseMatrix {
+public:
+    using Index  = std::int32_t;
+    using Scalar = Weight;
+
+    /// @brief True if the matrix can be stored with 32-bit indices
+    static bool fits(const eckit::linalg::SparseMatrix&);
+
+    CompactSparseMatrix() = default;
+
+    explicit CompactSparseMatrix(const eckit::linalg::SparseMatrix&);
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nonZeros() const { return data_.size(); }
+    bool empty() const { return nonZeros() == 0; }
+
+    const Index* outer() const { return outer_.data(); }
+    const Index* inner() const { return inner_.data(); }
+    const Scalar* data() const { return data_.data(); }
+
+    /// @brief Memory in bytes taken by the matrix
+    size_t footprint() const;
+
+    /// @brief Copy with the default storage, holding the converted weights
+    eckit::linalg::SparseMatrix to_sparse_matrix() const;
+
+    /// @brief Largest absolute difference between a converted weight and the original one
+    double weight_error() const { return weight_error_; }
+
+    /// @brief Largest absolute difference between a row sum of converted weights and the original one
+    double row_sum_error() const { return row_sum_error_; }
+
+private:
+    size_t rows_{0};
+    size_t cols_{0};
+    std::vector<Index> outer_;
+    std::vector<Index> inner_;
+    std::vector<Scalar> data_;
+    double weight_error_{0.};
+    double row_sum_error_{0.};
+};
+
+/// @brief Sparse matrix multiply tgt = matrix * src with a compact matrix
+///
+/// Always uses the OpenMP kernels. Weights are converted to the precision of the fields before multiplication,
+/// so that double precision fields still accumulate in double precision when Weight = float.
+template <typename Weight, typename SourceView, typename TargetView>
+void sparse_matrix_multiply(const CompactSparseMatrix<Weight>& matrix, const SourceView& src, TargetView& tgt);
+
+template <typename Weight, typename SourceView, typename TargetView>
+void sparse_matrix_multiply(const CompactSparseMatrix<Weight>& matrix, const SourceView& src, TargetView& tgt,
+                            Indexing);
+
+namespace sparse {
+
+template <Indexing, int Rank, typename Weight, typename SourceValue, typename TargetValue>
+struct CompactSparseMatrixMultiply {
+    static void apply(const CompactSparseMatrix<Weight>&, const View<SourceValue, Rank>&, View<TargetValue, Rank>&);
+};
+
+namespace {
+template <Indexing indexing, typename Weight, typename SourceView, typename TargetView>
+void dispatch_compact_sparse_matrix_multiply(const CompactSparseMatrix<Weight>& W, const SourceView& src,
+                                             TargetView& tgt) {
+    using SourceValue      = const typename std::remove_const<typename SourceView::value_type>::type;
+    using TargetValue      = typename std::remove_const<typename TargetView::value_type>::type;
+    constexpr int src_rank = introspection::rank<SourceView>();
+    constexpr int tgt_rank = introspection::rank<TargetView>();
+    static_assert(src_rank == tgt_rank, "src and tgt need same rank");
+    CompactSparseMatrixMultiply<indexing, src_rank, Weight, SourceValue, TargetValue>::apply(W, src, tgt);
+}
+}  // namespace
+
+}  // namespace sparse
+
+template <typename Weight, typename SourceView, typename TargetView>
+void sparse_matrix_multiply(const CompactSparseMatrix<Weight>& matrix, const SourceView& src, TargetView& tgt,
+                            Indexing indexing) {
+    auto src_v = make_view(src);
+    auto tgt_v = make_view(tgt);
+    if (introspection::layout_right(src) || introspection::layout_right(tgt)) {
+        ATLAS_ASSERT(introspection::layout_right(src) && introspection::layout_right(tgt));
+        sparse::dispatch_compact_sparse_matrix_multiply<Indexing::layout_right>(matrix, src_v, tgt_v);
+    }
+    else if (indexing == Indexing::layout_left) {
+        sparse::dispatch_compact_sparse_matrix_multiply<Indexing::layout_left>(matrix, src_v, tgt_v);
+    }
+    else if (indexing == Indexing::layout_right) {
+        sparse::dispatch_compact_sparse_matrix_multiply<Indexing::layout_right>(matrix, src_v, tgt_v);
+    }
+    else {
+        throw_NotImplemented("indexing not implemented", Here());
+    }
+}
+
+template <typename Weight, typename SourceView, typename TargetView>
+void sparse_matrix_multiply(const CompactSparseMatrix<Weight>& matrix, const SourceView& src, TargetView& tgt) {
+    sparse_matrix_multiply(matrix, src, tgt, Indexing::layout_left);
+}
+
+}  // namespace linalg
+}  // namespace atlas
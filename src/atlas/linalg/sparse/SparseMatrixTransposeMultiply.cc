@@ -0,0 +1,273 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/linalg/sparse/SparseMatrixTransposeMultiply.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+namespace sparse {
+
+using SparseMatrix = eckit::linalg::SparseMatrix;
+
+TransposeMultiplyPlan::TransposeMultiplyPlan(const SparseMatrix& W, size_t max_buffer_values):
+    outer_(W.outer()),
+    inner_(W.inner()),
+    rows_(W.rows()),
+    cols_(W.cols()),
+    nonzeros_(W.nonZeros()),
+    max_buffer_values_(max_buffer_values) {
+    // The block size is fixed so that the colouring, and hence the order of accumulation, is independent of threads
+    const idx_t block_size = TransposeMultiplyPlan::block_size();
+    const auto outer       = W.outer();
+    const auto index       = W.inner();
+    const idx_t rows       = static_cast<idx_t>(W.rows());
+    const idx_t nb_blocks  = (rows + block_size - 1) / block_size;
+
+    // Range of columns updated by each block, empty blocks have last < first
+    std::vector<std::pair<idx_t, idx_t>> range(nb_blocks);
+    atlas_omp_parallel_for(idx_t b = 0; b < nb_blocks; ++b) {
+        idx_t first = std::numeric_limits<idx_t>::max();
+        idx_t last  = -1;
+        for (idx_t c = outer[b * block_size]; c < outer[std::min(rows, (b + 1) * block_size)]; ++c) {
+            first = std::min<idx_t>(first, index[c]);
+            last  = std::max<idx_t>(last, index[c]);
+        }
+        range[b] = {first, last};
+    }
+
+    // Greedy colouring of the column intervals in order of their start, reusing the colour which ended first
+    std::vector<idx_t> order(nb_blocks);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](idx_t a, idx_t b) { return range[a].first < range[b].first; });
+
+    using Available = std::pair<idx_t, idx_t>;  // (last column, colour)
+    std::priority_queue<Available, std::vector<Available>, std::greater<Available>> available;
+    std::vector<idx_t> colour(nb_blocks, 0);
+    idx_t nb_colours = 0;
+    for (idx_t b : order) {
+        if (range[b].second < range[b].first) {
+            continue;  // empty block, colour 0
+        }
+        if (not available.empty() && available.top().first < range[b].first) {
+            colour[b] = available.top().second;
+            available.pop();
+        }
+        else {
+            colour[b] = nb_colours++;
+        }
+        available.emplace(range[b].second, colour[b]);
+    }
+    colours_ = std::max<idx_t>(nb_colours, nb_blocks ? 1 : 0);
+
+    if (colours_ > max_colours()) {
+        // Too few blocks per colour to keep the threads busy, use private accumulation instead
+        return;
+    }
+
+    offsets_.assign(colours_ + 1, 0);
+    for (idx_t b = 0; b < nb_blocks; ++b) {
+        ++offsets_[colour[b] + 1];
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    blocks_.resize(nb_blocks);
+    std::vector<idx_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (idx_t b = 0; b < nb_blocks; ++b) {
+        blocks_[next[colour[b]]++] = b;
+    }
+}
+
+bool TransposeMultiplyPlan::valid_for(const SparseMatrix& W) const {
+    return outer_ == static_cast<const void*>(W.outer()) && inner_ == static_cast<const void*>(W.inner()) &&
+           rows_ == W.rows() && cols_ == W.cols() && nonzeros_ == W.nonZeros();
+}
+
+namespace {
+
+/// Accumulate tgt(n, j) += W(r, n) * src(r, j) for j in [0, nb_values), for every nonzero of W
+///
+/// Coloured row blocks update target points directly, concurrently only for blocks updating disjoint columns.
+/// Otherwise contiguous ranges of rows are accumulated into private buffers of the plan, one per thread as far
+/// as they fit in plan.max_buffer_values(), and the buffers are summed into the target in the order of the rows.
+template <typename Value, typename Source, typename Target>
+void transpose_multiply_add(const SparseMatrix& W, const TransposeMultiplyPlan& plan, idx_t nb_values,
+                            const Source& src, const Target& tgt) {
+    const auto outer  = W.outer();
+    const auto index  = W.inner();
+    const auto weight = W.data();
+    const idx_t rows  = static_cast<idx_t>(W.rows());
+    const idx_t cols  = static_cast<idx_t>(W.cols());
+
+    if (plan.coloured()) {
+        const idx_t block_size = TransposeMultiplyPlan::block_size();
+        const auto& blocks     = plan.blocks();
+        const auto& offsets    = plan.offsets();
+        for (idx_t colour = 0; colour < plan.colours(); ++colour) {
+            atlas_omp_parallel_for(idx_t i = offsets[colour]; i < offsets[colour + 1]; ++i) {
+                const idx_t b = blocks[i];
+                for (idx_t r = b * block_size; r < std::min(rows, (b + 1) * block_size); ++r) {
+                    for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                        const idx_t n = index[c];
+                        const Value w = static_cast<Value>(weight[c]);
+                        for (idx_t j = 0; j < nb_values; ++j) {
+                            tgt(n, j) += w * src(r, j);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Number of row ranges accumulated into private buffers, each holding at least one value per column
+    const size_t max_buffer_values = plan.max_buffer_values();
+    const idx_t parts              = static_cast<idx_t>(std::min<size_t>(
+        atlas_omp_get_max_threads(), max_buffer_values / std::max<size_t>(1, size_t(cols))));
+
+    if (parts < 2) {
+        for (idx_t r = 0; r < rows; ++r) {
+            for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                const idx_t n = index[c];
+                const Value w = static_cast<Value>(weight[c]);
+                for (idx_t j = 0; j < nb_values; ++j) {
+                    tgt(n, j) += w * src(r, j);
+                }
+            }
+        }
+        return;
+    }
+
+    // Number of values per point accumulated in one pass
+    const idx_t tile = static_cast<idx_t>(
+        std::min<size_t>(nb_values, max_buffer_values / (size_t(parts) * size_t(cols))));
+
+    std::lock_guard<std::mutex> lock(plan.buffer_mutex());
+    auto& buffer = plan.buffer<Value>();
+    if (buffer.size() < size_t(parts) * size_t(cols) * size_t(tile)) {
+        buffer.resize(size_t(parts) * size_t(cols) * size_t(tile));
+    }
+
+    for (idx_t j_begin = 0; j_begin < nb_values; j_begin += tile) {
+        // Buffers of consecutive parts are packed with the number of values of this pass
+        const idx_t nj   = std::min(tile, nb_values - j_begin);
+        auto private_tgt = [&](idx_t part) { return buffer.data() + size_t(part) * size_t(cols) * size_t(nj); };
+
+        atlas_omp_parallel_for(idx_t part = 0; part < parts; ++part) {
+            Value* t_part = private_tgt(part);
+            std::fill(t_part, t_part + size_t(cols) * size_t(nj), Value(0));
+
+            const idx_t r_begin = static_cast<idx_t>((size_t(rows) * size_t(part)) / size_t(parts));
+            const idx_t r_end   = static_cast<idx_t>((size_t(rows) * size_t(part + 1)) / size_t(parts));
+            for (idx_t r = r_begin; r < r_end; ++r) {
+                for (idx_t c = outer[r]; c < outer[r + 1]; ++c) {
+                    Value* t      = t_part + size_t(index[c]) * size_t(nj);
+                    const Value w = static_cast<Value>(weight[c]);
+                    for (idx_t j = 0; j < nj; ++j) {
+                        t[j] += w * src(r, j_begin + j);
+                    }
+                }
+            }
+        }
+
+        atlas_omp_parallel_for(idx_t n = 0; n < cols; ++n) {
+            for (idx_t part = 0; part < parts; ++part) {
+                const Value* t = private_tgt(part) + size_t(n) * size_t(nj);
+                for (idx_t j = 0; j < nj; ++j) {
+                    tgt(n, j_begin + j) += t[j];
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+template <Indexing indexing, int Rank, typename SourceValue, typename TargetValue>
+void SparseMatrixTransposeMultiplyAdd<indexing, Rank, SourceValue, TargetValue>::apply(
+    const SparseMatrix& W, const TransposeMultiplyPlan& plan, const View<SourceValue, Rank>& src,
+    View<TargetValue, Rank>& tgt) {
+    using Value             = TargetValue;
+    constexpr bool left     = (indexing == Indexing::layout_left);
+    constexpr int point_dim = left ? 0 : Rank - 1;
+    ATLAS_ASSERT(src.shape(point_dim) >= W.rows());
+    ATLAS_ASSERT(tgt.shape(point_dim) >= W.cols());
+
+    if constexpr (Rank == 1) {
+        transpose_multiply_add<Value>(
+            W, plan, 1, [&](idx_t r, idx_t) { return src[r]; }, [&](idx_t n, idx_t) -> Value& { return tgt[n]; });
+    }
+    else if constexpr (Rank == 2) {
+        const idx_t Nk = src.shape(left ? 1 : 0);
+        if constexpr (left) {
+            transpose_multiply_add<Value>(
+                W, plan, Nk, [&](idx_t r, idx_t k) { return src(r, k); },
+                [&](idx_t n, idx_t k) -> Value& { return tgt(n, k); });
+        }
+        else {
+            transpose_multiply_add<Value>(
+                W, plan, Nk, [&](idx_t r, idx_t k) { return src(k, r); },
+                [&](idx_t n, idx_t k) -> Value& { return tgt(k, n); });
+        }
+    }
+    else if constexpr (Rank == 3) {
+        if (src.contiguous() && tgt.contiguous()) {
+            // We can take a more optimized route by reducing rank
+            auto shape = [](const auto& v) {
+                return left ? array::make_shape(v.shape(0), v.shape(1) * v.shape(2))
+                            : array::make_shape(v.shape(0) * v.shape(1), v.shape(2));
+            };
+            auto src_v = View<SourceValue, 2>(src.data(), shape(src));
+            auto tgt_v = View<TargetValue, 2>(tgt.data(), shape(tgt));
+            SparseMatrixTransposeMultiplyAdd<indexing, 2, SourceValue, TargetValue>::apply(W, plan, src_v, tgt_v);
+            return;
+        }
+        const idx_t Nk = src.shape(1);
+        const idx_t Nl = src.shape(left ? 2 : 0);
+        if constexpr (left) {
+            transpose_multiply_add<Value>(
+                W, plan, Nk * Nl, [&](idx_t r, idx_t j) { return src(r, j / Nl, j % Nl); },
+                [&](idx_t n, idx_t j) -> Value& { return tgt(n, j / Nl, j % Nl); });
+        }
+        else {
+            transpose_multiply_add<Value>(
+                W, plan, Nk * Nl, [&](idx_t r, idx_t j) { return src(j % Nl, j / Nl, r); },
+                [&](idx_t n, idx_t j) -> Value& { return tgt(j % Nl, j / Nl, n); });
+        }
+    }
+    else {
+        ATLAS_NOTIMPLEMENTED;
+    }
+}
+
+#define EXPLICIT_TEMPLATE_INSTANTIATION(TYPE)                                                      \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_left, 1, TYPE const, TYPE>;  \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_left, 2, TYPE const, TYPE>;  \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_left, 3, TYPE const, TYPE>;  \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_right, 1, TYPE const, TYPE>; \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_right, 2, TYPE const, TYPE>; \
+    template struct SparseMatrixTransposeMultiplyAdd<Indexing::layout_right, 3, TYPE const, TYPE>;
+
+EXPLICIT_TEMPLATE_INSTANTIATION(double);
+EXPLICIT_TEMPLATE_INSTANTIATION(float);
+
+}  // namespace sparse
+}  // namespace linalg
+}  // namespace atlas
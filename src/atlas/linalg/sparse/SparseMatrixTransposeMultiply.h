@@ -0,0 +1,172 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/linalg/SparseMatrix.h"
+
+#include "atlas/linalg/Indexing.h"
+#include "atlas/linalg/Introspection.h"
+#include "atlas/linalg/View.h"
+#include "atlas/library/config.h"
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace linalg {
+
+namespace sparse {
+
+/// @brief Schedule of the rows of a matrix for sparse_matrix_transpose_multiply_add
+///
+/// Rows are grouped in fixed-size blocks, coloured such that blocks of equal colour update disjoint ranges of
+/// target points. When the rows of the matrix touch scattered columns, the column ranges of all blocks overlap
+/// and nearly every block gets its own colour. Beyond max_colours() the colouring is therefore not used, and
+/// contiguous ranges of rows are instead accumulated into private buffers, followed by a reduction.
+/// The private buffers hold at most max_buffer_values() values in total, and are kept with the plan for reuse.
+/// Fields with more values per point are accumulated in several passes. With a single thread, or when fewer
+/// than two buffers of one value per column fit, the rows are accumulated serially without buffer.
+///
+/// Computing the schedule costs a pass over the matrix, so it should be kept with the matrix when the transpose
+/// is applied repeatedly. It is only valid for the matrix it was created from.
+class TransposeMultiplyPlan {
+public:
+    explicit TransposeMultiplyPlan(const eckit::linalg::SparseMatrix&,
+                                   size_t max_buffer_values = default_max_buffer_values());
+
+    /// True if rows are processed by colour, and false if accumulated in private buffers per thread
+    bool coloured() const { return not offsets_.empty(); }
+
+    /// Number of colours of the row blocks
+    idx_t colours() const { return colours_; }
+
+    /// Number of colours above which private accumulation is used instead
+    static constexpr idx_t max_colours() { return 8; }
+
+    /// Number of rows per block
+    static constexpr idx_t block_size() { return 256; }
+
+    /// Upper bound on the number of values in the private buffers, unless given to the constructor
+    static constexpr size_t default_max_buffer_values() { return size_t(1) << 27; }
+
+    /// Upper bound on the number of values in the private buffers
+    size_t max_buffer_values() const { return max_buffer_values_; }
+
+    /// Blocks of colour c are blocks()[offsets()[c]] ... blocks()[offsets()[c+1]-1]
+    const std::vector<idx_t>& blocks() const { return blocks_; }
+    const std::vector<idx_t>& offsets() const { return offsets_; }
+
+    /// True if the plan was created from given matrix
+    bool valid_for(const eckit::linalg::SparseMatrix&) const;
+
+    /// Private buffers, reused between calls; buffer_mutex() serialises calls which use them
+    template <typename Value>
+    std::vector<Value>& buffer() const;
+    std::mutex& buffer_mutex() const { return buffer_mutex_; }
+
+private:
+    const void* outer_{nullptr};
+    const void* inner_{nullptr};
+    size_t rows_{0};
+    size_t cols_{0};
+    size_t nonzeros_{0};
+    idx_t colours_{0};
+    std::vector<idx_t> blocks_;
+    std::vector<idx_t> offsets_;
+    size_t max_buffer_values_;
+    mutable std::vector<double> buffer_double_;
+    mutable std::vector<float> buffer_float_;
+    mutable std::mutex buffer_mutex_;
+};
+
+template <>
+inline std::vector<double>& TransposeMultiplyPlan::buffer<double>() const {
+    return buffer_double_;
+}
+
+template <>
+inline std::vector<float>& TransposeMultiplyPlan::buffer<float>() const {
+    return buffer_float_;
+}
+
+}  // namespace sparse
+
+/// @brief Adjoint of sparse_matrix_multiply, accumulating tgt += matrix^T * src
+///
+/// The transpose is applied directly from the CSR storage of the forward matrix, so that no transposed copy
+/// needs to be kept: source points correspond to matrix rows, and target points to matrix columns.
+/// Rows are scheduled as described by sparse::TransposeMultiplyPlan, which is computed on every call unless
+/// passed in. With coloured row blocks the result does not depend on the number of threads; with private
+/// accumulation it is reproducible for a given number of threads and given plan.
+template <typename Matrix, typename SourceView, typename TargetView>
+void sparse_matrix_transpose_multiply_add(const Matrix& matrix, const SourceView& src, TargetView& tgt,
+                                          Indexing = Indexing::layout_left);
+
+/// @brief Adjoint of sparse_matrix_multiply, accumulating tgt += matrix^T * src, with a plan kept for the matrix
+template <typename Matrix, typename SourceView, typename TargetView>
+void sparse_matrix_transpose_multiply_add(const Matrix& matrix, const SourceView& src, TargetView& tgt,
+                                          const sparse::TransposeMultiplyPlan&, Indexing = Indexing::layout_left);
+
+namespace sparse {
+
+template <Indexing, int Rank, typename SourceValue, typename TargetValue>
+struct SparseMatrixTransposeMultiplyAdd {
+    static void apply(const eckit::linalg::SparseMatrix&, const TransposeMultiplyPlan&,
+                      const View<SourceValue, Rank>&, View<TargetValue, Rank>&);
+};
+
+namespace {
+template <Indexing indexing, typename SourceView, typename TargetView>
+void dispatch_sparse_matrix_transpose_multiply_add(const eckit::linalg::SparseMatrix& W,
+                                                   const TransposeMultiplyPlan& plan, const SourceView& src,
+                                                   TargetView& tgt) {
+    using SourceValue      = const typename std::remove_const<typename SourceView::value_type>::type;
+    using TargetValue      = typename std::remove_const<typename TargetView::value_type>::type;
+    constexpr int src_rank = introspection::rank<SourceView>();
+    constexpr int tgt_rank = introspection::rank<TargetView>();
+    static_assert(src_rank == tgt_rank, "src and tgt need same rank");
+    SparseMatrixTransposeMultiplyAdd<indexing, src_rank, SourceValue, TargetValue>::apply(W, plan, src, tgt);
+}
+}  // namespace
+
+}  // namespace sparse
+
+template <typename Matrix, typename SourceView, typename TargetView>
+void sparse_matrix_transpose_multiply_add(const Matrix& matrix, const SourceView& src, TargetView& tgt,
+                                          const sparse::TransposeMultiplyPlan& plan, Indexing indexing) {
+    ATLAS_ASSERT(plan.valid_for(matrix), "TransposeMultiplyPlan was created for a different matrix");
+    auto src_v = make_view(src);
+    auto tgt_v = make_view(tgt);
+    if (introspection::layout_right(src) || introspection::layout_right(tgt)) {
+        ATLAS_ASSERT(introspection::layout_right(src) && introspection::layout_right(tgt));
+        sparse::dispatch_sparse_matrix_transpose_multiply_add<Indexing::layout_right>(matrix, plan, src_v, tgt_v);
+    }
+    else if (indexing == Indexing::layout_left) {
+        sparse::dispatch_sparse_matrix_transpose_multiply_add<Indexing::layout_left>(matrix, plan, src_v, tgt_v);
+    }
+    else if (indexing == Indexing::layout_right) {
+        sparse::dispatch_sparse_matrix_transpose_multiply_add<Indexing::layout_right>(matrix, plan, src_v, tgt_v);
+    }
+    else {
+        throw_NotImplemented("indexing not implemented", Here());
+    }
+}
+
+template <typename Matrix, typename SourceView, typename TargetView>
+void sparse_matrix_transpose_multiply_add(const Matrix& matrix, const SourceView& src, TargetView& tgt,
+                                          Indexing indexing) {
+    sparse_matrix_transpose_multiply_add(matrix, src, tgt, sparse::TransposeMultiplyPlan(matrix), indexing);
+}
+
+}  // namespace linalg
+}  // namespace atlas
@@ -53,6 +53,14 @@ class MeshGeneratorImpl;
 }
 }  // namespace atlas
 
+namespace atlas {
+class Mesh;
+namespace io {
+class RecordReader;
+void decode(RecordReader&, Mesh&, const std::string& key);
+}  // namespace io
+}  // namespace atlas
+
 //----------------------------------------------------------------------------------------------------------------------
 
 namespace atlas {
@@ -148,6 +156,7 @@ private:  // methods
 
     friend class mesh::MeshBuilder;
     friend class meshgenerator::MeshGeneratorImpl;
+    friend void io::decode(io::RecordReader&, Mesh&, const std::string& key);
     void setProjection(const Projection& p) { get()->setProjection(p); }
     void setGrid(const Grid& p) { get()->setGrid(p); }
 };
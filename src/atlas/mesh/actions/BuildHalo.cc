@@ -8,7 +8,9 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -62,15 +64,101 @@ namespace atlas {
 namespace mesh {
 namespace actions {
 
-struct Entity {
-    Entity(gidx_t gid, idx_t idx) {
-        g = gid;
-        i = idx;
+namespace {
+
+/// @brief Renumber global indices contiguously, starting from "start", following their global sorted order
+///
+/// Equal global indices, possibly on different partitions, receive the same new index.
+/// This is a parallel sample sort: the distinct indices are distributed over all partitions in sorted ranges
+/// delimited by sampled splitters, numbered by the partition owning the range after an exclusive scan of
+/// the range sizes, and the new numbers are then sent back. No partition ever holds the whole index set.
+void renumber_global_index_sorted(std::vector<gidx_t>& glb_idx, gidx_t start) {
+    ATLAS_TRACE();
+    const auto& comm = mpi::comm();
+    const int nparts = static_cast<int>(comm.size());
+    const int mypart = static_cast<int>(comm.rank());
+
+    // Distinct local indices, sorted
+    std::vector<gidx_t> local(glb_idx);
+    ATLAS_TRACE_SCOPE("sort local") {
+        omp::sort(local.begin(), local.end());
+        local.erase(std::unique(local.begin(), local.end()), local.end());
     }
-    gidx_t g;
-    idx_t i;
-    bool operator<(const Entity& other) const { return (g < other.g); }
-};
+    const idx_t nb_local = static_cast<idx_t>(local.size());
+
+    // 1) Choose nparts-1 splitters from regularly sampled local indices of every partition
+    std::vector<gidx_t> splitters;
+    {
+        constexpr int max_samples = 64;
+        const int nb_samples      = std::min<idx_t>(std::min(nparts - 1, max_samples), nb_local);
+        std::vector<gidx_t> samples(nb_samples);
+        for (int j = 0; j < nb_samples; ++j) {
+            samples[j] = local[(size_t(j) + 1) * size_t(nb_local) / size_t(nb_samples + 1)];
+        }
+        atlas::mpi::Buffer<gidx_t, 1> recv(nparts);
+        ATLAS_TRACE_MPI(ALLGATHER) { comm.allGatherv(samples.begin(), samples.end(), recv); }
+        std::vector<gidx_t>& all_samples = recv.buffer;
+        std::sort(all_samples.begin(), all_samples.end());
+        if (not all_samples.empty()) {
+            splitters.resize(nparts - 1);
+            for (int j = 0; j < nparts - 1; ++j) {
+                splitters[j] = all_samples[(size_t(j) + 1) * all_samples.size() / size_t(nparts)];
+            }
+        }
+    }
+
+    // 2) Send every distinct index to the partition owning its range.
+    //    As "local" is sorted, indices for the same partition are contiguous
+    std::vector<int> sendcounts(nparts, 0);
+    std::vector<int> senddispls(nparts, 0);
+    std::vector<int> recvcounts(nparts, 0);
+    std::vector<int> recvdispls(nparts, 0);
+    for (idx_t j = 0; j < nb_local; ++j) {
+        int p = static_cast<int>(std::upper_bound(splitters.begin(), splitters.end(), local[j]) - splitters.begin());
+        ++sendcounts[p];
+    }
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(sendcounts, recvcounts); }
+    for (int p = 1; p < nparts; ++p) {
+        senddispls[p] = senddispls[p - 1] + sendcounts[p - 1];
+        recvdispls[p] = recvdispls[p - 1] + recvcounts[p - 1];
+    }
+    std::vector<gidx_t> recv(recvdispls[nparts - 1] + recvcounts[nparts - 1]);
+    ATLAS_TRACE_MPI(ALLTOALL) {
+        comm.allToAllv(local.data(), sendcounts.data(), senddispls.data(), recv.data(), recvcounts.data(),
+                       recvdispls.data());
+    }
+
+    // 3) Number the distinct indices of the owned range, offset by an exclusive scan over partitions
+    std::vector<gidx_t> owned(recv);
+    ATLAS_TRACE_SCOPE("sort owned") {
+        omp::sort(owned.begin(), owned.end());
+        owned.erase(std::unique(owned.begin(), owned.end()), owned.end());
+    }
+    gidx_t offset = start;
+    {
+        std::vector<gidx_t> nb_owned(nparts);
+        ATLAS_TRACE_MPI(ALLGATHER) { comm.allGather(gidx_t(owned.size()), nb_owned.begin(), nb_owned.end()); }
+        offset += std::accumulate(nb_owned.begin(), nb_owned.begin() + mypart, gidx_t(0));
+    }
+    const idx_t nb_recv = static_cast<idx_t>(recv.size());
+    atlas_omp_parallel_for(idx_t j = 0; j < nb_recv; ++j) {
+        recv[j] = offset + (std::lower_bound(owned.begin(), owned.end(), recv[j]) - owned.begin());
+    }
+
+    // 4) Send the new numbers back, in the order they were requested
+    std::vector<gidx_t> renumbered(nb_local);
+    ATLAS_TRACE_MPI(ALLTOALL) {
+        comm.allToAllv(recv.data(), recvcounts.data(), recvdispls.data(), renumbered.data(), sendcounts.data(),
+                       senddispls.data());
+    }
+
+    const idx_t size = static_cast<idx_t>(glb_idx.size());
+    atlas_omp_parallel_for(idx_t j = 0; j < size; ++j) {
+        glb_idx[j] = renumbered[std::lower_bound(local.begin(), local.end(), glb_idx[j]) - local.begin()];
+    }
+}
+
+}  // namespace
 
 void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& build_halo, mesh::Nodes& nodes,
                                             bool do_all) {
@@ -80,10 +168,6 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
     // uid,
     //     and could receive different gidx for different tasks
 
-    // unused // int mypart = mpi::rank();
-    int nparts  = mpi::size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> nodes_glb_idx = array::make_view<gidx_t, 1>(nodes.global_index());
     // nodes_glb_idx.dump( Log::info() );
     //  ATLAS_DEBUG( "min = " << nodes.global_index().metadata().getLong("min") );
@@ -133,50 +217,7 @@ void make_nodes_global_index_human_readable(const mesh::actions::BuildHalo& buil
     //    }
     //  }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_nodes, recvcounts, root); }
-    idx_t glb_nb_nodes = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered(glb_nb_nodes);
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                            recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> node_sort;
-    node_sort.reserve(glb_nb_nodes);
-    const idx_t nb_glb_idx_gathered = static_cast<idx_t>(glb_idx_gathered.size());
-    for (idx_t jnode = 0; jnode < nb_glb_idx_gathered; ++jnode) {
-        node_sort.emplace_back(glb_idx_gathered[jnode], jnode);
-    }
-
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(node_sort.begin(), node_sort.end()); }
-
-    gidx_t gid               = glb_idx_max + 1;
-    const idx_t nb_node_sort = static_cast<idx_t>(node_sort.size());
-    for (idx_t jnode = 0; jnode < nb_node_sort; ++jnode) {
-        if (jnode > 0 && node_sort[jnode].g != node_sort[jnode - 1].g) {
-            ++gid;
-        }
-        int inode               = node_sort[jnode].i;
-        glb_idx_gathered[inode] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                             static_cast<int>(glb_idx.size()), root);
-    }
+    renumber_global_index_sorted(glb_idx, glb_idx_max + 1);
 
     for (int jnode = 0; jnode < nb_nodes; ++jnode) {
         nodes_glb_idx(points_to_edit[jnode]) = glb_idx[jnode];
@@ -193,9 +234,6 @@ void make_cells_global_index_human_readable(const mesh::actions::BuildHalo& buil
                                             bool do_all) {
     ATLAS_TRACE();
 
-    int nparts = static_cast<idx_t>(mpi::size());
-    idx_t root = 0;
-
     array::ArrayView<gidx_t, 1> cells_glb_idx = array::make_view<gidx_t, 1>(cells.global_index());
     //  ATLAS_DEBUG( "min = " << cells.global_index().metadata().getLong("min") );
     //  ATLAS_DEBUG( "max = " << cells.global_index().metadata().getLong("max") );
@@ -234,48 +272,7 @@ void make_cells_global_index_human_readable(const mesh::actions::BuildHalo& buil
         glb_idx[i] = cells_glb_idx(cells_to_edit[i]);
     }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts(mpi::size());
-    std::vector<int> recvdispls(mpi::size());
-
-    ATLAS_TRACE_MPI(GATHER) { mpi::comm().gather(nb_cells, recvcounts, root); }
-    idx_t glb_nb_cells = std::accumulate(recvcounts.begin(), recvcounts.end(), 0);
-
-    recvdispls[0] = 0;
-    for (int jpart = 1; jpart < nparts; ++jpart) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered(glb_nb_cells);
-    ATLAS_TRACE_MPI(GATHER) {
-        mpi::comm().gatherv(glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                            recvdispls.data(), root);
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> cell_sort;
-    cell_sort.reserve(glb_nb_cells);
-    for (idx_t jcell = 0; jcell < glb_nb_cells; ++jcell) {
-        cell_sort.emplace_back(glb_idx_gathered[jcell], jcell);
-    }
-
-    ATLAS_TRACE_SCOPE("sort on rank 0") { std::sort(cell_sort.begin(), cell_sort.end()); }
-
-    gidx_t gid = glb_idx_max + 1;
-    for (idx_t jcell = 0; jcell < glb_nb_cells; ++jcell) {
-        if (jcell > 0 && cell_sort[jcell].g != cell_sort[jcell - 1].g) {
-            ++gid;
-        }
-        idx_t icell             = cell_sort[jcell].i;
-        glb_idx_gathered[icell] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI(SCATTER) {
-        mpi::comm().scatterv(glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                             static_cast<int>(glb_idx.size()), root);
-    }
+    renumber_global_index_sorted(glb_idx, glb_idx_max + 1);
 
     for (int jcell = 0; jcell < nb_cells; ++jcell) {
         cells_glb_idx(cells_to_edit[jcell]) = glb_idx[jcell];
@@ -601,23 +598,161 @@ public:
         }
     };
 
-    static void all_to_all(Buffers& send, Buffers& recv) {
+    /// Apply functor to each of the per-destination vectors of rank p, in a fixed order
+    template <typename Functor>
+    static void for_each_vector(Buffers& buf, idx_t p, Functor&& f) {
+        f(buf.node_glb_idx[p]);
+        f(buf.node_part[p]);
+        f(buf.node_ridx[p]);
+        f(buf.node_flags[p]);
+        f(buf.node_xy[p]);
+        f(buf.elem_glb_idx[p]);
+        f(buf.elem_nodes_id[p]);
+        f(buf.elem_part[p]);
+        f(buf.elem_ridx[p]);
+        f(buf.elem_type[p]);
+        f(buf.elem_flags[p]);
+        f(buf.elem_nodes_displs[p]);
+    }
+
+    /// Pack all vectors destined for rank p into one contiguous byte buffer:
+    /// for each vector its number of entries, followed by its data.
+    /// Nothing is packed when all vectors are empty.
+    static void pack(Buffers& buf, idx_t p, std::vector<char>& packed) {
+        size_t nb_bytes = 0;
+        bool empty      = true;
+        for_each_vector(buf, p, [&](const auto& v) {
+            nb_bytes += sizeof(size_t) + v.size() * sizeof(v[0]);
+            empty = empty && v.empty();
+        });
+        packed.clear();
+        if (empty) {
+            return;
+        }
+        packed.resize(nb_bytes);
+        char* pos = packed.data();
+        for_each_vector(buf, p, [&](const auto& v) {
+            size_t size = v.size();
+            std::memcpy(pos, &size, sizeof(size_t));
+            pos += sizeof(size_t);
+            std::memcpy(pos, v.data(), size * sizeof(v[0]));
+            pos += size * sizeof(v[0]);
+        });
+    }
+
+    static void unpack(const char* packed, size_t nb_bytes, Buffers& buf, idx_t p) {
+        const char* pos = packed;
+        const char* end = packed + nb_bytes;
+        for_each_vector(buf, p, [&](auto& v) {
+            if (pos == end) {
+                v.clear();
+                return;
+            }
+            size_t size;
+            std::memcpy(&size, pos, sizeof(size_t));
+            pos += sizeof(size_t);
+            v.resize(size);
+            std::memcpy(v.data(), pos, size * sizeof(v[0]));
+            pos += size * sizeof(v[0]);
+        });
+        ATLAS_ASSERT(pos == end);
+    }
+
+    /// Exchange send buffers with all partitions that have data for us, packing all node and element
+    /// vectors per destination into a single message.
+    /// When the set of communicating partitions is known and symmetric (neighbours), message sizes are
+    /// exchanged point-to-point only; otherwise a single integer alltoall determines them.
+    static void all_to_all(Buffers& send, Buffers& recv, const std::vector<idx_t>* neighbours = nullptr) {
         ATLAS_TRACE();
         const eckit::mpi::Comm& comm = mpi::comm();
+        const idx_t mpi_size         = static_cast<idx_t>(comm.size());
+        const idx_t mpi_rank         = static_cast<idx_t>(comm.rank());
+        const int counts_tag         = 2;
+        const int buffer_tag         = 3;
+
+        std::vector<std::vector<char>> send_packed(mpi_size);
+        std::vector<int> send_counts(mpi_size, 0);
+        std::vector<int> recv_counts(mpi_size, 0);
+        auto pack_to = [&](idx_t to) {
+            pack(send, to, send_packed[to]);
+            ATLAS_ASSERT(send_packed[to].size() <= size_t(std::numeric_limits<int>::max()));
+            send_counts[to] = static_cast<int>(send_packed[to].size());
+        };
 
-        ATLAS_TRACE_MPI(ALLTOALL) {
-            comm.allToAll(send.node_glb_idx, recv.node_glb_idx);
-            comm.allToAll(send.node_part, recv.node_part);
-            comm.allToAll(send.node_ridx, recv.node_ridx);
-            comm.allToAll(send.node_flags, recv.node_flags);
-            comm.allToAll(send.node_xy, recv.node_xy);
-            comm.allToAll(send.elem_glb_idx, recv.elem_glb_idx);
-            comm.allToAll(send.elem_nodes_id, recv.elem_nodes_id);
-            comm.allToAll(send.elem_part, recv.elem_part);
-            comm.allToAll(send.elem_ridx, recv.elem_ridx);
-            comm.allToAll(send.elem_type, recv.elem_type);
-            comm.allToAll(send.elem_flags, recv.elem_flags);
-            comm.allToAll(send.elem_nodes_displs, recv.elem_nodes_displs);
+        std::vector<idx_t> peers;
+        if (neighbours) {
+            for (idx_t p : *neighbours) {
+                pack_to(p);
+            }
+            std::vector<eckit::mpi::Request> requests;
+            requests.reserve(2 * neighbours->size());
+            ATLAS_TRACE_MPI(IRECEIVE) {
+                for (idx_t from : *neighbours) {
+                    if (from != mpi_rank) {
+                        requests.push_back(comm.iReceive(recv_counts[from], from, counts_tag));
+                    }
+                }
+            }
+            ATLAS_TRACE_MPI(ISEND) {
+                for (idx_t to : *neighbours) {
+                    if (to != mpi_rank) {
+                        requests.push_back(comm.iSend(send_counts[to], to, counts_tag));
+                    }
+                }
+            }
+            ATLAS_TRACE_MPI(WAIT) {
+                for (auto request : requests) {
+                    comm.wait(request);
+                }
+            }
+            peers = *neighbours;
+        }
+        else {
+            for (idx_t p = 0; p < mpi_size; ++p) {
+                pack_to(p);
+            }
+            ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(send_counts, recv_counts); }
+            for (idx_t p = 0; p < mpi_size; ++p) {
+                if (send_counts[p] || recv_counts[p]) {
+                    peers.push_back(p);
+                }
+            }
+        }
+
+        std::vector<size_t> recv_displs(mpi_size + 1, 0);
+        for (idx_t p = 0; p < mpi_size; ++p) {
+            recv_displs[p + 1] = recv_displs[p] + (p == mpi_rank ? send_counts[p] : recv_counts[p]);
+        }
+        std::vector<char> recv_packed(recv_displs[mpi_size]);
+
+        std::vector<eckit::mpi::Request> requests;
+        requests.reserve(2 * peers.size());
+        ATLAS_TRACE_MPI(IRECEIVE) {
+            for (idx_t from : peers) {
+                if (from != mpi_rank && recv_counts[from] > 0) {
+                    requests.push_back(
+                        comm.iReceive(recv_packed.data() + recv_displs[from], recv_counts[from], from, buffer_tag));
+                }
+            }
+        }
+        ATLAS_TRACE_MPI(ISEND) {
+            for (idx_t to : peers) {
+                if (to != mpi_rank && send_counts[to] > 0) {
+                    requests.push_back(comm.iSend(send_packed[to].data(), send_counts[to], to, buffer_tag));
+                }
+            }
+        }
+        // Data destined for this rank (periodicity with self) does not go through MPI
+        std::copy(send_packed[mpi_rank].begin(), send_packed[mpi_rank].end(),
+                  recv_packed.begin() + recv_displs[mpi_rank]);
+        ATLAS_TRACE_MPI(WAIT) {
+            for (auto request : requests) {
+                comm.wait(request);
+            }
+        }
+
+        for (idx_t p = 0; p < mpi_size; ++p) {
+            unpack(recv_packed.data() + recv_displs[p], recv_displs[p + 1] - recv_displs[p], recv, p);
         }
     }
 
@@ -1243,7 +1378,12 @@ void increase_halo_interior(BuildHaloHelper& helper) {
     }
 
     // 5) Now communicate all buffers
+#ifndef ATLAS_103
     helper.all_to_all(sendmesh, recvmesh);
+#else
+    const Mesh::PartitionGraph::Neighbours neighbours = helper.mesh.nearestNeighbourPartitions();
+    helper.all_to_all(sendmesh, recvmesh, &neighbours);
+#endif
 
 // 6) Adapt mesh
 #ifdef DEBUG_OUTPUT
@@ -1360,7 +1500,14 @@ void increase_halo_periodic(BuildHaloHelper& helper, const PeriodicPoints& perio
     }
 
     // 5) Now communicate all buffers
+#ifndef ATLAS_103
     helper.all_to_all(sendmesh, recvmesh);
+#else
+    Mesh::PartitionGraph::Neighbours neighbours = helper.mesh.nearestNeighbourPartitions();
+    idx_t rank = mpi::rank();
+    neighbours.insert(std::upper_bound(neighbours.begin(), neighbours.end(), rank), rank);
+    helper.all_to_all(sendmesh, recvmesh, &neighbours);
+#endif
 
 // 6) Adapt mesh
 #ifdef DEBUG_OUTPUT
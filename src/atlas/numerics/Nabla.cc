@@ -16,6 +16,8 @@
 #include "eckit/thread/AutoLock.h"
 #include "eckit/thread/Mutex.h"
 
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/library/config.h"
 #include "atlas/numerics/Method.h"
 #include "atlas/numerics/Nabla.h"
@@ -44,6 +46,34 @@ NablaImpl::NablaImpl(const Method& method, const eckit::Parametrisation&): metho
 
 NablaImpl::~NablaImpl() = default;
 
+void NablaImpl::gradient(const FieldSet& scalars, FieldSet& grads) const {
+    ATLAS_ASSERT(scalars.size() == grads.size());
+    for (idx_t i = 0; i < scalars.size(); ++i) {
+        gradient(scalars[i], grads[i]);
+    }
+}
+
+void NablaImpl::divergence(const FieldSet& vectors, FieldSet& divs) const {
+    ATLAS_ASSERT(vectors.size() == divs.size());
+    for (idx_t i = 0; i < vectors.size(); ++i) {
+        divergence(vectors[i], divs[i]);
+    }
+}
+
+void NablaImpl::curl(const FieldSet& vectors, FieldSet& curls) const {
+    ATLAS_ASSERT(vectors.size() == curls.size());
+    for (idx_t i = 0; i < vectors.size(); ++i) {
+        curl(vectors[i], curls[i]);
+    }
+}
+
+void NablaImpl::laplacian(const FieldSet& scalars, FieldSet& laplacians) const {
+    ATLAS_ASSERT(scalars.size() == laplacians.size());
+    for (idx_t i = 0; i < scalars.size(); ++i) {
+        laplacian(scalars[i], laplacians[i]);
+    }
+}
+
 Nabla::Nabla(const Method& method, const eckit::Parametrisation& p): Handle(NablaFactory::build(method, p)) {}
 
 Nabla::Nabla(const Method& method): Nabla(method, util::NoConfig()) {}
@@ -64,6 +94,22 @@ void Nabla::laplacian(const Field& scalar, Field& laplacian) const {
     get()->laplacian(scalar, laplacian);
 }
 
+void Nabla::gradient(const FieldSet& scalars, FieldSet& grads) const {
+    get()->gradient(scalars, grads);
+}
+
+void Nabla::divergence(const FieldSet& vectors, FieldSet& divs) const {
+    get()->divergence(vectors, divs);
+}
+
+void Nabla::curl(const FieldSet& vectors, FieldSet& curls) const {
+    get()->curl(vectors, curls);
+}
+
+void Nabla::laplacian(const FieldSet& scalars, FieldSet& laplacians) const {
+    get()->laplacian(scalars, laplacians);
+}
+
 namespace {
 
 template <typename T>
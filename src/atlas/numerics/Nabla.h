@@ -33,6 +33,7 @@ class FunctionSpaceImpl;
 }  // namespace atlas
 namespace atlas {
 class Field;
+class FieldSet;
 class FunctionSpace;
 }  // namespace atlas
 
@@ -50,6 +51,13 @@ public:
     virtual void curl(const Field& vector, Field& curl) const           = 0;
     virtual void laplacian(const Field& scalar, Field& laplacian) const = 0;
 
+    /// Operators applied to each field of a FieldSet. Implementations may override these to traverse the mesh
+    /// connectivity once for all fields. The default implementations apply the Field operators one by one.
+    virtual void gradient(const FieldSet& scalars, FieldSet& grads) const;
+    virtual void divergence(const FieldSet& vectors, FieldSet& divs) const;
+    virtual void curl(const FieldSet& vectors, FieldSet& curls) const;
+    virtual void laplacian(const FieldSet& scalars, FieldSet& laplacians) const;
+
     virtual const FunctionSpace& functionspace() const = 0;
 
 private:
@@ -70,6 +78,13 @@ public:
     void divergence(const Field& vector, Field& div) const;
     void curl(const Field& vector, Field& curl) const;
     void laplacian(const Field& scalar, Field& laplacian) const;
+
+    /// Operators applied to all fields of a FieldSet at once, with the i-th output field computed from the i-th
+    /// input field
+    void gradient(const FieldSet& scalars, FieldSet& grads) const;
+    void divergence(const FieldSet& vectors, FieldSet& divs) const;
+    void curl(const FieldSet& vectors, FieldSet& curls) const;
+    void laplacian(const FieldSet& scalars, FieldSet& laplacians) const;
 };
 
 // ------------------------------------------------------------------
@@ -117,6 +117,37 @@ void Method::setup() {
                 }
             }
         }
+
+        // Metric terms, computed once for all Nabla operators
+        {
+            const double deg2rad = M_PI / 180.;
+            const double scale   = deg2rad * deg2rad * radius_;
+            const idx_t nedges   = edges_.size();
+
+            metric_y_     = Field("metric_y", array::make_datatype<double>(), array::make_shape(nnodes));
+            metric_x_     = Field("metric_x", array::make_datatype<double>(), array::make_shape(nnodes));
+            cos_lat_      = Field("cos_lat", array::make_datatype<double>(), array::make_shape(nnodes));
+            dual_normals_ = Field("dual_normals", array::make_datatype<double>(), array::make_shape(nedges, 2));
+
+            const auto lonlat_deg   = array::make_view<double, 2>(nodes_.lonlat());
+            const auto dual_volumes = array::make_view<double, 1>(nodes_.field("dual_volumes"));
+            const auto normals_deg  = array::make_view<double, 2>(edges_.field("dual_normals"));
+            auto metric_y           = array::make_view<double, 1>(metric_y_);
+            auto metric_x           = array::make_view<double, 1>(metric_x_);
+            auto cos_lat            = array::make_view<double, 1>(cos_lat_);
+            auto dual_normals       = array::make_view<double, 2>(dual_normals_);
+
+            atlas_omp_parallel_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
+                const double y  = lonlat_deg(jnode, LAT) * deg2rad;
+                cos_lat(jnode)  = std::cos(y);
+                metric_y(jnode) = 1. / (dual_volumes(jnode) * scale);
+                metric_x(jnode) = metric_y(jnode) / cos_lat(jnode);
+            }
+            atlas_omp_parallel_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
+                dual_normals(jedge, LON) = normals_deg(jedge, LON) * deg2rad;
+                dual_normals(jedge, LAT) = normals_deg(jedge, LAT) * deg2rad;
+            }
+        }
     }
 }
 
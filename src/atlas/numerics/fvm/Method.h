@@ -12,6 +12,7 @@
 
 #include <string>
 
+#include "atlas/field/Field.h"
 #include "atlas/functionspace/EdgeColumns.h"
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/numerics/Method.h"
@@ -61,6 +62,18 @@ public:
 
     const double& radius() const { return radius_; }
 
+    /// @brief Metric factor 1 / (dual_volume * deg2rad^2 * radius) per node, for derivatives in latitude direction
+    const Field& metric_y() const { return metric_y_; }
+
+    /// @brief Metric factor metric_y / cos(lat) per node, for derivatives in longitude direction
+    const Field& metric_x() const { return metric_x_; }
+
+    /// @brief Cosine of latitude per node
+    const Field& cos_lat() const { return cos_lat_; }
+
+    /// @brief Edge dual normals, scaled from degrees to radians
+    const Field& dual_normals() const { return dual_normals_; }
+
 private:
     void setup();
 
@@ -74,6 +87,11 @@ private:         // data
     functionspace::EdgeColumns edge_columns_;
 
     double radius_;
+
+    Field metric_y_;
+    Field metric_x_;
+    Field cos_lat_;
+    Field dual_normals_;
 };
 
 // -------------------------------------------------------------------
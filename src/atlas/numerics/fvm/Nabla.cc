@@ -8,11 +8,17 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "eckit/config/Parametrisation.h"
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
@@ -34,7 +40,78 @@ namespace fvm {
 
 namespace {
 static NablaBuilder<Nabla> __fvm_nabla("fvm");
+
+// Levels per block in the node loops, so that the edge values of a node's edges stay in cache
+constexpr idx_t level_block = 32;
+
+// Edge of a node, gathered once per node and applied to all fields and levels
+template <typename Value>
+struct NodeEdge {
+    idx_t ip1;
+    idx_t ip2;
+    Value add;
+    Value S[2];
+    Value cosy[2];
+};
+
+template <typename Value>
+auto make_scalarview(const Field& field) {
+    return field.levels() ? array::make_view<Value, 2>(field).slice(Range::all(), Range::all())
+                          : array::make_view<Value, 1>(field).slice(Range::all(), Range::dummy());
+}
+
+template <typename Value>
+auto make_scalarview(Field& field) {
+    return field.levels() ? array::make_view<Value, 2>(field).slice(Range::all(), Range::all())
+                          : array::make_view<Value, 1>(field).slice(Range::all(), Range::dummy());
+}
+
+template <typename Value>
+auto make_vectorview(const Field& field) {
+    return field.levels() ? array::make_view<Value, 3>(field).slice(Range::all(), Range::all(), Range::all())
+                          : array::make_view<Value, 2>(field).slice(Range::all(), Range::dummy(), Range::all());
+}
+
+template <typename Value>
+auto make_vectorview(Field& field) {
+    return field.levels() ? array::make_view<Value, 3>(field).slice(Range::all(), Range::all(), Range::all())
+                          : array::make_view<Value, 2>(field).slice(Range::all(), Range::dummy(), Range::all());
+}
+
+// Call f(Value{}, in, out) with the fields of each floating point datatype
+template <typename Function>
+void dispatch_by_datatype(const std::vector<Field>& in, std::vector<Field>& out, const Function& f) {
+    ATLAS_ASSERT(in.size() == out.size());
+    std::vector<Field> in32, out32, in64, out64;
+    for (size_t i = 0; i < in.size(); ++i) {
+        ATLAS_ASSERT(in[i].datatype() == out[i].datatype());
+        switch (in[i].datatype().kind()) {
+            case (DataType::KIND_REAL32): {
+                in32.push_back(in[i]);
+                out32.push_back(out[i]);
+                break;
+            }
+            case (DataType::KIND_REAL64): {
+                in64.push_back(in[i]);
+                out64.push_back(out[i]);
+                break;
+            }
+            default:
+                ATLAS_NOTIMPLEMENTED;
+        }
+    }
+    if (in32.size()) {
+        f(float{}, in32, out32);
+    }
+    if (in64.size()) {
+        f(double{}, in64, out64);
+    }
+}
+
+std::vector<Field> to_vector(const FieldSet& fieldset) {
+    return std::vector<Field>(fieldset.begin(), fieldset.end());
 }
+}  // namespace
 
 Nabla::Nabla(const numerics::Method& method, const eckit::Parametrisation& p): atlas::numerics::NablaImpl(method, p) {
     fvm_ = dynamic_cast<const fvm::Method*>(&method);
@@ -82,6 +159,19 @@ void Nabla::setup() {
     for (idx_t jedge = 0; jedge < c; ++jedge) {
         pole_edges_.push_back(tmp[jedge]);
     }
+
+    // Metric term at cell interfaces for metric_approach != 0
+    if (metric_approach_ != 0) {
+        const double deg2rad                          = M_PI / 180.;
+        const auto lonlat_deg                         = array::make_view<double, 2>(fvm_->mesh().nodes().lonlat());
+        const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
+        edge_cos_lat_.resize(nedges);
+        for (idx_t jedge = 0; jedge < nedges; ++jedge) {
+            const double y1      = lonlat_deg(edge2node(jedge, 0), LAT) * deg2rad;
+            const double y2      = lonlat_deg(edge2node(jedge, 1), LAT) * deg2rad;
+            edge_cos_lat_[jedge] = std::cos(0.5 * (y1 + y2));
+        }
+    }
 }
 
 void Nabla::gradient(const Field& field, Field& grad_field) const {
@@ -89,102 +179,106 @@ void Nabla::gradient(const Field& field, Field& grad_field) const {
         return gradient_of_vector(field, grad_field);
     }
     else {
-        return gradient_of_scalar(field, grad_field);
+        std::vector<Field> grad{grad_field};
+        return gradient_of_scalars({field}, grad);
     }
 }
 
-void Nabla::gradient_of_scalar(const Field& scalar_field, Field& grad_field) const {
-    Log::debug() << "Compute gradient of scalar field " << scalar_field.name() << " with fvm method" << std::endl;
+void Nabla::gradient(const FieldSet& fields, FieldSet& grad_fields) const {
+    ATLAS_ASSERT(fields.size() == grad_fields.size());
+    std::vector<Field> scalars;
+    std::vector<Field> grads;
+    for (idx_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].variables() > 1) {
+            gradient_of_vector(fields[i], grad_fields[i]);
+        }
+        else {
+            scalars.push_back(fields[i]);
+            grads.push_back(grad_fields[i]);
+        }
+    }
+    if (scalars.size()) {
+        gradient_of_scalars(scalars, grads);
+    }
+}
 
-    auto dispatch = [&](auto value) {
-        using Value          = std::decay_t<decltype(value)>;
+void Nabla::gradient_of_scalars(const std::vector<Field>& scalar_fields, std::vector<Field>& grad_fields) const {
+    for (const auto& scalar_field : scalar_fields) {
+        Log::debug() << "Compute gradient of scalar field " << scalar_field.name() << " with fvm method" << std::endl;
+    }
 
-        const Value radius  = fvm_->radius();
-        const Value deg2rad = M_PI / 180.;
+    auto dispatch = [&](auto value, const std::vector<Field>& in, std::vector<Field>& out) {
+        using Value = std::decay_t<decltype(value)>;
 
         const mesh::Edges& edges = fvm_->mesh().edges();
         const mesh::Nodes& nodes = fvm_->mesh().nodes();
 
-        const idx_t nnodes = fvm_->node_columns().nb_nodes();
-        const idx_t nedges = fvm_->edge_columns().nb_edges();
-
-        const auto scalar = scalar_field.levels()
-                                ? array::make_view<Value, 2>(scalar_field).slice(Range::all(), Range::all())
-                                : array::make_view<Value, 1>(scalar_field).slice(Range::all(), Range::dummy());
-        auto grad         = grad_field.levels()
-                                ? array::make_view<Value, 3>(grad_field).slice(Range::all(), Range::all(), Range::all())
-                                : array::make_view<Value, 2>(grad_field).slice(Range::all(), Range::dummy(), Range::all());
-
-        const idx_t nlev = scalar.shape(1);
-        if (grad.shape(1) != nlev) {
-            throw_AssertionFailed("gradient field should have same number of levels", Here());
+        const idx_t nnodes  = fvm_->node_columns().nb_nodes();
+        const idx_t nedges  = fvm_->edge_columns().nb_edges();
+        const idx_t nfields = static_cast<idx_t>(in.size());
+
+        std::vector<decltype(make_scalarview<Value>(in[0]))> scalars;
+        std::vector<decltype(make_vectorview<Value>(out[0]))> grads;
+        for (idx_t jfield = 0; jfield < nfields; ++jfield) {
+            scalars.push_back(make_scalarview<Value>(in[jfield]));
+            grads.push_back(make_vectorview<Value>(out[jfield]));
+            if (grads.back().shape(1) != scalars.back().shape(1)) {
+                throw_AssertionFailed("gradient field should have same number of levels", Here());
+            }
         }
 
-        const auto lonlat_deg     = array::make_view<double, 2>(nodes.lonlat());
-        const auto dual_volumes   = array::make_view<double, 1>(nodes.field("dual_volumes"));
-        const auto dual_normals   = array::make_view<double, 2>(edges.field("dual_normals"));
+        const auto metric_x       = array::make_view<double, 1>(fvm_->metric_x());
+        const auto metric_y       = array::make_view<double, 1>(fvm_->metric_y());
+        const auto dual_normals   = array::make_view<double, 2>(fvm_->dual_normals());
         const auto node2edge_sign = array::make_view<double, 2>(nodes.field("node2edge_sign"));
 
         const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
         const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
 
-        array::ArrayT<Value> avgS_arr(nedges, nlev, 2ul);
-        auto avgS = array::make_view<Value, 3>(avgS_arr);
-
-        const Value scale = deg2rad * deg2rad * radius;
-
         atlas_omp_parallel {
-            atlas_omp_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-                idx_t ip1 = edge2node(jedge, 0);
-                idx_t ip2 = edge2node(jedge, 1);
-                Value S[2] = { static_cast<Value>(dual_normals(jedge, LON)), static_cast<Value>(dual_normals(jedge, LAT))};
-
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    Value avg              = (scalar(ip1, jlev) + scalar(ip2, jlev)) * Value{0.5};
-                    avgS(jedge, jlev, LON) = S[LON] * deg2rad * avg;
-                    avgS(jedge, jlev, LAT) = S[LAT] * deg2rad * avg;
-                }
-            }
-
+            std::vector<NodeEdge<Value>> node_edges(node2edge.maxcols());
             atlas_omp_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    grad(jnode, jlev, LON) = 0.;
-                    grad(jnode, jlev, LAT) = 0.;
-                }
+                idx_t nb_edges = 0;
                 for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
                     const idx_t iedge = node2edge(jnode, jedge);
                     if (iedge < nedges) {
-                        const Value add = node2edge_sign(jnode, jedge);
-                        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                            grad(jnode, jlev, LON) += add * avgS(iedge, jlev, LON);
-                            grad(jnode, jlev, LAT) += add * avgS(iedge, jlev, LAT);
-                        }
+                        auto& edge  = node_edges[nb_edges++];
+                        edge.ip1    = edge2node(iedge, 0);
+                        edge.ip2    = edge2node(iedge, 1);
+                        edge.add    = node2edge_sign(jnode, jedge);
+                        edge.S[LON] = dual_normals(iedge, LON);
+                        edge.S[LAT] = dual_normals(iedge, LAT);
                     }
                 }
-
-                const Value y        = lonlat_deg(jnode, LAT) * deg2rad;
-                const Value metric_y = Value{1.} / (static_cast<Value>(dual_volumes(jnode)) * scale);
-                const Value metric_x = metric_y / std::cos(y);
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    grad(jnode, jlev, LON) *= metric_x;
-                    grad(jnode, jlev, LAT) *= metric_y;
+                const Value mx = metric_x(jnode);
+                const Value my = metric_y(jnode);
+
+                for (idx_t jfield = 0; jfield < nfields; ++jfield) {
+                    const auto& scalar = scalars[jfield];
+                    auto& grad         = grads[jfield];
+                    const idx_t nlev   = scalar.shape(1);
+                    for (idx_t jlev0 = 0; jlev0 < nlev; jlev0 += level_block) {
+                        const idx_t nb = std::min(level_block, nlev - jlev0);
+                        Value sum[level_block][2]{};
+                        for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+                            const auto& edge = node_edges[jedge];
+                            for (idx_t k = 0; k < nb; ++k) {
+                                const Value avg =
+                                    (scalar(edge.ip1, jlev0 + k) + scalar(edge.ip2, jlev0 + k)) * Value{0.5};
+                                sum[k][LON] += edge.add * (edge.S[LON] * avg);
+                                sum[k][LAT] += edge.add * (edge.S[LAT] * avg);
+                            }
+                        }
+                        for (idx_t k = 0; k < nb; ++k) {
+                            grad(jnode, jlev0 + k, LON) = sum[k][LON] * mx;
+                            grad(jnode, jlev0 + k, LAT) = sum[k][LAT] * my;
+                        }
+                    }
                 }
             }
         }
     };
-    ATLAS_ASSERT( scalar_field.datatype() == grad_field.datatype() );
-    switch (scalar_field.datatype().kind()) {
-        case (DataType::KIND_REAL32): {
-            dispatch(float{});
-            break;
-        }
-        case (DataType::KIND_REAL64): {
-            dispatch(double{});
-            break;
-        }
-        default:
-            ATLAS_NOTIMPLEMENTED;
-    }
+    dispatch_by_datatype(scalar_fields, grad_fields, dispatch);
 }
 
 // ================================================================================
@@ -195,9 +289,6 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
     auto dispatch = [&](auto value) {
         using Value          = std::decay_t<decltype(value)>;
 
-        const Value radius  = fvm_->radius();
-        const Value deg2rad = M_PI / 180.;
-
         const mesh::Edges& edges = fvm_->mesh().edges();
         const mesh::Nodes& nodes = fvm_->mesh().nodes();
 
@@ -217,9 +308,9 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
             throw_AssertionFailed("gradient field should have same number of levels", Here());
         }
 
-        const auto lonlat_deg     = array::make_view<double, 2>(nodes.lonlat());
-        const auto dual_volumes   = array::make_view<double, 1>(nodes.field("dual_volumes"));
-        const auto dual_normals   = array::make_view<double, 2>(edges.field("dual_normals"));
+        const auto metric_x       = array::make_view<double, 1>(fvm_->metric_x());
+        const auto metric_y       = array::make_view<double, 1>(fvm_->metric_y());
+        const auto dual_normals   = array::make_view<double, 2>(fvm_->dual_normals());
         const auto node2edge_sign = array::make_view<double, 2>(nodes.field("node2edge_sign"));
         const auto edge_flags     = array::make_view<int, 1>(edges.flags());
         auto is_pole_edge         = [&](idx_t e) { return Topology::check(edge_flags(e), Topology::POLE); };
@@ -227,11 +318,6 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
         const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
         const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
 
-        array::ArrayT<Value> avgS_arr(nedges, nlev, 4ul);
-        array::ArrayView<Value, 3> avgS = array::make_view<Value, 3>(avgS_arr);
-
-        const Value scale = deg2rad * deg2rad * radius;
-
         enum
         {
             LONdLON = 0,
@@ -240,66 +326,57 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
             LATdLAT = 3
         };
 
-        atlas_omp_parallel {
-            atlas_omp_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-                idx_t ip1  = edge2node(jedge, 0);
-                idx_t ip2  = edge2node(jedge, 1);
-                Value pbc = 1. - 2. * is_pole_edge(jedge);
-
-                Value S[2] = {static_cast<Value>(dual_normals(jedge,LON)), static_cast<Value>(dual_normals(jedge,LAT))};
-                Value avg[2];
-
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    avg[LON] = (vector(ip1, jlev, LON) + pbc * vector(ip2, jlev, LON)) * Value{0.5};
-                    avg[LAT] = (vector(ip1, jlev, LAT) + pbc * vector(ip2, jlev, LAT)) * Value{0.5};
-                    avgS(jedge, jlev, LONdLON) = S[LON] * deg2rad * avg[LON];
-                    // above = 0 at pole because of dual_normals
-                    avgS(jedge, jlev, LONdLAT) = S[LAT] * deg2rad * avg[LON];
-                    avgS(jedge, jlev, LATdLON) = S[LON] * deg2rad * avg[LAT];
-                    // above = 0 at pole because of dual_normals
-                    avgS(jedge, jlev, LATdLAT) = S[LAT] * deg2rad * avg[LAT];
-                }
+        // Edge flux S * avg, at levels jlev0 ... jlev0 + nb
+        auto edge_flux = [&](idx_t iedge, idx_t jlev0, idx_t nb, auto&& f) {
+            const idx_t ip1  = edge2node(iedge, 0);
+            const idx_t ip2  = edge2node(iedge, 1);
+            const Value pbc  = 1. - 2. * is_pole_edge(iedge);
+            const Value S[2] = {static_cast<Value>(dual_normals(iedge, LON)),
+                                static_cast<Value>(dual_normals(iedge, LAT))};
+            for (idx_t k = 0; k < nb; ++k) {
+                const idx_t jlev = jlev0 + k;
+                const Value avg[2] = {(vector(ip1, jlev, LON) + pbc * vector(ip2, jlev, LON)) * Value{0.5},
+                                      (vector(ip1, jlev, LAT) + pbc * vector(ip2, jlev, LAT)) * Value{0.5}};
+                // LONdLON and LATdLON are 0 at pole because of dual_normals
+                f(k, S[LON] * avg[LON], S[LAT] * avg[LON], S[LON] * avg[LAT], S[LAT] * avg[LAT]);
             }
+        };
 
-            atlas_omp_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    grad(jnode, jlev, LONdLON) = 0.;
-                    grad(jnode, jlev, LONdLAT) = 0.;
-                    grad(jnode, jlev, LATdLON) = 0.;
-                    grad(jnode, jlev, LATdLAT) = 0.;
-                }
+        atlas_omp_parallel_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
+            for (idx_t jlev0 = 0; jlev0 < nlev; jlev0 += level_block) {
+                const idx_t nb = std::min(level_block, nlev - jlev0);
+                Value sum[level_block][4]{};
                 for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
                     const idx_t iedge = node2edge(jnode, jedge);
                     if (iedge < nedges) {
-                        Value add = node2edge_sign(jnode, jedge);
-                        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                            grad(jnode, jlev, LONdLON) += add * avgS(iedge, jlev, LONdLON);
-                            grad(jnode, jlev, LONdLAT) += add * avgS(iedge, jlev, LONdLAT);
-                            grad(jnode, jlev, LATdLON) += add * avgS(iedge, jlev, LATdLON);
-                            grad(jnode, jlev, LATdLAT) += add * avgS(iedge, jlev, LATdLAT);
-                        }
+                        const Value add = node2edge_sign(jnode, jedge);
+                        edge_flux(iedge, jlev0, nb, [&](idx_t k, Value ll, Value lt, Value tl, Value tt) {
+                            sum[k][LONdLON] += add * ll;
+                            sum[k][LONdLAT] += add * lt;
+                            sum[k][LATdLON] += add * tl;
+                            sum[k][LATdLAT] += add * tt;
+                        });
                     }
                 }
-                const Value y        = lonlat_deg(jnode, LAT) * deg2rad;
-                const Value metric_y = Value{1.} / (static_cast<Value>(dual_volumes(jnode)) * scale);
-                const Value metric_x = metric_y / std::cos(y);
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    grad(jnode, jlev, LONdLON) *= metric_x;
-                    grad(jnode, jlev, LATdLON) *= metric_x;
-                    grad(jnode, jlev, LONdLAT) *= metric_y;
-                    grad(jnode, jlev, LATdLAT) *= metric_y;
+                const Value mx = metric_x(jnode);
+                const Value my = metric_y(jnode);
+                for (idx_t k = 0; k < nb; ++k) {
+                    grad(jnode, jlev0 + k, LONdLON) = sum[k][LONdLON] * mx;
+                    grad(jnode, jlev0 + k, LATdLON) = sum[k][LATdLON] * mx;
+                    grad(jnode, jlev0 + k, LONdLAT) = sum[k][LONdLAT] * my;
+                    grad(jnode, jlev0 + k, LATdLAT) = sum[k][LATdLAT] * my;
                 }
             }
         }
         // Fix wrong node2edge_sign for vector quantities
         for (size_t jedge = 0; jedge < pole_edges_.size(); ++jedge) {
-            const idx_t iedge     = pole_edges_[jedge];
-            const idx_t jnode     = edge2node(iedge, 1);
-            const Value metric_y = Value{1.} / (static_cast<Value>(dual_volumes(jnode)) * scale);
-            for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                grad(jnode, jlev, LONdLAT) -= 2. * avgS(iedge, jlev, LONdLAT) * metric_y;
-                grad(jnode, jlev, LATdLAT) -= 2. * avgS(iedge, jlev, LATdLAT) * metric_y;
-            }
+            const idx_t iedge    = pole_edges_[jedge];
+            const idx_t jnode    = edge2node(iedge, 1);
+            const Value my       = metric_y(jnode);
+            edge_flux(iedge, 0, nlev, [&](idx_t jlev, Value, Value lt, Value, Value tt) {
+                grad(jnode, jlev, LONdLAT) -= 2. * lt * my;
+                grad(jnode, jlev, LATdLAT) -= 2. * tt * my;
+            });
         }
     };
     ATLAS_ASSERT( vector_field.datatype() == grad_field.datatype() );
@@ -320,241 +397,123 @@ void Nabla::gradient_of_vector(const Field& vector_field, Field& grad_field) con
 // ================================================================================
 
 void Nabla::divergence(const Field& vector_field, Field& div_field) const {
+    std::vector<Field> div{div_field};
+    divergence_or_curl<false>({vector_field}, div);
+}
 
-    auto dispatch = [&](auto value) {
-        using Value          = std::decay_t<decltype(value)>;
-
-        const Value radius  = fvm_->radius();
-        const Value deg2rad = M_PI / 180.;
-
-        const mesh::Edges& edges = fvm_->mesh().edges();
-        const mesh::Nodes& nodes = fvm_->mesh().nodes();
-
-        const idx_t nnodes = fvm_->node_columns().nb_nodes();
-        const idx_t nedges = fvm_->edge_columns().nb_edges();
-
-        const auto vector =
-            vector_field.levels()
-                ? array::make_view<Value, 3>(vector_field).slice(Range::all(), Range::all(), Range::all())
-                : array::make_view<Value, 2>(vector_field).slice(Range::all(), Range::dummy(), Range::all());
-        auto div = div_field.levels() ? array::make_view<Value, 2>(div_field).slice(Range::all(), Range::all())
-                                      : array::make_view<Value, 1>(div_field).slice(Range::all(), Range::dummy());
-
-        const idx_t nlev = vector.shape(1);
-        if (div.shape(1) != nlev) {
-            throw_AssertionFailed("div_field should have same number of levels", Here());
-        }
-
-        const auto lonlat_deg     = array::make_view<double, 2>(nodes.lonlat());
-        const auto dual_volumes   = array::make_view<double, 1>(nodes.field("dual_volumes"));
-        const auto dual_normals   = array::make_view<double, 2>(edges.field("dual_normals"));
-        const auto node2edge_sign = array::make_view<double, 2>(nodes.field("node2edge_sign"));
-        const auto edge_flags     = array::make_view<int, 1>(edges.flags());
-        auto is_pole_edge         = [&](idx_t e) { return Topology::check(edge_flags(e), Topology::POLE); };
-
-        const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
-        const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
-
-        array::ArrayT<Value> avgS_arr(nedges, nlev, 2ul);
-        array::ArrayView<Value, 3> avgS = array::make_view<Value, 3>(avgS_arr);
-
-        const Value scale = deg2rad * deg2rad * radius;
-
-        enum
-        {
-            LONdLON = 0,
-            LATdLAT = 1
-        };
-        atlas_omp_parallel {
-            atlas_omp_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-                Value pbc = 1 - is_pole_edge(jedge);
-
-                idx_t ip1 = edge2node(jedge, 0);
-                idx_t ip2 = edge2node(jedge, 1);
-                Value y1 = lonlat_deg(ip1, LAT) * deg2rad;
-                Value y2 = lonlat_deg(ip2, LAT) * deg2rad;
-
-                Value cosy1, cosy2;
-                if (metric_approach_ == 0) {
-                    cosy1 = std::cos(y1) * pbc;
-                    cosy2 = std::cos(y2) * pbc;
-                }
-                else {
-                    cosy1 = cosy2 = std::cos(0.5 * (y1 + y2)) * pbc;
-                }
-
-                Value S[2] = {static_cast<Value>(dual_normals(jedge, LON)) * deg2rad, static_cast<Value>(dual_normals(jedge, LAT)) * deg2rad};
-                Value avg[2];
-
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    Value u1 = vector(ip1, jlev, LON);
-                    Value u2 = vector(ip2, jlev, LON);
-                    Value v1 = vector(ip1, jlev, LAT) * cosy1;
-                    Value v2 = vector(ip2, jlev, LAT) * cosy2;
-
-                    avg[LON] = (u1 + u2) * 0.5;
-                    avg[LAT] = (v1 + v2) * 0.5;
-
-                    avgS(jedge, jlev, LONdLON) = avg[LON] * S[LON];
-                    avgS(jedge, jlev, LATdLAT) = avg[LAT] * S[LAT];
-                }
-            }
-
-            atlas_omp_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    div(jnode, jlev) = 0.;
-                }
-                for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
-                    idx_t iedge = node2edge(jnode, jedge);
-                    if (iedge < nedges) {
-                        Value add = node2edge_sign(jnode, jedge);
-                        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                            div(jnode, jlev) += add * (avgS(iedge, jlev, LONdLON) + avgS(iedge, jlev, LATdLAT));
-                        }
-                    }
-                }
-                const Value y = lonlat_deg(jnode, LAT) * deg2rad;
-                Value metric  = Value{1.} / (static_cast<Value>(dual_volumes(jnode)) * scale * std::cos(y));
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    div(jnode, jlev) *= metric;
-                }
-            }
-        }
-
-    };
-    ATLAS_ASSERT( vector_field.datatype() == div_field.datatype() );
-    switch (vector_field.datatype().kind()) {
-        case (DataType::KIND_REAL32): {
-            dispatch(float{});
-            break;
-        }
-        case (DataType::KIND_REAL64): {
-            dispatch(double{});
-            break;
-        }
-        default:
-            ATLAS_NOTIMPLEMENTED;
-    }
+void Nabla::divergence(const FieldSet& vector_fields, FieldSet& div_fields) const {
+    ATLAS_ASSERT(vector_fields.size() == div_fields.size());
+    std::vector<Field> div = to_vector(div_fields);
+    divergence_or_curl<false>(to_vector(vector_fields), div);
 }
 
 void Nabla::curl(const Field& vector_field, Field& curl_field) const {
-    auto dispatch = [&](auto value) {
-        using Value          = std::decay_t<decltype(value)>;
+    std::vector<Field> curl{curl_field};
+    divergence_or_curl<true>({vector_field}, curl);
+}
 
+void Nabla::curl(const FieldSet& vector_fields, FieldSet& curl_fields) const {
+    ATLAS_ASSERT(vector_fields.size() == curl_fields.size());
+    std::vector<Field> curl = to_vector(curl_fields);
+    divergence_or_curl<true>(to_vector(vector_fields), curl);
+}
 
-        const Value radius  = fvm_->radius();
-        const Value deg2rad = M_PI / 180.;
+template <bool Curl>
+void Nabla::divergence_or_curl(const std::vector<Field>& vector_fields, std::vector<Field>& out_fields) const {
+    auto dispatch = [&](auto value, const std::vector<Field>& in, std::vector<Field>& out) {
+        using Value = std::decay_t<decltype(value)>;
 
         const mesh::Edges& edges = fvm_->mesh().edges();
         const mesh::Nodes& nodes = fvm_->mesh().nodes();
 
-        const idx_t nnodes = fvm_->node_columns().nb_nodes();
-        const idx_t nedges = fvm_->edge_columns().nb_edges();
-
-        const auto vector =
-            vector_field.levels()
-                ? array::make_view<Value, 3>(vector_field).slice(Range::all(), Range::all(), Range::all())
-                : array::make_view<Value, 2>(vector_field).slice(Range::all(), Range::dummy(), Range::all());
-        auto curl = curl_field.levels() ? array::make_view<Value, 2>(curl_field).slice(Range::all(), Range::all())
-                                        : array::make_view<Value, 1>(curl_field).slice(Range::all(), Range::dummy());
-
-        const idx_t nlev = vector.shape(1);
-        if (curl.shape(1) != nlev) {
-            throw_AssertionFailed("curl field should have same number of levels", Here());
+        const idx_t nnodes  = fvm_->node_columns().nb_nodes();
+        const idx_t nedges  = fvm_->edge_columns().nb_edges();
+        const idx_t nfields = static_cast<idx_t>(in.size());
+
+        std::vector<decltype(make_vectorview<Value>(in[0]))> vectors;
+        std::vector<decltype(make_scalarview<Value>(out[0]))> outs;
+        for (idx_t jfield = 0; jfield < nfields; ++jfield) {
+            vectors.push_back(make_vectorview<Value>(in[jfield]));
+            outs.push_back(make_scalarview<Value>(out[jfield]));
+            if (outs.back().shape(1) != vectors.back().shape(1)) {
+                throw_AssertionFailed(Curl ? "curl field should have same number of levels"
+                                           : "div_field should have same number of levels",
+                                      Here());
+            }
         }
 
-        const auto lonlat_deg     = array::make_view<double, 2>(nodes.lonlat());
-        const auto dual_volumes   = array::make_view<double, 1>(nodes.field("dual_volumes"));
-        const auto dual_normals   = array::make_view<double, 2>(edges.field("dual_normals"));
+        const auto metric_x       = array::make_view<double, 1>(fvm_->metric_x());
+        const auto cos_lat        = array::make_view<double, 1>(fvm_->cos_lat());
+        const auto dual_normals   = array::make_view<double, 2>(fvm_->dual_normals());
         const auto node2edge_sign = array::make_view<double, 2>(nodes.field("node2edge_sign"));
         const auto edge_flags     = array::make_view<int, 1>(edges.flags());
         auto is_pole_edge         = [&](idx_t e) { return Topology::check(edge_flags(e), Topology::POLE); };
 
-
         const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
         const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
 
-        array::ArrayT<Value> avgS_arr(nedges, nlev, 2ul);
-        array::ArrayView<Value, 3> avgS = array::make_view<Value, 3>(avgS_arr);
-
-        const Value scale = deg2rad * deg2rad * radius;
-
-        enum
-        {
-            LONdLAT = 0,
-            LATdLON = 1
-        };
-
+        // The metric term cos(y) multiplies the wind component normal to the derivative: v for div, u for curl
+        constexpr idx_t metric_component = Curl ? LON : LAT;
 
         atlas_omp_parallel {
-            atlas_omp_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-                idx_t ip1 = edge2node(jedge, 0);
-                idx_t ip2 = edge2node(jedge, 1);
-                Value y1 = lonlat_deg(ip1, LAT) * deg2rad;
-                Value y2 = lonlat_deg(ip2, LAT) * deg2rad;
-
-                Value pbc = 1 - is_pole_edge(jedge);
-                Value cosy1;
-                Value cosy2;
-                if (metric_approach_ == 0) {
-                    cosy1 = std::cos(y1) * pbc;
-                    cosy2 = std::cos(y2) * pbc;
-                }
-                else {
-                    cosy1 = cosy2 = std::cos(Value{0.5} * (y1 + y2)) * pbc;
-                }
-
-                Value S[2] = {static_cast<Value>(dual_normals(jedge, LON)) * deg2rad, static_cast<Value>(dual_normals(jedge, LAT)) * deg2rad};
-                Value avg[2];
-
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    Value u1 = vector(ip1, jlev, LON) * cosy1;
-                    Value u2 = vector(ip2, jlev, LON) * cosy2;
-                    Value v1 = vector(ip1, jlev, LAT);
-                    Value v2 = vector(ip2, jlev, LAT);
-
-                    avg[LON] = (u1 + u2) * Value{0.5};
-                    avg[LAT] = (v1 + v2) * Value{0.5};
-
-                    avgS(jedge, jlev, LONdLAT) = avg[LON] * S[LAT];
-                    avgS(jedge, jlev, LATdLON) = avg[LAT] * S[LON];
-                }
-            }
-
+            std::vector<NodeEdge<Value>> node_edges(node2edge.maxcols());
             atlas_omp_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    curl(jnode, jlev) = 0.;
-                }
+                idx_t nb_edges = 0;
                 for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
-                    idx_t iedge = node2edge(jnode, jedge);
+                    const idx_t iedge = node2edge(jnode, jedge);
                     if (iedge < nedges) {
-                        double add = node2edge_sign(jnode, jedge);
-                        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                            curl(jnode, jlev) += add * (avgS(iedge, jlev, LATdLON) - avgS(iedge, jlev, LONdLAT));
+                        auto& edge      = node_edges[nb_edges++];
+                        edge.ip1        = edge2node(iedge, 0);
+                        edge.ip2        = edge2node(iedge, 1);
+                        edge.add        = node2edge_sign(jnode, jedge);
+                        edge.S[LON]     = dual_normals(iedge, LON);
+                        edge.S[LAT]     = dual_normals(iedge, LAT);
+                        const Value pbc = 1 - is_pole_edge(iedge);
+                        if (metric_approach_ == 0) {
+                            edge.cosy[0] = static_cast<Value>(cos_lat(edge.ip1)) * pbc;
+                            edge.cosy[1] = static_cast<Value>(cos_lat(edge.ip2)) * pbc;
+                        }
+                        else {
+                            edge.cosy[0] = edge.cosy[1] = static_cast<Value>(edge_cos_lat_[iedge]) * pbc;
                         }
                     }
                 }
-                Value y      = static_cast<Value>(lonlat_deg(jnode, LAT)) * deg2rad;
-                Value metric = Value{1.} / (static_cast<Value>(dual_volumes(jnode)) * scale * std::cos(y));
-                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                    curl(jnode, jlev) *= metric;
+                const Value metric = metric_x(jnode);
+
+                for (idx_t jfield = 0; jfield < nfields; ++jfield) {
+                    const auto& vector = vectors[jfield];
+                    auto& out          = outs[jfield];
+                    const idx_t nlev   = vector.shape(1);
+                    for (idx_t jlev0 = 0; jlev0 < nlev; jlev0 += level_block) {
+                        const idx_t nb = std::min(level_block, nlev - jlev0);
+                        Value sum[level_block]{};
+                        for (idx_t jedge = 0; jedge < nb_edges; ++jedge) {
+                            const auto& edge = node_edges[jedge];
+                            for (idx_t k = 0; k < nb; ++k) {
+                                const idx_t jlev = jlev0 + k;
+                                Value uv1[2]     = {vector(edge.ip1, jlev, LON), vector(edge.ip1, jlev, LAT)};
+                                Value uv2[2]     = {vector(edge.ip2, jlev, LON), vector(edge.ip2, jlev, LAT)};
+                                uv1[metric_component] *= edge.cosy[0];
+                                uv2[metric_component] *= edge.cosy[1];
+                                const Value avg_u = (uv1[LON] + uv2[LON]) * Value{0.5};
+                                const Value avg_v = (uv1[LAT] + uv2[LAT]) * Value{0.5};
+                                if constexpr (Curl) {
+                                    sum[k] += edge.add * (avg_v * edge.S[LON] - avg_u * edge.S[LAT]);
+                                }
+                                else {
+                                    sum[k] += edge.add * (avg_u * edge.S[LON] + avg_v * edge.S[LAT]);
+                                }
+                            }
+                        }
+                        for (idx_t k = 0; k < nb; ++k) {
+                            out(jnode, jlev0 + k) = sum[k] * metric;
+                        }
+                    }
                 }
             }
         }
     };
-    ATLAS_ASSERT( vector_field.datatype() == curl_field.datatype() );
-    switch (vector_field.datatype().kind()) {
-        case (DataType::KIND_REAL32): {
-            dispatch(float{});
-            break;
-        }
-        case (DataType::KIND_REAL64): {
-            dispatch(double{});
-            break;
-        }
-        default:
-            ATLAS_NOTIMPLEMENTED;
-    }
+    dispatch_by_datatype(vector_fields, out_fields, dispatch);
 }
 
 void Nabla::laplacian(const Field& scalar, Field& lapl) const {
@@ -567,6 +526,21 @@ void Nabla::laplacian(const Field& scalar, Field& lapl) const {
     divergence(grad, lapl);
 }
 
+void Nabla::laplacian(const FieldSet& scalars, FieldSet& lapls) const {
+    ATLAS_ASSERT(scalars.size() == lapls.size());
+    FieldSet grads;
+    for (idx_t i = 0; i < scalars.size(); ++i) {
+        grads.add(fvm_->node_columns().createField(option::name("grad[" + std::to_string(i) + "]") |
+                                                   option::levels(scalars[i].levels()) | option::variables(2) |
+                                                   option::datatype(scalars[i].datatype())));
+    }
+    gradient(scalars, grads);
+    if (fvm_->node_columns().halo().size() < 2) {
+        fvm_->node_columns().haloExchange(grads);
+    }
+    divergence(grads, lapls);
+}
+
 const FunctionSpace& Nabla::functionspace() const {
     return fvm_->node_columns();
 }
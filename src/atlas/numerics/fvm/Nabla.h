@@ -25,7 +25,8 @@ class Method;
 
 namespace atlas {
 class Field;
-}
+class FieldSet;
+}  // namespace atlas
 
 namespace atlas {
 namespace numerics {
@@ -42,17 +43,26 @@ public:
     virtual void curl(const Field& vector, Field& curl) const override;
     virtual void laplacian(const Field& scalar, Field& laplacian) const override;
 
+    virtual void gradient(const FieldSet& scalars, FieldSet& grads) const override;
+    virtual void divergence(const FieldSet& vectors, FieldSet& divs) const override;
+    virtual void curl(const FieldSet& vectors, FieldSet& curls) const override;
+    virtual void laplacian(const FieldSet& scalars, FieldSet& laplacians) const override;
+
     virtual const FunctionSpace& functionspace() const override;
 
 private:
     void setup();
 
-    void gradient_of_scalar(const Field& scalar, Field& grad) const;
+    void gradient_of_scalars(const std::vector<Field>& scalars, std::vector<Field>& grads) const;
     void gradient_of_vector(const Field& vector, Field& grad) const;
 
+    template <bool Curl>
+    void divergence_or_curl(const std::vector<Field>& vectors, std::vector<Field>& outputs) const;
+
 private:
     fvm::Method const* fvm_;
     std::vector<idx_t> pole_edges_;
+    std::vector<double> edge_cos_lat_;  // cos of mean latitude of edge nodes, for metric_approach != 0
     int metric_approach_{0};
 };
 #endif
@@ -28,6 +28,7 @@ void Checksum::setup(const std::string& mpi_comm, const int part[], const idx_t
     parsize_ = parsize;
     gather_  = util::ObjectHandle<GatherScatter>(new GatherScatter());
     gather_->setup(mpi_comm, part, remote_idx, base, glb_idx, parsize);
+    setup_points();
     is_setup_ = true;
 }
 
@@ -41,6 +42,7 @@ void Checksum::setup(const std::string& mpi_comm, const int part[], const idx_t
     parsize_ = parsize;
     gather_  = util::ObjectHandle<GatherScatter>(new GatherScatter());
     gather_->setup(mpi_comm, part, remote_idx, base, glb_idx, mask, parsize);
+    setup_points();
     is_setup_ = true;
 }
 
@@ -50,11 +52,25 @@ void Checksum::setup(const int part[], const idx_t remote_idx[], const int base,
 }
 
 void Checksum::setup(const util::ObjectHandle<GatherScatter>& gather) {
-    gather_   = gather;
-    parsize_  = gather->parsize_;
+    gather_  = gather;
+    parsize_ = gather->parsize_;
+    setup_points();
     is_setup_ = true;
 }
 
+void Checksum::setup_points() {
+    // The gather pattern contains, for each point owned by this partition, its local index and the rank of its
+    // global index among all unique global indices
+    const auto& locmap = gather_->locmap_;
+    const auto& glbmap = gather_->glbmap_;
+    const idx_t offset = gather_->glbdispls_[gather_->comm().rank()];
+    points_.assign(locmap.begin(), locmap.end());
+    keys_.resize(locmap.size());
+    for (size_t j = 0; j < locmap.size(); ++j) {
+        keys_[j] = glbmap[offset + j];
+    }
+}
+
 /////////////////////
 
 Checksum* atlas__Checksum__new() {
@@ -17,6 +17,7 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/Checksum.h"
 #include "atlas/util/Object.h"
 #include "atlas/util/ObjectHandle.h"
@@ -24,6 +25,10 @@
 namespace atlas {
 namespace parallel {
 
+/// @brief Checksum of a distributed field, independent of its partitioning
+///
+/// Each owned point is hashed together with the rank of its global index, and the hashes are summed in a single
+/// reduction, without gathering the field.
 class Checksum : public util::Object {
 public:
     Checksum();
@@ -96,36 +101,40 @@ public:  // methods
     void var_info(const array::ArrayView<DATA_TYPE, RANK>& arr, std::vector<int>& varstrides,
                   std::vector<int>& varextents) const;
 
+private:  // methods
+    void setup_points();
+
 private:  // data
     std::string name_;
     util::ObjectHandle<GatherScatter> gather_;
     bool is_setup_;
     size_t parsize_;
+    std::vector<idx_t> points_;  // local indices of points owned by this partition
+    std::vector<gidx_t> keys_;   // rank of the global index of each owned point, among all global indices
 };
 
 template <typename DATA_TYPE>
 std::string Checksum::execute(const DATA_TYPE data[], const int var_strides[], const int var_extents[],
                               const int var_rank) const {
-    idx_t root = 0;
-
     if (!is_setup_) {
         throw_Exception("Checksum was not setup", Here());
     }
-    std::vector<util::checksum_t> local_checksums(parsize_);
-    int var_size = var_extents[0] * var_strides[0];
-
-    for (size_t pp = 0; pp < parsize_; ++pp) {
-        local_checksums[pp] = util::checksum(data + pp * var_size, var_size);
+    const size_t var_size = var_extents[0] * var_strides[0];
+    const idx_t nb_points = static_cast<idx_t>(points_.size());
+
+    // Sum of hashes of owned points, seeded with their global rank. Addition modulo 2^64 is associative and
+    // commutative, so that the sum is independent of the order of points, threads and partitions.
+    util::checksum_t local_checksum = 0;
+    atlas_omp_parallel {
+        util::checksum_t thread_checksum = 0;
+        atlas_omp_for(idx_t j = 0; j < nb_points; ++j) {
+            thread_checksum += util::hash64(data + points_[j] * var_size, var_size * sizeof(DATA_TYPE), keys_[j]);
+        }
+        atlas_omp_critical { local_checksum += thread_checksum; }
     }
 
-    std::vector<util::checksum_t> global_checksums(gather_->comm().rank() == root ? gather_->glb_dof() : 0);
-    parallel::Field<util::checksum_t const> loc(local_checksums.data(), 1);
-    parallel::Field<util::checksum_t> glb(global_checksums.data(), 1);
-    gather_->gather(&loc, &glb, 1);
-
-    util::checksum_t glb_checksum = util::checksum(global_checksums.data(), global_checksums.size());
-
-    gather_->comm().broadcast(glb_checksum, root);
+    util::checksum_t glb_checksum = 0;
+    ATLAS_TRACE_MPI(ALLREDUCE) { gather_->comm().allReduce(local_checksum, glb_checksum, eckit::mpi::sum()); }
 
     return eckit::Translator<util::checksum_t, std::string>()(glb_checksum);
 }
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -258,6 +259,94 @@ void GatherScatter::setup(const std::string& mpi_comm, const int part[], const i
     setup(mpi_comm, part, remote_idx, base, glb_idx, mask.data(), parsize);
 }
 
+void GatherScatter::setup_writers(const std::vector<int>& writers) {
+    ATLAS_TRACE("GatherScatter::setup_writers");
+    if (!is_setup_) {
+        throw_Exception("GatherScatter was not setup", Here());
+    }
+    ATLAS_ASSERT(not writers.empty());
+    const idx_t nb_writers = static_cast<idx_t>(writers.size());
+    {
+        std::vector<int> sorted(writers);
+        std::sort(sorted.begin(), sorted.end());
+        ATLAS_ASSERT(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end(), "Writer ranks must be distinct");
+        ATLAS_ASSERT(sorted.front() >= 0 && sorted.back() < nproc);
+    }
+    writers_ = writers;
+    writer_  = static_cast<int>(std::find(writers.begin(), writers.end(), myproc) - writers.begin());
+    if (writer_ == nb_writers) {
+        writer_ = -1;
+    }
+
+    slab_displs_.resize(nb_writers + 1);
+    for (idx_t w = 0; w <= nb_writers; ++w) {
+        slab_displs_[w] = gidx_t(glbcnt_) * w / nb_writers;
+    }
+    auto slab_of = [&](gidx_t n) {
+        auto it = std::upper_bound(slab_displs_.begin(), slab_displs_.end(), n);
+        return static_cast<idx_t>(it - slab_displs_.begin()) - 1;
+    };
+
+    // glbmap_ holds for the k-th point sent by rank p its position in the global index space:
+    // glbmap_[glbdispls_[p] + k], which determines the slab, and hence the writer, of every point.
+
+    // Local points grouped by writer, in their order within locmap_
+    std::vector<idx_t> slab(loccnt_);
+    slab_sendcounts_.assign(nb_writers, 0);
+    for (idx_t k = 0; k < loccnt_; ++k) {
+        slab[k] = slab_of(glbmap_[glbdispls_[myproc] + k]);
+        ++slab_sendcounts_[slab[k]];
+    }
+    slab_senddispls_.assign(nb_writers, 0);
+    std::partial_sum(slab_sendcounts_.begin(), slab_sendcounts_.end() - 1, slab_senddispls_.begin() + 1);
+    slab_sendmap_.resize(loccnt_);
+    {
+        std::vector<int> next(slab_senddispls_);
+        for (idx_t k = 0; k < loccnt_; ++k) {
+            slab_sendmap_[next[slab[k]]++] = locmap_[k];
+        }
+    }
+
+    // Points of the slab of this rank grouped by sending rank, in the same order as they are sent
+    slab_recvcounts_.assign(nproc, 0);
+    slab_recvdispls_.assign(nproc, 0);
+    slab_recvmap_.clear();
+    if (writer_ >= 0) {
+        slab_recvmap_.reserve(slab_size());
+        for (idx_t jproc = 0; jproc < nproc; ++jproc) {
+            slab_recvdispls_[jproc] = static_cast<int>(slab_recvmap_.size());
+            for (idx_t k = 0; k < glbcounts_[jproc]; ++k) {
+                const gidx_t n = glbmap_[glbdispls_[jproc] + k];
+                if (n >= slab_displs_[writer_] && n < slab_displs_[writer_ + 1]) {
+                    slab_recvmap_.push_back(static_cast<int>(n - slab_displs_[writer_]));
+                }
+            }
+            slab_recvcounts_[jproc] = static_cast<int>(slab_recvmap_.size()) - slab_recvdispls_[jproc];
+        }
+    }
+}
+
+void GatherScatter::setup_writers(idx_t nb_writers) {
+    ATLAS_ASSERT(nb_writers > 0 && nb_writers <= nproc);
+    std::vector<int> writers(nb_writers);
+    for (idx_t w = 0; w < nb_writers; ++w) {
+        writers[w] = static_cast<int>(w * nproc / nb_writers);
+    }
+    setup_writers(writers);
+}
+
+idx_t GatherScatter::batch_end(const std::vector<idx_t>& var_sizes, idx_t begin, size_t value_size) const {
+    // Counts and displacements of the collectives are int, which also bounds the number of values per batch
+    const size_t max_values = std::min<size_t>(max_batch_bytes_ / value_size, std::numeric_limits<int>::max());
+    const idx_t nb_fields   = static_cast<idx_t>(var_sizes.size());
+    size_t nb_values        = size_t(glbcnt_) * var_sizes[begin];
+    idx_t end               = begin + 1;
+    while (end < nb_fields && nb_values + size_t(glbcnt_) * var_sizes[end] <= max_values) {
+        nb_values += size_t(glbcnt_) * var_sizes[end++];
+    }
+    return end;
+}
+
 /////////////////////
 
 GatherScatter* atlas__GatherScatter__new() {
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <functional>
 #include <numeric>
 #include <stdexcept>
 #include <type_traits>
@@ -18,9 +19,22 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/library/config.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Exception.h"
 #include "atlas/util/Object.h"
 
+namespace atlas {
+namespace parallel {
+class GatherScatter;
+}  // namespace parallel
+namespace io {
+class RecordReader;
+class RecordWriter;
+void encode(const parallel::GatherScatter&, RecordWriter&, const std::string& key);
+void decode(RecordReader&, parallel::GatherScatter&, const std::string& key);
+}  // namespace io
+}  // namespace atlas
+
 namespace atlas {
 namespace parallel {
 
@@ -180,21 +194,73 @@ public:  // methods
     void scatter(const array::ArrayView<DATA_TYPE, GRANK>& gdata, array::ArrayView<DATA_TYPE, LRANK>& ldata,
                  const idx_t root = 0) const;
 
+    /// @brief Setup gathering to, and scattering from, several writer ranks instead of a single root
+    ///
+    /// The global index space of glb_dof() points is split in contiguous slabs of nearly equal size, and slab w
+    /// is owned by rank writers[w]. A writer rank holds only its own slab, so that no rank needs memory for the
+    /// complete global field. Requires a prior setup().
+    /// @param [in] writers  Distinct ranks owning consecutive slabs
+    void setup_writers(const std::vector<int>& writers);
+
+    /// @brief Setup gathering to nb_writers ranks spread evenly over the communicator
+    void setup_writers(idx_t nb_writers);
+
+    /// @brief Gather fields into the slabs of the writer ranks, see setup_writers()
+    ///
+    /// On writer ranks, gfields hold slab_size() points, for the global points slab_begin(), ...
+    /// All fields are sent at once, and on writer ranks "gathered" is called with the index of each field as soon
+    /// as it is complete, so that a field can be processed while later fields are still being received.
+    template <typename DATA_TYPE>
+    void gather_to_writers(parallel::Field<DATA_TYPE const> lfields[], parallel::Field<DATA_TYPE> gfields[],
+                           const idx_t nb_fields, const std::function<void(idx_t)>& gathered = nullptr) const;
+
+    /// @brief Scatter fields from the slabs of the writer ranks, counterpart of gather_to_writers()
+    template <typename DATA_TYPE>
+    void scatter_from_writers(parallel::Field<DATA_TYPE const> gfields[], parallel::Field<DATA_TYPE> lfields[],
+                              const idx_t nb_fields) const;
+
+    /// @brief First global point of the slab of this rank, 0 if this rank is not a writer
+    gidx_t slab_begin() const { return writer_ < 0 ? 0 : slab_displs_[writer_]; }
+
+    /// @brief Number of global points in the slab of this rank, 0 if this rank is not a writer
+    idx_t slab_size() const { return writer_ < 0 ? 0 : idx_t(slab_displs_[writer_ + 1] - slab_displs_[writer_]); }
+
     gidx_t glb_dof() const { return glbcnt_; }
 
     idx_t loc_dof() const { return loccnt_; }
 
+    /// @brief Set the maximum size in bytes of the global buffer of one collective of the multi-field gather()
+    ///        and scatter()
+    ///
+    /// Fields are packed together and communicated in as few collectives as this bound allows, with at least
+    /// one field per collective. Must be equal on all ranks.
+    void max_batch_bytes(size_t bytes) { max_batch_bytes_ = bytes; }
+
+    size_t max_batch_bytes() const { return max_batch_bytes_; }
+
     const mpi::Comm& comm() const { return *comm_; }
 
 private:  // methods
+    /// Pack the values of point sendmap[p] starting at send_buffer[p * buffer_stride]
     template <typename DATA_TYPE>
     void pack_send_buffer(const parallel::Field<DATA_TYPE const>& field, const std::vector<int>& sendmap,
-                          DATA_TYPE send_buffer[]) const;
+                          DATA_TYPE send_buffer[], const idx_t buffer_stride) const;
 
+    /// Unpack the values of point recvmap[p] starting at recv_buffer[p * buffer_stride]
     template <typename DATA_TYPE>
-    void unpack_recv_buffer(const std::vector<int>& recvmap, const DATA_TYPE recv_buffer[],
+    void unpack_recv_buffer(const std::vector<int>& recvmap, const DATA_TYPE recv_buffer[], const idx_t buffer_stride,
                             const parallel::Field<DATA_TYPE>& field) const;
 
+    /// Number of values per point of a field
+    template <typename DATA_TYPE>
+    static idx_t var_size(const parallel::Field<DATA_TYPE>& field) {
+        return std::accumulate(field.var_shape.data(), field.var_shape.data() + field.var_rank, idx_t{1},
+                               std::multiplies<idx_t>());
+    }
+
+    /// End of the batch of fields starting at field begin, which are communicated together in one collective
+    idx_t batch_end(const std::vector<idx_t>& var_sizes, idx_t begin, size_t value_size) const;
+
     template <typename DATA_TYPE, int RANK>
     void var_info(const array::ArrayView<DATA_TYPE, RANK>& arr, std::vector<idx_t>& varstrides,
                   std::vector<idx_t>& varshape) const;
@@ -215,7 +281,23 @@ private:  // data
     bool is_setup_;
 
     idx_t parsize_;
+
+    size_t max_batch_bytes_{size_t(256) * 1024 * 1024};
+
+    // Gathering to writer ranks, see setup_writers()
+    std::vector<int> writers_;
+    int writer_{-1};                      // index of this rank in writers_, or -1
+    std::vector<gidx_t> slab_displs_;     // slab of writer w spans global points [slab_displs_[w], slab_displs_[w+1])
+    std::vector<int> slab_sendmap_;       // local points, in order of writer
+    std::vector<int> slab_sendcounts_;    // number of local points per writer
+    std::vector<int> slab_senddispls_;
+    std::vector<int> slab_recvmap_;       // points within the slab of this rank, in order of sending rank
+    std::vector<int> slab_recvcounts_;    // number of slab points per sending rank
+    std::vector<int> slab_recvdispls_;
+
     friend class Checksum;
+    friend void io::encode(const GatherScatter&, io::RecordWriter&, const std::string& key);
+    friend void io::decode(io::RecordReader&, GatherScatter&, const std::string& key);
 
     size_t glb_cnt(idx_t root) const { return myproc == root ? glbcnt_ : 0; }
 };
@@ -229,28 +311,35 @@ void GatherScatter::gather(parallel::Field<DATA_TYPE const> lfields[], parallel:
         throw_Exception("GatherScatter was not setup", Here());
     }
 
+    std::vector<idx_t> lvar_sizes(nb_fields);
+    std::vector<idx_t> gvar_sizes(nb_fields);
     for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
-        const idx_t lvar_size =
-            std::accumulate(lfields[jfield].var_shape.data(),
-                            lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1, std::multiplies<idx_t>());
-        const idx_t gvar_size =
-            std::accumulate(gfields[jfield].var_shape.data(),
-                            gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1, std::multiplies<idx_t>());
-        const size_t loc_size = loccnt_ * lvar_size;
-        const size_t glb_size = glb_cnt(root) * gvar_size;
-        std::vector<DATA_TYPE> loc_buffer(loc_size);
-        std::vector<DATA_TYPE> glb_buffer(glb_size);
-        std::vector<int> glb_displs(nproc);
-        std::vector<int> glb_counts(nproc);
+        lvar_sizes[jfield] = var_size(lfields[jfield]);
+        gvar_sizes[jfield] = var_size(gfields[jfield]);
+    }
+
+    std::vector<DATA_TYPE> loc_buffer;
+    std::vector<DATA_TYPE> glb_buffer;
+    std::vector<int> glb_displs(nproc);
+    std::vector<int> glb_counts(nproc);
+
+    for (idx_t jbegin = 0, jend = 0; jbegin < nb_fields; jbegin = jend) {
+        jend                    = batch_end(lvar_sizes, jbegin, sizeof(DATA_TYPE));
+        const idx_t lbatch_size = std::accumulate(lvar_sizes.begin() + jbegin, lvar_sizes.begin() + jend, idx_t{0});
+        const idx_t gbatch_size = std::accumulate(gvar_sizes.begin() + jbegin, gvar_sizes.begin() + jend, idx_t{0});
+        loc_buffer.resize(loccnt_ * lbatch_size);
+        glb_buffer.resize(glb_cnt(root) * gbatch_size);
 
         for (idx_t jproc = 0; jproc < nproc; ++jproc) {
-            glb_counts[jproc] = glbcounts_[jproc] * gvar_size;
-            glb_displs[jproc] = glbdispls_[jproc] * gvar_size;
+            glb_counts[jproc] = glbcounts_[jproc] * gbatch_size;
+            glb_displs[jproc] = glbdispls_[jproc] * gbatch_size;
         }
 
-        /// Pack
+        /// Pack, with the values of all fields of the batch contiguous per point
 
-        pack_send_buffer(lfields[jfield], locmap_, loc_buffer.data());
+        for (idx_t jfield = jbegin, offset = 0; jfield < jend; offset += lvar_sizes[jfield++]) {
+            pack_send_buffer(lfields[jfield], locmap_, loc_buffer.data() + offset, lbatch_size);
+        }
 
         /// Gather
 
@@ -259,8 +348,11 @@ void GatherScatter::gather(parallel::Field<DATA_TYPE const> lfields[], parallel:
         }
 
         /// Unpack
-        if (myproc == root)
-            unpack_recv_buffer(glbmap_, glb_buffer.data(), gfields[jfield]);
+        if (myproc == root) {
+            for (idx_t jfield = jbegin, offset = 0; jfield < jend; offset += gvar_sizes[jfield++]) {
+                unpack_recv_buffer(glbmap_, glb_buffer.data() + offset, gbatch_size, gfields[jfield]);
+            }
+        }
     }
 }
 
@@ -280,28 +372,36 @@ void GatherScatter::scatter(parallel::Field<DATA_TYPE const> gfields[], parallel
         throw_Exception("GatherScatter was not setup", Here());
     }
 
+    std::vector<idx_t> lvar_sizes(nb_fields);
+    std::vector<idx_t> gvar_sizes(nb_fields);
     for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
-        const int lvar_size =
-            std::accumulate(lfields[jfield].var_shape.data(),
-                            lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1, std::multiplies<int>());
-        const int gvar_size =
-            std::accumulate(gfields[jfield].var_shape.data(),
-                            gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1, std::multiplies<int>());
-        const size_t loc_size = loccnt_ * lvar_size;
-        const size_t glb_size = glb_cnt(root) * gvar_size;
-        std::vector<DATA_TYPE> loc_buffer(loc_size);
-        std::vector<DATA_TYPE> glb_buffer(glb_size);
-        std::vector<int> glb_displs(nproc);
-        std::vector<int> glb_counts(nproc);
+        lvar_sizes[jfield] = var_size(lfields[jfield]);
+        gvar_sizes[jfield] = var_size(gfields[jfield]);
+    }
+
+    std::vector<DATA_TYPE> loc_buffer;
+    std::vector<DATA_TYPE> glb_buffer;
+    std::vector<int> glb_displs(nproc);
+    std::vector<int> glb_counts(nproc);
+
+    for (idx_t jbegin = 0, jend = 0; jbegin < nb_fields; jbegin = jend) {
+        jend                    = batch_end(lvar_sizes, jbegin, sizeof(DATA_TYPE));
+        const idx_t lbatch_size = std::accumulate(lvar_sizes.begin() + jbegin, lvar_sizes.begin() + jend, idx_t{0});
+        const idx_t gbatch_size = std::accumulate(gvar_sizes.begin() + jbegin, gvar_sizes.begin() + jend, idx_t{0});
+        loc_buffer.resize(loccnt_ * lbatch_size);
+        glb_buffer.resize(glb_cnt(root) * gbatch_size);
 
         for (idx_t jproc = 0; jproc < nproc; ++jproc) {
-            glb_counts[jproc] = glbcounts_[jproc] * gvar_size;
-            glb_displs[jproc] = glbdispls_[jproc] * gvar_size;
+            glb_counts[jproc] = glbcounts_[jproc] * gbatch_size;
+            glb_displs[jproc] = glbdispls_[jproc] * gbatch_size;
         }
 
-        /// Pack
-        if (myproc == root)
-            pack_send_buffer(gfields[jfield], glbmap_, glb_buffer.data());
+        /// Pack, with the values of all fields of the batch contiguous per point
+        if (myproc == root) {
+            for (idx_t jfield = jbegin, offset = 0; jfield < jend; offset += gvar_sizes[jfield++]) {
+                pack_send_buffer(gfields[jfield], glbmap_, glb_buffer.data() + offset, gbatch_size);
+            }
+        }
 
         /// Scatter
 
@@ -311,7 +411,9 @@ void GatherScatter::scatter(parallel::Field<DATA_TYPE const> gfields[], parallel
         }
 
         /// Unpack
-        unpack_recv_buffer(locmap_, loc_buffer.data(), lfields[jfield]);
+        for (idx_t jfield = jbegin, offset = 0; jfield < jend; offset += lvar_sizes[jfield++]) {
+            unpack_recv_buffer(locmap_, loc_buffer.data() + offset, lbatch_size, lfields[jfield]);
+        }
     }
 }
 
@@ -325,17 +427,153 @@ void GatherScatter::scatter(const DATA_TYPE gdata[], const idx_t gvar_strides[],
 }
 
 template <typename DATA_TYPE>
-void GatherScatter::pack_send_buffer(const parallel::Field<DATA_TYPE const>& field, const std::vector<int>& sendmap,
-                                     DATA_TYPE send_buffer[]) const {
-    const idx_t sendcnt = static_cast<idx_t>(sendmap.size());
+void GatherScatter::gather_to_writers(parallel::Field<DATA_TYPE const> lfields[], parallel::Field<DATA_TYPE> gfields[],
+                                      const idx_t nb_fields, const std::function<void(idx_t)>& gathered) const {
+    if (writers_.empty()) {
+        throw_Exception("GatherScatter was not setup for writers", Here());
+    }
+    const idx_t nb_writers = static_cast<idx_t>(writers_.size());
+
+    std::vector<std::vector<DATA_TYPE>> loc_buffers(nb_fields);
+    std::vector<std::vector<DATA_TYPE>> glb_buffers(nb_fields);
+    std::vector<std::vector<eckit::mpi::Request>> recv_requests(nb_fields);
+    std::vector<eckit::mpi::Request> send_requests;
+
+    /// Post receives of all fields, using the field index as tag
+    ATLAS_TRACE_MPI(IRECEIVE) {
+        for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+            const idx_t gvar_size = std::accumulate(gfields[jfield].var_shape.data(),
+                                                    gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1,
+                                                    std::multiplies<idx_t>());
+            glb_buffers[jfield].resize(slab_recvmap_.size() * gvar_size);
+            for (idx_t jproc = 0; jproc < nproc; ++jproc) {
+                if (slab_recvcounts_[jproc] > 0) {
+                    recv_requests[jfield].push_back(
+                        comm().iReceive(glb_buffers[jfield].data() + slab_recvdispls_[jproc] * gvar_size,
+                                        slab_recvcounts_[jproc] * gvar_size, jproc, jfield));
+                }
+            }
+        }
+    }
 
-    idx_t ibuf              = 0;
+    /// Pack and send field by field
+    for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+        const idx_t lvar_size =
+            std::accumulate(lfields[jfield].var_shape.data(),
+                            lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1, std::multiplies<idx_t>());
+        loc_buffers[jfield].resize(slab_sendmap_.size() * lvar_size);
+        pack_send_buffer(lfields[jfield], slab_sendmap_, loc_buffers[jfield].data(), lvar_size);
+        ATLAS_TRACE_MPI(ISEND) {
+            for (idx_t w = 0; w < nb_writers; ++w) {
+                if (slab_sendcounts_[w] > 0) {
+                    send_requests.push_back(comm().iSend(loc_buffers[jfield].data() + slab_senddispls_[w] * lvar_size,
+                                                         slab_sendcounts_[w] * lvar_size, writers_[w], jfield));
+                }
+            }
+        }
+    }
+
+    /// Unpack each field once all of its parts have arrived
+    for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+        ATLAS_TRACE_MPI(WAIT) {
+            for (auto& request : recv_requests[jfield]) {
+                comm().wait(request);
+            }
+        }
+        if (writer_ >= 0) {
+            unpack_recv_buffer(slab_recvmap_, glb_buffers[jfield].data(), var_size(gfields[jfield]), gfields[jfield]);
+            glb_buffers[jfield] = std::vector<DATA_TYPE>();
+            if (gathered) {
+                gathered(jfield);
+            }
+        }
+    }
+
+    ATLAS_TRACE_MPI(WAIT) {
+        for (auto& request : send_requests) {
+            comm().wait(request);
+        }
+    }
+}
+
+template <typename DATA_TYPE>
+void GatherScatter::scatter_from_writers(parallel::Field<DATA_TYPE const> gfields[],
+                                         parallel::Field<DATA_TYPE> lfields[], const idx_t nb_fields) const {
+    if (writers_.empty()) {
+        throw_Exception("GatherScatter was not setup for writers", Here());
+    }
+    const idx_t nb_writers = static_cast<idx_t>(writers_.size());
+
+    std::vector<std::vector<DATA_TYPE>> loc_buffers(nb_fields);
+    std::vector<std::vector<DATA_TYPE>> glb_buffers(nb_fields);
+    std::vector<std::vector<eckit::mpi::Request>> recv_requests(nb_fields);
+    std::vector<eckit::mpi::Request> send_requests;
+
+    /// Post receives of all fields, using the field index as tag
+    ATLAS_TRACE_MPI(IRECEIVE) {
+        for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+            const idx_t lvar_size = std::accumulate(lfields[jfield].var_shape.data(),
+                                                    lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1,
+                                                    std::multiplies<idx_t>());
+            loc_buffers[jfield].resize(slab_sendmap_.size() * lvar_size);
+            for (idx_t w = 0; w < nb_writers; ++w) {
+                if (slab_sendcounts_[w] > 0) {
+                    recv_requests[jfield].push_back(
+                        comm().iReceive(loc_buffers[jfield].data() + slab_senddispls_[w] * lvar_size,
+                                        slab_sendcounts_[w] * lvar_size, writers_[w], jfield));
+                }
+            }
+        }
+    }
+
+    /// Writers pack and send field by field
+    if (writer_ >= 0) {
+        for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+            const idx_t gvar_size = std::accumulate(gfields[jfield].var_shape.data(),
+                                                    gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1,
+                                                    std::multiplies<idx_t>());
+            glb_buffers[jfield].resize(slab_recvmap_.size() * gvar_size);
+            pack_send_buffer(gfields[jfield], slab_recvmap_, glb_buffers[jfield].data(), gvar_size);
+            ATLAS_TRACE_MPI(ISEND) {
+                for (idx_t jproc = 0; jproc < nproc; ++jproc) {
+                    if (slab_recvcounts_[jproc] > 0) {
+                        send_requests.push_back(
+                            comm().iSend(glb_buffers[jfield].data() + slab_recvdispls_[jproc] * gvar_size,
+                                         slab_recvcounts_[jproc] * gvar_size, jproc, jfield));
+                    }
+                }
+            }
+        }
+    }
+
+    /// Unpack each field once all of its parts have arrived
+    for (idx_t jfield = 0; jfield < nb_fields; ++jfield) {
+        ATLAS_TRACE_MPI(WAIT) {
+            for (auto& request : recv_requests[jfield]) {
+                comm().wait(request);
+            }
+        }
+        unpack_recv_buffer(slab_sendmap_, loc_buffers[jfield].data(), var_size(lfields[jfield]), lfields[jfield]);
+    }
+
+    ATLAS_TRACE_MPI(WAIT) {
+        for (auto& request : send_requests) {
+            comm().wait(request);
+        }
+    }
+}
+
+template <typename DATA_TYPE>
+void GatherScatter::pack_send_buffer(const parallel::Field<DATA_TYPE const>& field, const std::vector<int>& sendmap,
+                                     DATA_TYPE send_buffer[], const idx_t buffer_stride) const {
+    const idx_t sendcnt     = static_cast<idx_t>(sendmap.size());
     const idx_t send_stride = field.var_strides[0] * field.var_shape[0];
 
     switch (field.var_rank) {
         case 1:
-            for (idx_t p = 0; p < sendcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < sendcnt; ++p) {
                 const idx_t pp = send_stride * sendmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     DATA_TYPE tmp       = field.data[pp + i * field.var_strides[0]];
                     send_buffer[ibuf++] = tmp;
@@ -343,8 +581,9 @@ void GatherScatter::pack_send_buffer(const parallel::Field<DATA_TYPE const>& fie
             }
             break;
         case 2:
-            for (idx_t p = 0; p < sendcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < sendcnt; ++p) {
                 const idx_t pp = send_stride * sendmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     const idx_t ii = pp + i * field.var_strides[0];
                     for (idx_t j = 0; j < field.var_shape[1]; ++j) {
@@ -354,8 +593,9 @@ void GatherScatter::pack_send_buffer(const parallel::Field<DATA_TYPE const>& fie
             }
             break;
         case 3:
-            for (idx_t p = 0; p < sendcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < sendcnt; ++p) {
                 const idx_t pp = send_stride * sendmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     const idx_t ii = pp + i * field.var_strides[0];
                     for (idx_t j = 0; j < field.var_shape[1]; ++j) {
@@ -374,24 +614,24 @@ void GatherScatter::pack_send_buffer(const parallel::Field<DATA_TYPE const>& fie
 
 template <typename DATA_TYPE>
 void GatherScatter::unpack_recv_buffer(const std::vector<int>& recvmap, const DATA_TYPE recv_buffer[],
-                                       const parallel::Field<DATA_TYPE>& field) const {
-    const idx_t recvcnt = static_cast<idx_t>(recvmap.size());
-
-    size_t ibuf             = 0;
+                                       const idx_t buffer_stride, const parallel::Field<DATA_TYPE>& field) const {
+    const idx_t recvcnt     = static_cast<idx_t>(recvmap.size());
     const idx_t recv_stride = field.var_strides[0] * field.var_shape[0];
 
     switch (field.var_rank) {
         case 1:
-            for (idx_t p = 0; p < recvcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < recvcnt; ++p) {
                 const idx_t pp = recv_stride * recvmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     field.data[pp + i * field.var_strides[0]] = recv_buffer[ibuf++];
                 }
             }
             break;
         case 2:
-            for (idx_t p = 0; p < recvcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < recvcnt; ++p) {
                 const idx_t pp = recv_stride * recvmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     const idx_t ii = pp + i * field.var_strides[0];
                     for (idx_t j = 0; j < field.var_shape[1]; ++j) {
@@ -401,8 +641,9 @@ void GatherScatter::unpack_recv_buffer(const std::vector<int>& recvmap, const DA
             }
             break;
         case 3:
-            for (idx_t p = 0; p < recvcnt; ++p) {
+            atlas_omp_parallel_for(idx_t p = 0; p < recvcnt; ++p) {
                 const idx_t pp = recv_stride * recvmap[p];
+                size_t ibuf    = size_t(p) * buffer_stride;
                 for (idx_t i = 0; i < field.var_shape[0]; ++i) {
                     const idx_t ii = pp + i * field.var_strides[0];
                     for (idx_t j = 0; j < field.var_shape[1]; ++j) {
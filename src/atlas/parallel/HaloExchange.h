@@ -37,6 +37,18 @@
 #include "atlas/parallel/HaloExchangeCUDA.h"
 #endif
 
+namespace atlas {
+namespace parallel {
+class HaloExchange;
+}  // namespace parallel
+namespace io {
+class RecordReader;
+class RecordWriter;
+void encode(const parallel::HaloExchange&, RecordWriter&, const std::string& key);
+void decode(RecordReader&, parallel::HaloExchange&, const std::string& key);
+}  // namespace io
+}  // namespace atlas
+
 namespace atlas {
 namespace parallel {
 
@@ -146,6 +158,10 @@ public:
     struct Backdoor {
         int parsize;
     } backdoor;
+
+private:
+    friend void io::encode(const HaloExchange&, io::RecordWriter&, const std::string& key);
+    friend void io::decode(io::RecordReader&, HaloExchange&, const std::string& key);
 };
 
 template <typename DATA_TYPE, int RANK, typename ParallelDim>
@@ -5,7 +5,13 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <numeric>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 #include "atlas/field/Field.h"
@@ -15,6 +21,7 @@
 #include "atlas/functionspace/PointCloud.h"
 #include "atlas/functionspace/StructuredColumns.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/redistribution/detail/RedistributeGeneric.h"
 #include "atlas/redistribution/detail/RedistributionImplFactory.h"
 #include "atlas/util/Unique.h"
@@ -30,7 +37,7 @@ using mesh::Nodes;
 // Helper type definitions and functions for redistribution.
 namespace {
 
-// Define index-UID struct. (Needed to overload "<").
+// Define index-UID struct.
 struct IdxUid : public std::pair<idx_t, uidx_t> {
     using std::pair<idx_t, uidx_t>::pair;
 };
@@ -128,163 +135,300 @@ std::vector<IdxUid> getUidVec(const FunctionSpace& functionspace) {
     return uidVec;
 }
 
-// Copy UID index
-std::vector<idx_t> getUidIdx(const std::vector<IdxUid>& uidVec) {
-    auto idxVec = std::vector<idx_t>{};
-    idxVec.reserve(uidVec.size());
-    std::transform(uidVec.begin(), uidVec.end(), std::back_inserter(idxVec),
-                   [](const IdxUid& uid) { return uid.first; });
-    return idxVec;
+// Directory PE which matches source and target UIDs with this value.
+int directoryRank(uidx_t uid, int nparts) {
+    // Fibonacci hashing, spreading contiguous global indices as well as lonlat hashes evenly over PEs.
+    const auto hash = static_cast<std::uint64_t>(uid) * std::uint64_t(0x9E3779B97F4A7C15);
+    return static_cast<int>((hash >> 32) % static_cast<std::uint64_t>(nparts));
 }
 
-// Copy UID value
-std::vector<uidx_t> getUidVal(const std::vector<IdxUid>& uidVec) {
-    auto valVec = std::vector<uidx_t>{};
-    valVec.reserve(uidVec.size());
-    std::transform(uidVec.begin(), uidVec.end(), std::back_inserter(valVec),
-                   [](const IdxUid& uid) { return uid.second; });
-    return valVec;
-}
-
-// Communicate UID values, return receive buffer and displacements.
-std::pair<std::vector<uidx_t>, std::vector<int>> communicateUid(const std::string& mpi_comm, const std::vector<uidx_t>& sendBuffer) {
-    auto& comm = mpi::comm(mpi_comm);
-    auto counts = std::vector<int>(comm.size());
-    comm.allGather(static_cast<int>(sendBuffer.size()), counts.begin(), counts.end());
-
-    auto disps = std::vector<int>{};
-    disps.reserve(comm.size() + 1);
-    disps.push_back(0);
-    std::partial_sum(counts.begin(), counts.end(), std::back_inserter(disps));
-
-
-    auto recvBuffer = std::vector<uidx_t>(static_cast<size_t>(disps.back()));
-
-    comm.allGatherv(sendBuffer.begin(), sendBuffer.end(), recvBuffer.begin(), counts.data(), disps.data());
+// For each local source and target UID, find the PE owning the same UID in the other functionspace.
+// Every UID is sent to a directory PE determined by its value, where source and target UIDs are matched, and
+// the PE of the match is sent back. No PE holds more than its own share of the UIDs. Returns the partner PEs
+// of sourceUids and targetUids, in the same order; -1 if a UID has no match.
+std::pair<std::vector<int>, std::vector<int>> getUidPartners(const std::string& mpi_comm,
+                                                             const std::vector<IdxUid>& sourceUids,
+                                                             const std::vector<IdxUid>& targetUids) {
+    const auto& comm = mpi::comm(mpi_comm);
+    const int nparts = static_cast<int>(comm.size());
+
+    const size_t nbSource = sourceUids.size();
+    const size_t nbTarget = targetUids.size();
+
+    // Directory PE of each local UID, source UIDs first.
+    auto directory = std::vector<int>(nbSource + nbTarget);
+    for (size_t i = 0; i < nbSource; ++i) {
+        directory[i] = directoryRank(sourceUids[i].second, nparts);
+    }
+    for (size_t i = 0; i < nbTarget; ++i) {
+        directory[nbSource + i] = directoryRank(targetUids[i].second, nparts);
+    }
 
-    return std::make_pair(recvBuffer, disps);
-}
+    // Number of source and target UIDs sent to each PE, interleaved.
+    auto sendCounts = std::vector<int>(2 * nparts, 0);
+    for (size_t i = 0; i < directory.size(); ++i) {
+        ++sendCounts[2 * directory[i] + (i < nbSource ? 0 : 1)];
+    }
+    auto recvCounts = std::vector<int>(2 * nparts, 0);
+    ATLAS_TRACE_MPI(ALLTOALL) { comm.allToAll(sendCounts, recvCounts); }
+
+    // Totals and displacements per PE. Per PE, source UIDs precede target UIDs.
+    auto sendTotals = std::vector<int>(nparts);
+    auto recvTotals = std::vector<int>(nparts);
+    auto sendDisps  = std::vector<int>(nparts, 0);
+    auto recvDisps  = std::vector<int>(nparts, 0);
+    for (int p = 0; p < nparts; ++p) {
+        sendTotals[p] = sendCounts[2 * p] + sendCounts[2 * p + 1];
+        recvTotals[p] = recvCounts[2 * p] + recvCounts[2 * p + 1];
+        if (p > 0) {
+            sendDisps[p] = sendDisps[p - 1] + sendTotals[p - 1];
+            recvDisps[p] = recvDisps[p - 1] + recvTotals[p - 1];
+        }
+    }
 
-// Need to overload "<" operator for comparison of asymmetric types in
-// std::set_intersection.
-bool operator<(const IdxUid& lhs, const uidx_t& rhs) {
-    return lhs.second < rhs;
-}
-bool operator<(const uidx_t& lhs, const IdxUid& rhs) {
-    return lhs < rhs.second;
-}
+    // Pack UIDs, remembering the position of each local UID in the send buffer.
+    auto slot       = std::vector<int>(directory.size());
+    auto sendBuffer = std::vector<uidx_t>(directory.size());
+    {
+        auto next = std::vector<int>(2 * nparts);
+        for (int p = 0; p < nparts; ++p) {
+            next[2 * p]     = sendDisps[p];
+            next[2 * p + 1] = sendDisps[p] + sendCounts[2 * p];
+        }
+        for (size_t i = 0; i < directory.size(); ++i) {
+            slot[i]             = next[2 * directory[i] + (i < nbSource ? 0 : 1)]++;
+            sendBuffer[slot[i]] = i < nbSource ? sourceUids[i].second : targetUids[i - nbSource].second;
+        }
+    }
 
-// Find the intersection between local and global UIDs, then return local
-// indices of incections and PE dispacements in vector.
-std::pair<std::vector<idx_t>, std::vector<int>> getUidIntersection(const std::string& mpi_comm,
-                                                                   const std::vector<IdxUid>& localUids,
-                                                                   const std::vector<uidx_t>& globalUids,
-                                                                   const std::vector<int>& globalDisps) {
-    auto uidIntersection = std::vector<IdxUid>{};
-    uidIntersection.reserve(localUids.size());
+    auto recvBuffer = std::vector<uidx_t>(static_cast<size_t>(recvDisps.back() + recvTotals.back()));
+    ATLAS_TRACE_MPI(ALLTOALL) {
+        comm.allToAllv(sendBuffer.data(), sendTotals.data(), sendDisps.data(), recvBuffer.data(), recvTotals.data(),
+                       recvDisps.data());
+    }
 
-    auto& comm = mpi::comm(mpi_comm);
-    auto mpi_size = comm.size();
+    // Match received source and target UIDs. Entries are (UID, PE of origin, position in receive buffer).
+    struct Entry {
+        uidx_t uid;
+        int part;
+        int pos;
+    };
+    auto sourceEntries = std::vector<Entry>{};
+    auto targetEntries = std::vector<Entry>{};
+    for (int p = 0; p < nparts; ++p) {
+        const int sourceEnd = recvDisps[p] + recvCounts[2 * p];
+        for (int pos = recvDisps[p]; pos < sourceEnd; ++pos) {
+            sourceEntries.push_back(Entry{recvBuffer[pos], p, pos});
+        }
+        for (int pos = sourceEnd; pos < recvDisps[p] + recvTotals[p]; ++pos) {
+            targetEntries.push_back(Entry{recvBuffer[pos], p, pos});
+        }
+    }
+    auto byUid = [](const Entry& a, const Entry& b) { return a.uid < b.uid; };
+    std::sort(sourceEntries.begin(), sourceEntries.end(), byUid);
+    std::sort(targetEntries.begin(), targetEntries.end(), byUid);
 
-    auto disps = std::vector<int>{};
-    disps.reserve(mpi_size + 1);
-    disps.push_back(0);
+    if (ATLAS_BUILD_TYPE_DEBUG) {
+        auto equalUid = [](const Entry& a, const Entry& b) { return a.uid == b.uid; };
+        ATLAS_ASSERT(std::adjacent_find(sourceEntries.begin(), sourceEntries.end(), equalUid) == sourceEntries.end(),
+                     "Source unique ID set has duplicate members");
+        ATLAS_ASSERT(std::adjacent_find(targetEntries.begin(), targetEntries.end(), equalUid) == targetEntries.end(),
+                     "Target unique ID set has duplicate members");
+    }
 
-    // Loop over all PE and find UID intersection.
-    for (size_t i = 0; i < mpi_size; ++i) {
-        // Get displaced iterators.
-        auto globalUidsBegin = globalUids.begin() + globalDisps[i];
-        auto globalUidsEnd   = globalUids.begin() + globalDisps[i + 1];
+    // Reply with the PE of the matching UID, in place of the received UID.
+    auto replyBuffer = std::vector<int>(recvBuffer.size(), -1);
+    auto targetIt    = targetEntries.begin();
+    for (const auto& sourceEntry : sourceEntries) {
+        while (targetIt != targetEntries.end() && targetIt->uid < sourceEntry.uid) {
+            ++targetIt;
+        }
+        if (targetIt != targetEntries.end() && targetIt->uid == sourceEntry.uid) {
+            replyBuffer[sourceEntry.pos] = targetIt->part;
+            replyBuffer[targetIt->pos]   = sourceEntry.part;
+        }
+    }
 
-        // Get intersection.
-        std::set_intersection(localUids.begin(), localUids.end(), globalUidsBegin, globalUidsEnd,
-                              std::back_inserter(uidIntersection));
+    auto partnerBuffer = std::vector<int>(sendBuffer.size());
+    ATLAS_TRACE_MPI(ALLTOALL) {
+        comm.allToAllv(replyBuffer.data(), recvTotals.data(), recvDisps.data(), partnerBuffer.data(),
+                       sendTotals.data(), sendDisps.data());
+    }
 
-        // Set intersection displacement.
-        disps.push_back(static_cast<int>(uidIntersection.size()));
+    auto sourcePartners = std::vector<int>(nbSource);
+    auto targetPartners = std::vector<int>(nbTarget);
+    for (size_t i = 0; i < nbSource; ++i) {
+        sourcePartners[i] = partnerBuffer[slot[i]];
     }
+    for (size_t i = 0; i < nbTarget; ++i) {
+        targetPartners[i] = partnerBuffer[slot[nbSource + i]];
+    }
+    return std::make_pair(std::move(sourcePartners), std::move(targetPartners));
+}
 
-    // Check that the set of all intersections matches UIDs on local PE.
-    if (ATLAS_BUILD_TYPE_DEBUG) {
-        auto tempUids = uidIntersection;
-        std::sort(tempUids.begin(), tempUids.end(),
-                  [](const IdxUid& a, const IdxUid& b) { return a.second < b.second; });
-        ATLAS_ASSERT(tempUids == localUids, "Set of all UID intersections does not match local UIDs.");
+// Group local indices by partner PE, keeping UID order within each group. Return local indices and PE
+// displacements.
+std::pair<std::vector<idx_t>, std::vector<int>> getPartnerIdx(const std::string& mpi_comm,
+                                                              const std::vector<IdxUid>& localUids,
+                                                              const std::vector<int>& partners) {
+    const auto mpi_size = mpi::comm(mpi_comm).size();
+
+    auto disps = std::vector<int>(mpi_size + 1, 0);
+    for (int partner : partners) {
+        ATLAS_ASSERT(partner >= 0, "Unique ID has no match in the other functionspace.");
+        ++disps[partner + 1];
     }
+    std::partial_sum(disps.begin(), disps.end(), disps.begin());
 
-    // Return local indices of intersection and displacements.
-    return make_pair(getUidIdx(uidIntersection), disps);
+    auto idxVec = std::vector<idx_t>(localUids.size());
+    auto next   = std::vector<int>(disps.begin(), disps.end() - 1);
+    for (size_t i = 0; i < localUids.size(); ++i) {
+        idxVec[next[partners[i]]++] = localUids[i].first;
+    }
+    return std::make_pair(std::move(idxVec), std::move(disps));
 }
 
 
-// Iterate over a field, in the order of an index list, and apply a functor to
-// each element.
-
-// Recursive ForEach to visit all elements of field.
-template <int Rank, int Dim = 0>
-struct ForEach {
-    template <typename Value, typename Functor, typename... Idxs>
-    static void apply(const std::vector<idx_t>& idxList, array::ArrayView<Value, Rank>& fieldView, const Functor& f,
-                      Idxs... idxs) {
-        // Iterate over dimension Dim of array.
-        for (idx_t idx = 0; idx < fieldView.shape(Dim); ++idx) {
-            ForEach<Rank, Dim + 1>::apply(idxList, fieldView, f, idxs..., idx);
+// Recursively visit all elements of column idx of a field view, in row-major order.
+template <int Rank, int Dim = 1>
+struct ForEachInColumn {
+    template <typename View, typename Functor, typename... Idxs>
+    static void apply(View& fieldView, const Functor& f, Idxs... idxs) {
+        if constexpr (Dim == Rank) {
+            f(fieldView(idxs...));
+        }
+        else {
+            for (idx_t idx = 0; idx < fieldView.shape(Dim); ++idx) {
+                ForEachInColumn<Rank, Dim + 1>::apply(fieldView, f, idxs..., idx);
+            }
         }
     }
 };
 
-// Beginning of recursion when Dim == 0.
-template <int Rank>
-struct ForEach<Rank, 0> {
-    template <typename Value, typename Functor, typename... Idxs>
-    static void apply(const std::vector<idx_t>& idxList, array::ArrayView<Value, Rank>& fieldView, const Functor& f,
-                      Idxs... idxs) {
-        // Iterate over dimension 0 of array in order defined by idxList.
-        for (idx_t idx : idxList) {
-            ForEach<Rank, 1>::apply(idxList, fieldView, f, idxs..., idx);
+// Call f(Value{}, std::integral_constant<int, Rank>{}) for the rank of a field.
+template <typename Value, typename Functor>
+void dispatchRank(const Field& field, const Functor& f) {
+    // Available ranks defined in array/LocalView.cc
+    switch (field.rank()) {
+        case 1: {
+            return f(Value{}, std::integral_constant<int, 1>{});
+        }
+        case 2: {
+            return f(Value{}, std::integral_constant<int, 2>{});
+        }
+        case 3: {
+            return f(Value{}, std::integral_constant<int, 3>{});
+        }
+        case 4: {
+            return f(Value{}, std::integral_constant<int, 4>{});
+        }
+        case 5: {
+            return f(Value{}, std::integral_constant<int, 5>{});
+        }
+        case 6: {
+            return f(Value{}, std::integral_constant<int, 6>{});
+        }
+        case 7: {
+            return f(Value{}, std::integral_constant<int, 7>{});
+        }
+        case 8: {
+            return f(Value{}, std::integral_constant<int, 8>{});
+        }
+        case 9: {
+            return f(Value{}, std::integral_constant<int, 9>{});
+        }
+        default: {
+            ATLAS_THROW_EXCEPTION("No implementation for rank " + std::to_string(field.rank()));
         }
     }
-};
+}
 
-// End of recursion when Dim == Rank.
-template <int Rank>
-struct ForEach<Rank, Rank> {
-    template <typename Value, typename Functor, typename... Idxs>
-    static void apply(const std::vector<idx_t>& idxList, array::ArrayView<Value, Rank>& fieldView, const Functor& f,
-                      Idxs... idxs) {
-        // Apply functor.
-        f(fieldView(idxs...));
+// Call f(Value{}, std::integral_constant<int, Rank>{}) for the datatype and rank of a field.
+template <typename Functor>
+void dispatch(const Field& field, const Functor& f) {
+    // Available datatypes defined in array/LocalView.cc
+    switch (field.datatype().kind()) {
+        case array::DataType::KIND_REAL64: {
+            return dispatchRank<double>(field, f);
+        }
+        case array::DataType::KIND_REAL32: {
+            return dispatchRank<float>(field, f);
+        }
+        case array::DataType::KIND_INT64: {
+            return dispatchRank<long>(field, f);
+        }
+        case array::DataType::KIND_INT32: {
+            return dispatchRank<int>(field, f);
+        }
+        default: {
+            ATLAS_THROW_EXCEPTION("No implementation for data type " + field.datatype().str());
+        }
     }
-};
-
-}  // namespace
-
-void RedistributeGeneric::do_setup() {
-    ATLAS_ASSERT( source().mpi_comm() == target().mpi_comm() );
+}
 
-    mpi_comm_ = source().mpi_comm();
+// Number of bytes in one column of a field.
+size_t columnBytes(const Field& field) {
+    size_t elemsPerCol = 1;
+    for (idx_t i = 1; i < field.rank(); ++i) {
+        elemsPerCol *= static_cast<size_t>(field.shape(i));
+    }
+    return elemsPerCol * field.datatype().size();
+}
 
-    // get a unique ID (UID) for each owned member of functionspace.
-    const auto sourceUidVec = getUidVec(source());
-    const auto targetUidVec = getUidVec(target());
+// Copy columns idx[0], ..., idx[n-1] of a field to buffer, with stride bytes between consecutive columns.
+void packColumns(const Field& field, const idx_t* idx, idx_t n, char* buffer, size_t stride) {
+    dispatch(field, [&](auto value, auto rank) {
+        using Value        = decltype(value);
+        constexpr int Rank = decltype(rank)::value;
+        const auto view    = array::make_view<Value, Rank>(field);
+        const size_t bytes = columnBytes(field);
+        if (view.contiguous()) {
+            atlas_omp_parallel_for(idx_t i = 0; i < n; ++i) {
+                std::memcpy(buffer + i * stride, view.data() + idx[i] * view.stride(0), bytes);
+            }
+        }
+        else {
+            atlas_omp_parallel_for(idx_t i = 0; i < n; ++i) {
+                char* column = buffer + i * stride;
+                ForEachInColumn<Rank>::apply(view, [&](const Value& elem) {
+                    std::memcpy(column, &elem, sizeof(Value));
+                    column += sizeof(Value);
+                }, idx[i]);
+            }
+        }
+    });
+}
 
-    // Communicate UID vectors to all PEs.
-    auto sourceGlobalUids                         = std::vector<uidx_t>{};
-    auto sourceGlobalDisps                        = std::vector<int>{};
-    std::tie(sourceGlobalUids, sourceGlobalDisps) = communicateUid(mpi_comm_, getUidVal(sourceUidVec));
-    auto targetGlobalUids                         = std::vector<uidx_t>{};
-    auto targetGlobalDisps                        = std::vector<int>{};
-    std::tie(targetGlobalUids, targetGlobalDisps) = communicateUid(mpi_comm_, getUidVal(targetUidVec));
-
-    // Get intersection of local UIDs and Global UIDs.
-    std::tie(sourceLocalIdx_, sourceDisps_) = getUidIntersection(mpi_comm_, sourceUidVec, targetGlobalUids, targetGlobalDisps);
-    std::tie(targetLocalIdx_, targetDisps_) = getUidIntersection(mpi_comm_, targetUidVec, sourceGlobalUids, sourceGlobalDisps);
+// Copy columns from buffer, with stride bytes between consecutive columns, to columns idx[0], ..., idx[n-1] of a field.
+void unpackColumns(Field& field, const idx_t* idx, idx_t n, const char* buffer, size_t stride) {
+    dispatch(field, [&](auto value, auto rank) {
+        using Value        = decltype(value);
+        constexpr int Rank = decltype(rank)::value;
+        auto view          = array::make_view<Value, Rank>(field);
+        const size_t bytes = columnBytes(field);
+        if (view.contiguous()) {
+            atlas_omp_parallel_for(idx_t i = 0; i < n; ++i) {
+                std::memcpy(view.data() + idx[i] * view.stride(0), buffer + i * stride, bytes);
+            }
+        }
+        else {
+            atlas_omp_parallel_for(idx_t i = 0; i < n; ++i) {
+                const char* column = buffer + i * stride;
+                ForEachInColumn<Rank>::apply(view, [&](Value& elem) {
+                    std::memcpy(&elem, column, sizeof(Value));
+                    column += sizeof(Value);
+                }, idx[i]);
+            }
+        }
+    });
 }
 
-void RedistributeGeneric::execute(const Field& sourceField, Field& targetField) const {
+// Check that a source and target field can be redistributed between functionspaces.
+void checkFields(const Field& sourceField, const Field& targetField, const FunctionSpace& source,
+                 const FunctionSpace& target) {
     //Check functionspaces match.
-    ATLAS_ASSERT(sourceField.functionspace().type() == source().type());
-    ATLAS_ASSERT(targetField.functionspace().type() == target().type());
+    ATLAS_ASSERT(sourceField.functionspace().type() == source.type());
+    ATLAS_ASSERT(targetField.functionspace().type() == target.type());
 
     // Check Field datatypes match.
     ATLAS_ASSERT(sourceField.datatype() == targetField.datatype());
@@ -296,130 +440,162 @@ void RedistributeGeneric::execute(const Field& sourceField, Field& targetField)
     for (idx_t i = 1; i < sourceField.rank(); ++i) {
         ATLAS_ASSERT(sourceField.shape(i) == targetField.shape(i));
     }
+}
+
+}  // namespace
+
+void RedistributeGeneric::do_setup() {
+    ATLAS_ASSERT( source().mpi_comm() == target().mpi_comm() );
+
+    mpi_comm_ = source().mpi_comm();
+
+    // get a unique ID (UID) for each owned member of functionspace.
+    const auto sourceUidVec = getUidVec(source());
+    const auto targetUidVec = getUidVec(target());
+
+    // Find the PE of each UID in the other functionspace.
+    auto sourcePartners                      = std::vector<int>{};
+    auto targetPartners                      = std::vector<int>{};
+    std::tie(sourcePartners, targetPartners) = getUidPartners(mpi_comm_, sourceUidVec, targetUidVec);
+
+    // Get local indices to send to and receive from each PE.
+    std::tie(sourceLocalIdx_, sourceDisps_) = getPartnerIdx(mpi_comm_, sourceUidVec, sourcePartners);
+    std::tie(targetLocalIdx_, targetDisps_) = getPartnerIdx(mpi_comm_, targetUidVec, targetPartners);
+
+    // Get PEs exchanging at least one column with this PE, excluding this PE.
+    const auto mpi_rank = static_cast<int>(mpi::comm(mpi_comm_).rank());
+    sendPeers_.clear();
+    recvPeers_.clear();
+    for (int part = 0; part + 1 < static_cast<int>(sourceDisps_.size()); ++part) {
+        if (part != mpi_rank && sourceDisps_[part + 1] > sourceDisps_[part]) {
+            sendPeers_.push_back(part);
+        }
+        if (part != mpi_rank && targetDisps_[part + 1] > targetDisps_[part]) {
+            recvPeers_.push_back(part);
+        }
+    }
+}
+
+void RedistributeGeneric::execute(const Field& sourceField, Field& targetField) const {
+    checkFields(sourceField, targetField, source(), target());
 
     // Perform redistribution.
-    do_execute(sourceField, targetField);
+    auto targetFields = std::vector<Field>{targetField};
+    do_execute({sourceField}, targetFields);
 }
 
 void RedistributeGeneric::execute(const FieldSet& sourceFieldSet, FieldSet& targetFieldSet) const {
     // Check field set sizes match.
     ATLAS_ASSERT(sourceFieldSet.size() == targetFieldSet.size());
 
-    // Redistribute fields.
+    auto sourceFields = std::vector<Field>{};
+    auto targetFields = std::vector<Field>{};
     for (idx_t i = 0; i < sourceFieldSet.size(); ++i) {
-        execute(sourceFieldSet[i], targetFieldSet[i]);
+        checkFields(sourceFieldSet[i], targetFieldSet[i], source(), target());
+        sourceFields.push_back(sourceFieldSet[i]);
+        targetFields.push_back(targetFieldSet[i]);
     }
+
+    // Redistribute all fields together.
+    do_execute(sourceFields, targetFields);
 }
 
-// Determine datatype.
-void RedistributeGeneric::do_execute(const Field& sourceField, Field& targetField) const {
-    // Available datatypes defined in array/LocalView.cc
-    switch (sourceField.datatype().kind()) {
-        case array::DataType::KIND_REAL64: {
-            return do_execute<double>(sourceField, targetField);
-        }
-        case array::DataType::KIND_REAL32: {
-            return do_execute<float>(sourceField, targetField);
-        }
-        case array::DataType::KIND_INT64: {
-            return do_execute<long>(sourceField, targetField);
-        }
-        case array::DataType::KIND_INT32: {
-            return do_execute<int>(sourceField, targetField);
-        }
-        default: {
-            ATLAS_THROW_EXCEPTION("No implementation for data type " + sourceField.datatype().str());
-        }
+// Perform redistribution.
+void RedistributeGeneric::do_execute(const std::vector<Field>& sourceFields, std::vector<Field>& targetFields) const {
+    const auto& comm   = mpi::comm(mpi_comm_);
+    const int mpi_rank = static_cast<int>(comm.rank());
+    const int tag      = 0;
+
+    // A column of the buffers holds the columns of all fields, one after another.
+    auto fieldOffsets = std::vector<size_t>{0};
+    for (const auto& field : sourceFields) {
+        fieldOffsets.push_back(fieldOffsets.back() + columnBytes(field));
+    }
+    const size_t stride = fieldOffsets.back();
+    if (stride == 0) {
+        return;
     }
-}
 
-// Determine rank.
-template <typename Value>
-void RedistributeGeneric::do_execute(const Field& sourceField, Field& targetField) const {
-    // Available ranks defined in array/LocalView.cc
-    switch (sourceField.rank()) {
-        case 1: {
-            return do_execute<Value, 1>(sourceField, targetField);
-        }
-        case 2: {
-            return do_execute<Value, 2>(sourceField, targetField);
-        }
-        case 3: {
-            return do_execute<Value, 3>(sourceField, targetField);
-        }
-        case 4: {
-            return do_execute<Value, 4>(sourceField, targetField);
-        }
-        case 5: {
-            return do_execute<Value, 5>(sourceField, targetField);
+    sendBuffer_.resize(static_cast<size_t>(sourceDisps_.back()) * stride);
+    recvBuffer_.resize(static_cast<size_t>(targetDisps_.back()) * stride);
+
+    auto pack = [&](int part) {
+        const idx_t n = sourceDisps_[part + 1] - sourceDisps_[part];
+        char* buffer  = sendBuffer_.data() + sourceDisps_[part] * stride;
+        for (size_t f = 0; f < sourceFields.size(); ++f) {
+            packColumns(sourceFields[f], sourceLocalIdx_.data() + sourceDisps_[part], n, buffer + fieldOffsets[f],
+                        stride);
         }
-        case 6: {
-            return do_execute<Value, 6>(sourceField, targetField);
+    };
+    auto unpack = [&](int part, const char* buffer) {
+        const idx_t n = targetDisps_[part + 1] - targetDisps_[part];
+        for (size_t f = 0; f < targetFields.size(); ++f) {
+            unpackColumns(targetFields[f], targetLocalIdx_.data() + targetDisps_[part], n, buffer + fieldOffsets[f],
+                          stride);
         }
-        case 7: {
-            return do_execute<Value, 7>(sourceField, targetField);
+    };
+
+    // Messages are sent in chunks, each with a number of bytes which fits the int count of MPI.
+    const size_t maxChunkBytes = static_cast<size_t>(std::numeric_limits<int>::max());
+    auto forEachChunk          = [&](size_t bytes, auto&& f) {
+        for (size_t offset = 0; offset < bytes; offset += maxChunkBytes) {
+            f(offset, std::min(maxChunkBytes, bytes - offset));
         }
-        case 8: {
-            return do_execute<Value, 8>(sourceField, targetField);
+    };
+
+    // Post receives for all peers, keeping the peer of each request and the number of pending chunks per peer.
+    auto recvRequests    = std::vector<eckit::mpi::Request>{};
+    auto recvRequestPeer = std::vector<size_t>{};
+    auto recvPending     = std::vector<size_t>(recvPeers_.size(), 0);
+    ATLAS_TRACE_MPI(IRECEIVE) {
+        for (size_t j = 0; j < recvPeers_.size(); ++j) {
+            const int part     = recvPeers_[j];
+            char* buffer       = recvBuffer_.data() + targetDisps_[part] * stride;
+            const size_t bytes = (targetDisps_[part + 1] - targetDisps_[part]) * stride;
+            forEachChunk(bytes, [&](size_t offset, size_t count) {
+                recvRequests.push_back(comm.iReceive(buffer + offset, count, part, tag));
+                recvRequestPeer.push_back(j);
+                ++recvPending[j];
+            });
         }
-        case 9: {
-            return do_execute<Value, 9>(sourceField, targetField);
+    }
+
+    // Pack and send the columns of each peer as soon as they are packed.
+    auto sendRequests = std::vector<eckit::mpi::Request>{};
+    for (size_t j = 0; j < sendPeers_.size(); ++j) {
+        const int part = sendPeers_[j];
+        pack(part);
+        const char* buffer = sendBuffer_.data() + sourceDisps_[part] * stride;
+        const size_t bytes = (sourceDisps_[part + 1] - sourceDisps_[part]) * stride;
+        ATLAS_TRACE_MPI(ISEND) {
+            forEachChunk(bytes, [&](size_t offset, size_t count) {
+                sendRequests.push_back(comm.iSend(buffer + offset, count, part, tag));
+            });
         }
-        default: {
-            ATLAS_THROW_EXCEPTION("No implementation for rank " + std::to_string(sourceField.rank()));
+    }
+
+    // Columns staying on this PE are copied through the send buffer only.
+    pack(mpi_rank);
+    unpack(mpi_rank, sendBuffer_.data() + sourceDisps_[mpi_rank] * stride);
+
+    // Unpack the message of each peer as soon as all its chunks have arrived, in order of arrival.
+    while (not recvRequests.empty()) {
+        int r = 0;
+        ATLAS_TRACE_MPI(WAIT) { comm.waitAny(recvRequests, r); }
+        const size_t j = recvRequestPeer[r];
+        recvRequests.erase(recvRequests.begin() + r);
+        recvRequestPeer.erase(recvRequestPeer.begin() + r);
+        if (--recvPending[j] == 0) {
+            const int part = recvPeers_[j];
+            unpack(part, recvBuffer_.data() + targetDisps_[part] * stride);
         }
     }
-}
 
-// Perform redistribution.
-template <typename Value, int Rank>
-void RedistributeGeneric::do_execute(const Field& sourceField, Field& targetField) const {
-    // Get array views.
-    auto sourceView = array::make_view<Value, Rank>(sourceField);
-    auto targetView = array::make_view<Value, Rank>(targetField);
-
-    const auto& comm = mpi::comm(mpi_comm_);
-    auto mpi_size = comm.size();
-
-    // Get number of elems per column.
-    int elemsPerCol = 1;
-    for (int i = 1; i < Rank; ++i) {
-        elemsPerCol *= sourceView.shape(i);
-    }
-
-    // Set send displacement and counts vectors.
-    auto sendDisps = std::vector<int>{};
-    sendDisps.reserve(mpi_size + 1);
-    auto sendCounts = std::vector<int>{};
-    sendCounts.reserve(mpi_size);
-    std::transform(sourceDisps_.begin(), sourceDisps_.end(), std::back_inserter(sendDisps),
-                   [&](const int& disp) { return disp * elemsPerCol; });
-    std::adjacent_difference(sendDisps.begin() + 1, sendDisps.end(), std::back_inserter(sendCounts));
-
-    // Set recv displacement and counts vectors.
-    auto recvDisps = std::vector<int>{};
-    recvDisps.reserve(mpi_size + 1);
-    auto recvCounts = std::vector<int>{};
-    recvCounts.reserve(mpi_size);
-    std::transform(targetDisps_.begin(), targetDisps_.end(), std::back_inserter(recvDisps),
-                   [&](const int& disp) { return disp * elemsPerCol; });
-    std::adjacent_difference(recvDisps.begin() + 1, recvDisps.end(), std::back_inserter(recvCounts));
-
-    // Allocate send and recv buffers.
-    auto sendBuffer   = std::vector<Value>(static_cast<size_t>(sendDisps.back()));
-    auto recvBuffer   = std::vector<Value>(static_cast<size_t>(recvDisps.back()));
-    auto sendBufferIt = sendBuffer.begin();
-    auto recvBufferIt = recvBuffer.cbegin();
-
-    // Copy sourceField to sendBuffer.
-    ForEach<Rank>::apply(sourceLocalIdx_, sourceView, [&](const Value& elem) { *sendBufferIt++ = elem; });
-
-    // Perform MPI communication.
-    comm.allToAllv(sendBuffer.data(), sendCounts.data(), sendDisps.data(), recvBuffer.data(), recvCounts.data(),
-                   recvDisps.data());
-
-    // Copy recvBuffer to targetField.
-    ForEach<Rank>::apply(targetLocalIdx_, targetView, [&](Value& elem) { elem = *recvBufferIt++; });
+    ATLAS_TRACE_MPI(WAIT) {
+        for (auto& request : sendRequests) {
+            comm.wait(request);
+        }
+    }
 }
 
 namespace {
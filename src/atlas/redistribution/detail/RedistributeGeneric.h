@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "atlas/redistribution/detail/RedistributionImpl.h"
 
@@ -28,14 +29,8 @@ public:
     void execute(const FieldSet& source, FieldSet& target) const override;
 
 private:
-    // Determine datatype.
-    void do_execute(const Field& source, Field& target) const;
-    // Determine rank.
-    template <typename Value>
-    void do_execute(const Field& source, Field& target) const;
-    // Perform redistribution.
-    template <typename Value, int Rank>
-    void do_execute(const Field& source, Field& target) const;
+    // Pack all fields into one message per peer, exchange and unpack.
+    void do_execute(const std::vector<Field>& sourceFields, std::vector<Field>& targetFields) const;
 
     // Local indices to send to each PE
     std::vector<idx_t> sourceLocalIdx_{};
@@ -49,6 +44,16 @@ private:
     // Partial sum of number of columns to receive from each PE.
     std::vector<int> targetDisps_{};
 
+    // PEs, other than this PE, to send at least one column to.
+    std::vector<int> sendPeers_{};
+
+    // PEs, other than this PE, to receive at least one column from.
+    std::vector<int> recvPeers_{};
+
+    // Buffers kept between executions, holding a column of all fields per local index.
+    mutable std::vector<char> sendBuffer_{};
+    mutable std::vector<char> recvBuffer_{};
+
     std::string mpi_comm_;
 };
 
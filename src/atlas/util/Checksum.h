@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace atlas {
 namespace util {
@@ -23,5 +24,8 @@ checksum_t checksum(const float values[], size_t size);
 checksum_t checksum(const double values[], size_t size);
 checksum_t checksum(const checksum_t values[], size_t size);
 
+/// @brief 64-bit hash of size bytes, following the XXH64 algorithm
+std::uint64_t hash64(const void* data, size_t size, std::uint64_t seed = 0);
+
 }  // namespace util
 }  // namespace atlas
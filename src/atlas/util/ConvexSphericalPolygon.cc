@@ -10,6 +10,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <utility>
 
 #include "eckit/geometry/Sphere.h"
 #include "eckit/types/FloatCompare.h"
@@ -100,6 +101,75 @@ private:
 };
 #endif
 
+// Fixed-capacity structure-of-arrays copy of polygon vertices, used as scratch space while clipping.
+// Every vertex of the input emits at most two vertices in a single clip, hence the capacity.
+struct ClipPolygon {
+    static constexpr int CAPACITY = 2 * ConvexSphericalPolygon::MAX_SIZE;
+    alignas(64) double x[CAPACITY];
+    alignas(64) double y[CAPACITY];
+    alignas(64) double z[CAPACITY];
+    int size{0};
+
+    PointXYZ point(int i) const { return PointXYZ{x[i], y[i], z[i]}; }
+
+    void push_back(const PointXYZ& p) {
+        x[size] = p[0];
+        y[size] = p[1];
+        z[size] = p[2];
+        ++size;
+    }
+};
+
+// Sutherland-Hodgman clipping of polygon `in` by the left hemisphere of `great_circle`, written to `out`.
+// This follows ConvexSphericalPolygon::clip operation by operation, so that the resulting vertices are
+// bitwise identical. The side-of-plane tests for all vertices are evaluated up front in one branch-free loop;
+// intersections are only computed for the edges crossing the great circle (at most two for convex input).
+void clip_soa(const ClipPolygon& in, const GreatCircleSegment& great_circle, ClipPolygon& out, double pointsSameEPS) {
+    ATLAS_ASSERT(not approx_eq(great_circle.first(), great_circle.second()));
+    const int n        = in.size;
+    const double cx    = great_circle.cross()[0];
+    const double cy    = great_circle.cross()[1];
+    const double cz    = great_circle.cross()[2];
+    const double limit = -1.5 * EPS;
+
+    alignas(64) int inside[ClipPolygon::CAPACITY];
+    for (int i = 0; i < n; ++i) {
+        inside[i] = (cx * in.x[i] + cy * in.y[i] + cz * in.z[i]) >= limit;
+    }
+
+    out.size = 0;
+    for (int i = 0; i < n; ++i) {
+        const int in1        = (i == n - 1) ? 0 : i + 1;
+        const bool first_in  = inside[i];
+        const bool second_in = inside[in1];
+        if (first_in and second_in) {
+            out.push_back(in.point(in1));
+        }
+        else if (first_in or second_in) {
+            const PointXYZ first  = in.point(i);
+            const PointXYZ second = in.point(in1);
+            const GreatCircleSegment segment(first, second);
+            PointXYZ ip = great_circle.intersect(segment, nullptr, pointsSameEPS);
+            if (ip[0] == 1 and ip[1] == 1 and ip[2] == 1) {
+                // consider the segments parallel
+                out.push_back(second);
+            }
+            else if (second_in) {
+                const int in2 = (in1 == n - 1) ? 0 : in1 + 1;
+                const GreatCircleSegment segment_n(second, in.point(in2));
+                if (segment.inLeftHemisphere(ip, limit) and segment_n.inLeftHemisphere(ip, limit) and
+                    (PointXYZ::distance(ip, second) > pointsSameEPS)) {
+                    out.push_back(ip);
+                }
+                out.push_back(second);
+            }
+            else if (PointXYZ::distance(ip, first) > pointsSameEPS) {
+                out.push_back(ip);
+            }
+        }
+    }
+}
+
 }  // namespace
 
 //------------------------------------------------------------------------------------------------------
@@ -368,10 +438,71 @@ void ConvexSphericalPolygon::clip(const GreatCircleSegment& great_circle, std::o
     }
 }
 
+bool ConvexSphericalPolygon::is_intersector(const ConvexSphericalPolygon& plg) const {
+    // the larger area polygon is the intersector
+    bool this_intersector = (area() > plg.area());
+    if (approx_eq(area(), plg.area())) {
+        PointXYZ dc = centroid() - plg.centroid();
+        if (dc[0] > 0. or (dc[0] == 0. and (dc[1] > 0. or (dc[1] == 0. and dc[2] > 0.)))) {
+            this_intersector = true;
+        }
+    }
+    return this_intersector;
+}
+
 // intersect a polygon with this polygon
 // @param[in] pol clipping polygon
 // @param[out] intersecting polygon
 ConvexSphericalPolygon ConvexSphericalPolygon::intersect(const ConvexSphericalPolygon& plg, std::ostream* out, double pointsSameEPS) const {
+    if (out) {
+        return intersect_scalar(plg, out, pointsSameEPS);
+    }
+
+    bool fpe_disabled = atlas::library::disable_floating_point_exception(FE_INVALID);
+    auto restore_fpe = [fpe_disabled] {
+        if (fpe_disabled) {
+            atlas::library::enable_floating_point_exception(FE_INVALID);
+        }
+    };
+
+    const bool this_intersector               = is_intersector(plg);
+    const ConvexSphericalPolygon& intersector = this_intersector ? *this : plg;
+    ConvexSphericalPolygon intersection       = this_intersector ? plg : *this;
+
+    if (intersection.valid_) {
+        ClipPolygon buffers[2];
+        ClipPolygon* clipped = &buffers[0];
+        ClipPolygon* scratch = &buffers[1];
+        for (size_t i = 0; i < intersection.size_; ++i) {
+            clipped->push_back(intersection.sph_coords_[i]);
+        }
+        for (size_t i = 0; i < intersector.size_; i++) {
+            const PointXYZ& s1 = intersector.sph_coords_[i];
+            const PointXYZ& s2 = intersector.sph_coords_[(i != intersector.size_ - 1) ? i + 1 : 0];
+            clip_soa(*clipped, GreatCircleSegment(s1, s2), *scratch, pointsSameEPS);
+            std::swap(clipped, scratch);
+            if (clipped->size < 3) {
+                intersection.size_  = 0;
+                intersection.valid_ = false;
+                intersection.area_  = 0.;
+                restore_fpe();
+                return intersection;
+            }
+            ATLAS_ASSERT(clipped->size <= MAX_SIZE, "Number of polygon points exceeds compile time MAX_SIZE");
+        }
+        intersection.size_ = clipped->size;
+        for (size_t i = 0; i < intersection.size_; ++i) {
+            intersection.sph_coords_[i] = clipped->point(i);
+        }
+    }
+    intersection.computed_area_     = false;
+    intersection.computed_radius_   = false;
+    intersection.computed_centroid_ = false;
+    restore_fpe();
+    return intersection;
+}
+
+ConvexSphericalPolygon ConvexSphericalPolygon::intersect_scalar(const ConvexSphericalPolygon& plg, std::ostream* out, double pointsSameEPS) const {
 
     bool fpe_disabled = atlas::library::disable_floating_point_exception(FE_INVALID);
     auto restore_fpe = [fpe_disabled] {
@@ -386,14 +517,7 @@ ConvexSphericalPolygon ConvexSphericalPolygon::intersect(const ConvexSphericalPo
     std::string intor_id = "P1";
     std::string inted_id = "P2";
 
-    bool this_intersector = (area() > plg.area());
-    if (approx_eq(area(), plg.area())) {
-        PointXYZ dc = centroid() - plg.centroid();
-        if (dc[0] > 0. or (dc[0] == 0. and (dc[1] > 0. or (dc[1] == 0. and dc[2] > 0.)))) {
-            this_intersector = true;
-        }
-    }
-    if (this_intersector) {
+    if (is_intersector(plg)) {
         intersector = *this;
         intersection = plg;
     }
@@ -102,8 +102,19 @@ public:
         return radius_;
     }
 
+    /*
+   * @brief intersect a polygon with this polygon
+   * @note Uses an allocation-free clipping kernel on a structure-of-arrays copy of the vertices.
+   *       When debug output is requested via f, this falls back to intersect_scalar().
+   */
     ConvexSphericalPolygon intersect(const ConvexSphericalPolygon& pol, std::ostream* f = nullptr, double pointsEqualEPS = std::numeric_limits<double>::epsilon()) const;
 
+    /*
+   * @brief intersect a polygon with this polygon, clipping one PointXYZ at a time
+   * @note Bitwise identical to intersect(); kept as reference implementation and for debug output
+   */
+    ConvexSphericalPolygon intersect_scalar(const ConvexSphericalPolygon& pol, std::ostream* f = nullptr, double pointsEqualEPS = std::numeric_limits<double>::epsilon()) const;
+
     /*
    * @brief check if two spherical polygons area equal
    * @param[in] P given point in (x,y,z) coordinates
@@ -148,6 +159,9 @@ private:
 
     void clip(const GreatCircleSegment&, std::ostream* f = nullptr, double pointsSameEPS = std::numeric_limits<double>::epsilon());
 
+    // @return true if this polygon clips pol in intersect(), false if pol clips this polygon
+    bool is_intersector(const ConvexSphericalPolygon& pol) const;
+
     /*
    * @return true:polygon is convex
    */
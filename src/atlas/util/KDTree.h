@@ -10,11 +10,14 @@
 
 #pragma once
 
+#include <string>
+
 #include "eckit/config/Configuration.h"
 
 #include "atlas/util/Geometry.h"
 #include "atlas/util/ObjectHandle.h"
 #include "atlas/util/detail/KDTree.h"
+#include "atlas/util/detail/KDTreeFlat.h"
 
 namespace atlas {
 namespace util {
@@ -23,7 +26,8 @@ namespace util {
 
 /// @brief k-dimensional tree constructable both with 2D (lon,lat) points as with 3D (x,y,z) points
 ///
-/// The implementation is based on eckit::KDTreeMemory with 3D (x,y,z) points.
+/// The default implementation is based on eckit::KDTreeMemory with 3D (x,y,z) points. A flat, cache-efficient
+/// implementation (detail::KDTreeFlat) is constructed with the configuration option "kdtree_type" set to "flat".
 /// 2D points (lon,lat) are converted when needed to 3D during insertion, and during search, so that
 /// a search always happens with 3D cartesian points.
 ///
@@ -73,9 +77,10 @@ public:
     /// @brief Construct an empty kd-tree with custom geometry
     KDTree(const Geometry& geometry): Handle(new detail::KDTreeMemory<Payload, Point>(geometry)) {}
 
-    /// @brief Construct an empty kd-tree with custom geometry
-    KDTree(const eckit::Configuration& config):
-        KDTree(Geometry(config.getString("geometry","Earth"))) {}
+    /// @brief Construct an empty kd-tree with custom "geometry" and "kdtree_type":
+    /// "eckit" (default) for detail::KDTreeMemory, or "flat" for detail::KDTreeFlat.
+    /// Other options are ignored, so that the configuration of the caller can be passed on.
+    KDTree(const eckit::Configuration& config): Handle(make_implementation(config)) {}
 
     /// @brief Construct a shared kd-tree with default geometry (Earth)
     template <typename Tree>
@@ -175,8 +180,33 @@ public:
         return get()->closestPointsWithinRadius(p, radius);
     }
 
+    /// @brief Find k closest points given a 3D cartesian point (x,y,z) or 2D lonlat point(lon,lat),
+    /// reusing the memory of given result list, e.g. across many queries
+    template <typename Point>
+    void closestPoints(const Point& p, size_t k, ValueList& result) const {
+        get()->closestPoints(p, k, result);
+    }
+
+    /// @brief Find all points within a distance of given radius from a given point 3D cartesian point (x,y,z)
+    /// or a 2D (lon,lat) point, reusing the memory of given result list, e.g. across many queries
+    template <typename Point>
+    void closestPointsWithinRadius(const Point& p, double radius, ValueList& result) const {
+        get()->closestPointsWithinRadius(p, radius, result);
+    }
+
     /// @brief Return geometry used to convert (lon,lat) to (x,y,z) coordinates
     const Geometry& geometry() const { return get()->geometry(); }
+
+private:
+    static Implementation* make_implementation(const eckit::Configuration& config) {
+        Geometry geometry(config.getString("geometry", "Earth"));
+        std::string type = config.getString("kdtree_type", "eckit");
+        if (type == "flat") {
+            return new detail::KDTreeFlat<Payload, Point>(geometry);
+        }
+        ATLAS_ASSERT(type == "eckit", "Unknown kdtree_type '" + type + "'");
+        return new detail::KDTreeMemory<Payload, Point>(geometry);
+    }
 };
 
 //------------------------------------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/util/PersistentKDTree.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+#include "eckit/utils/MD5.h"
+
+#include "atlas/grid/Grid.h"
+#include "atlas/library/config.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/detail/DirectoryLock.h"
+#include "atlas/util/detail/KDTree.h"
+
+namespace atlas {
+namespace util {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+// Increment when the layout of the stored tree changes, e.g. its Point or Payload types
+constexpr int layout_version = 1;
+
+const std::string extension = ".kdtree";
+
+using MappedKDTree = detail::KDTreeMapped<IndexKDTree::Payload, IndexKDTree::Point>;
+
+//-----------------------------------------------------------------------------
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+PersistentKDTree::PersistentKDTree(const eckit::PathName& directory): directory_(directory) {
+    if (not directory_.exists()) {
+        directory_.mkdir();
+    }
+}
+
+std::string PersistentKDTree::key(const Grid& grid, const Geometry& geometry) const {
+    eckit::MD5 hash;
+    hash.add(std::string("atlas::util::PersistentKDTree"));
+    hash.add(layout_version);
+    hash.add(sizeof(IndexKDTree::Payload));
+    hash.add(geometry.radius());
+    grid.hash(hash);
+    return hash.digest();
+}
+
+eckit::PathName PersistentKDTree::path(const std::string& key) const {
+    return directory_ / (key + extension);
+}
+
+IndexKDTree PersistentKDTree::load(const std::string& key, const Geometry& geometry) const {
+    ATLAS_TRACE("PersistentKDTree::load");
+    eckit::PathName file = path(key);
+    if (not file.exists()) {
+        return IndexKDTree(nullptr);
+    }
+    try {
+        // An item count of 0 maps the existing file read-only
+        return IndexKDTree(new MappedKDTree(geometry, file, size_t(0), size_t(0)));
+    }
+    catch (const eckit::Exception& e) {
+        Log::warning() << "Ignoring unreadable kd-tree " << file << ": " << e.what() << std::endl;
+        return IndexKDTree(nullptr);
+    }
+}
+
+void PersistentKDTree::store(const std::string& key, const Grid& grid, const Geometry& geometry) const {
+    ATLAS_TRACE("PersistentKDTree::store");
+    detail::DirectoryLock lock(directory_);
+
+    eckit::PathName file = path(key);
+    if (file.exists()) {
+        // Stored meanwhile by another process
+        return;
+    }
+
+    eckit::PathName tmp = directory_ / (key + ".tmp." + std::to_string(::getpid()));
+    {
+        IndexKDTree tree(new MappedKDTree(geometry, tmp, size_t(grid.size()), size_t(0)));
+        tree.reserve(grid.size());
+        idx_t n = 0;
+        for (const auto& p : grid.lonlat()) {
+            tree.insert(p, n++);
+        }
+        tree.build();
+        // The file is complete once the tree is unmapped when going out of scope
+    }
+    if (::rename(tmp.localPath(), file.localPath()) != 0) {
+        int error = errno;
+        ::unlink(tmp.localPath());
+        throw_Exception("Could not rename " + tmp.asString() + " to " + file.asString() + ": " + std::strerror(error),
+                        Here());
+    }
+}
+
+IndexKDTree PersistentKDTree::operator()(const Grid& grid, const Geometry& geometry) const {
+    std::string k = key(grid, geometry);
+    if (auto tree = load(k, geometry)) {
+        return tree;
+    }
+    store(k, grid, geometry);
+    auto tree = load(k, geometry);
+    ATLAS_ASSERT(tree, "Could not load kd-tree " + path(k).asString());
+    return tree;
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
@@ -0,0 +1,84 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "eckit/filesystem/PathName.h"
+
+#include "atlas/util/Geometry.h"
+#include "atlas/util/KDTree.h"
+
+//-----------------------------------------------------------------------------
+// Forward declarations
+
+namespace atlas {
+class Grid;
+}  // namespace atlas
+
+//-----------------------------------------------------------------------------
+
+namespace atlas {
+namespace util {
+
+//-----------------------------------------------------------------------------
+
+/// @brief File-backed k-d trees of grid points, shared between processes
+///
+/// The tree of all points of a grid is built once and stored in the directory, under a key which hashes the
+/// grid and the geometry. Stored trees are memory-mapped read-only when loaded, so that opening one does not
+/// depend on the number of points, and all processes on a node share the same pages.
+/// The payload of each point is its index in the grid.
+///
+/// Interpolation methods read the payloads of a cached tree as local indices of the source function space.
+/// Those only coincide with grid indices when the source is not distributed, so that the tree can only be used
+/// as interpolation::IndexKDTreeCache for non-distributed sources. The grid-to-grid "k-nearest-neighbours" and
+/// "nearest-neighbour" interpolations then search the cached tree, on a PointCloud of the source grid, instead
+/// of building one.
+///
+/// Writers are serialised with an advisory lock on the directory and publish a tree with an atomic rename,
+/// so that readers never see a partially written tree.
+///
+/// Usage, e.g. with a serial nearest-neighbour interpolation between grids:
+/// @code{.cpp}
+///     util::PersistentKDTree persistent_kdtree("/path/to/cache");
+///     Interpolation interpolation(option::type("nearest-neighbour"), source_grid, target_grid,
+///                                 interpolation::IndexKDTreeCache(persistent_kdtree(source_grid)));
+/// @endcode
+class PersistentKDTree {
+public:
+    PersistentKDTree(const eckit::PathName& directory);
+
+    /// @brief Key of the tree of all grid points in given geometry
+    std::string key(const Grid&, const Geometry& = Geometry()) const;
+
+    /// @brief Path of the tree stored for given key
+    eckit::PathName path(const std::string& key) const;
+
+    /// @brief Memory-mapped tree stored for given key, or an empty IndexKDTree when not present
+    IndexKDTree load(const std::string& key, const Geometry& = Geometry()) const;
+
+    /// @brief Build and store the tree of all grid points for given key, unless already present
+    void store(const std::string& key, const Grid&, const Geometry& = Geometry()) const;
+
+    /// @brief Tree of all grid points, loaded from disk, or built and stored when not present
+    IndexKDTree operator()(const Grid&, const Geometry& = Geometry()) const;
+
+    const eckit::PathName& directory() const { return directory_; }
+
+private:
+    eckit::PathName directory_;
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
@@ -0,0 +1,51 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/util/detail/DirectoryLock.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include "atlas/runtime/Exception.h"
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//-----------------------------------------------------------------------------
+
+DirectoryLock::DirectoryLock(const eckit::PathName& directory) {
+    eckit::PathName path = directory / "lock";
+    fd_                  = ::open(path.localPath(), O_RDWR | O_CREAT, 0666);
+    if (fd_ < 0) {
+        throw_Exception("Could not open lock file " + path.asString() + ": " + std::strerror(errno), Here());
+    }
+    while (::flock(fd_, LOCK_EX) != 0) {
+        if (errno != EINTR) {
+            ::close(fd_);
+            throw_Exception("Could not lock " + path.asString() + ": " + std::strerror(errno), Here());
+        }
+    }
+}
+
+DirectoryLock::~DirectoryLock() {
+    ::flock(fd_, LOCK_UN);
+    ::close(fd_);
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
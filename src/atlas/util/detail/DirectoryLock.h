@@ -0,0 +1,40 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "eckit/filesystem/PathName.h"
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//-----------------------------------------------------------------------------
+
+/// @brief Exclusive advisory lock on a directory, held for the lifetime of this object
+///
+/// The lock is taken with flock(2) on the file "lock" inside the directory, so that it serialises
+/// processes sharing the directory, e.g. writers of a file-based cache.
+class DirectoryLock {
+public:
+    explicit DirectoryLock(const eckit::PathName& directory);
+    DirectoryLock(const DirectoryLock&) = delete;
+    DirectoryLock& operator=(const DirectoryLock&) = delete;
+    ~DirectoryLock();
+
+private:
+    int fd_;
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
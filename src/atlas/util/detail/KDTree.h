@@ -72,6 +72,8 @@ public:
 
     class ValueList : public std::vector<Value> {
     public:
+        ValueList() = default;
+
         PayloadList payloads() const {
             PayloadList list;
             list.reserve(this->size());
@@ -214,6 +216,20 @@ public:
         return do_closestPointsWithinRadius(p, radius);
     }
 
+    /// @brief Find k nearest neighbours given a 3D cartesian point (x,y,z) or 2D lonlat point(lon,lat),
+    /// reusing the memory of given result list
+    template <typename Point>
+    void closestPoints(const Point& p, size_t k, ValueList& result) const {
+        do_closestPoints(p, k, result);
+    }
+
+    /// @brief Find all points within a distance of given radius from a given point (x,y,z) or (lon,lat),
+    /// reusing the memory of given result list
+    template <typename Point>
+    void closestPointsWithinRadius(const Point& p, double radius, ValueList& result) const {
+        do_closestPointsWithinRadius(p, radius, result);
+    }
+
 private:
     /// @brief Insert spherical point (lon,lat)
     /// If memory has been reserved with reserve(), insertion will be delayed until build() is called.
@@ -236,6 +252,18 @@ private:
     /// @brief Find all points within a distance of given radius from a given point (x,y,z)
     virtual ValueList do_closestPointsWithinRadius(const Point&, double radius) const = 0;
 
+    /// @brief Find k nearest neighbours given a 3D cartesian point (x,y,z) into given result list
+    /// Implementations which can search without allocating override this
+    virtual void do_closestPoints(const Point& p, size_t k, ValueList& result) const {
+        result = do_closestPoints(p, k);
+    }
+
+    /// @brief Find all points within a distance of given radius from a given point (x,y,z) into given result list
+    /// Implementations which can search without allocating override this
+    virtual void do_closestPointsWithinRadius(const Point& p, double radius, ValueList& result) const {
+        result = do_closestPointsWithinRadius(p, radius);
+    }
+
 
     /// @brief Find k nearest neighbour given a 2D lonlat point (lon,lat)
     template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT(LonLat)>
@@ -255,6 +283,16 @@ private:
         return do_closestPointsWithinRadius(make_Point(p), radius);
     }
 
+    template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT(LonLat)>
+    void do_closestPoints(const LonLat& p, size_t k, ValueList& result) const {
+        do_closestPoints(make_Point(p), k, result);
+    }
+
+    template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT(LonLat)>
+    void do_closestPointsWithinRadius(const LonLat& p, double radius, ValueList& result) const {
+        do_closestPointsWithinRadius(make_Point(p), radius, result);
+    }
+
     template <typename LonLat, ENABLE_IF_3D_AND_IS_LONLAT(LonLat)>
     Point make_Point(const LonLat& lonlat) const {
         static_assert(std::is_base_of<Point2, LonLat>::value, "LonLat must be derived from Point2");
@@ -369,6 +407,11 @@ private:
 template <typename Payload, typename Point>
 using KDTreeMemory = KDTree_eckit<typename eckit::KDTreeMemory<typename KDTreeBase<Payload, Point>::KDTreeTraits>>;
 
+/// File-backed tree, constructed with (geometry, path, itemCount, metadataSize).
+/// An itemCount of 0 maps an existing file read-only, otherwise a new file is created for building.
+template <typename Payload, typename Point>
+using KDTreeMapped = KDTree_eckit<typename eckit::KDTreeMapped<typename KDTreeBase<Payload, Point>::KDTreeTraits>>;
+
 //------------------------------------------------------------------------------------------------------
 
 template <typename TreeT, typename PayloadT, typename PointT>
@@ -0,0 +1,368 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Exception.h"
+#include "atlas/util/detail/KDTree.h"
+
+namespace atlas {
+namespace util {
+namespace detail {
+
+//------------------------------------------------------------------------------------------------------
+
+/// @brief KDTree with an implicit, array-laid-out tree and buckets of points in its leaves
+///
+/// The tree is a complete binary tree stored in level order, so that the children of node i are nodes 2i+1 and
+/// 2i+2 and no pointers need to be followed. Each internal node splits its points at the median along the axis
+/// of largest extent. Each leaf holds a contiguous range of at most leaf_size points, stored coordinate by
+/// coordinate (structure of arrays), so that the distances to all points of a leaf are computed in one
+/// vectorised loop.
+///
+/// Inserted points are only added to the tree by build(), which rebuilds the whole tree. Distances are
+/// Euclidean distances between points, as with KDTree_eckit.
+template <typename PayloadT, typename PointT = Point3>
+class KDTreeFlat : public KDTreeBase<PayloadT, PointT> {
+    using Base = KDTreeBase<PayloadT, PointT>;
+
+public:
+    using Point       = typename Base::Point;
+    using Payload     = typename Base::Payload;
+    using PayloadList = typename Base::PayloadList;
+    using Value       = typename Base::Value;
+    using ValueList   = typename Base::ValueList;
+
+    using Base::build;
+    using Base::closestPoint;
+    using Base::closestPoints;
+    using Base::closestPointsWithinRadius;
+    using Base::insert;
+    using Base::reserve;
+
+    /// Maximum number of points in a leaf
+    static constexpr idx_t leaf_size = 32;
+
+public:
+    KDTreeFlat() = default;
+
+    KDTreeFlat(const Geometry& geometry): Base(geometry) {}
+
+    idx_t size() const override { return static_cast<idx_t>(payloads_.size()); }
+
+    size_t footprint() const override;
+
+    void reserve(idx_t size) override { pending_.reserve(size); }
+
+    void build() override;
+
+    void build(std::vector<Value>&) override;
+
+    void insert(const Value& value) override { pending_.emplace_back(value); }
+
+private:
+    static constexpr int DIMS = Point::DIMS;
+
+    using Coordinates = std::array<std::vector<double>, DIMS>;
+
+    ValueList do_closestPoints(const Point& p, size_t k) const override {
+        ValueList result;
+        do_closestPoints(p, k, result);
+        return result;
+    }
+
+    Value do_closestPoint(const Point&) const override;
+
+    ValueList do_closestPointsWithinRadius(const Point& p, double radius) const override {
+        ValueList result;
+        do_closestPointsWithinRadius(p, radius, result);
+        return result;
+    }
+
+    void do_closestPoints(const Point&, size_t k, ValueList&) const override;
+
+    void do_closestPointsWithinRadius(const Point&, double radius, ValueList&) const override;
+
+    void assert_built() const;
+
+    idx_t nb_internal_nodes() const { return nb_leaves_ - 1; }
+
+    Point point(idx_t i) const {
+        Point p;
+        for (int d = 0; d < DIMS; ++d) {
+            p[d] = coordinates_[d][i];
+        }
+        return p;
+    }
+
+    /// Squared distances from q to the points of the leaf with given node index
+    idx_t leaf_distances(idx_t node, const double q[], double distance2[], idx_t& begin) const;
+
+    /// Keep in result a max-heap, on squared distance, of the k points nearest to q
+    void search_nearest(idx_t node, const double q[], size_t k, ValueList& result) const;
+
+    /// Append to result the points with squared distance to q not larger than radius2
+    void search_radius(idx_t node, const double q[], double radius2, ValueList& result) const;
+
+    static bool closer(const Value& a, const Value& b) { return a.distance() < b.distance(); }
+
+    /// Replace squared distances by distances
+    static void finalise(ValueList& result) {
+        for (auto& value : result) {
+            value = Value(value.point(), value.payload(), std::sqrt(value.distance()));
+        }
+    }
+
+private:
+    std::vector<Value> pending_;
+    Coordinates coordinates_;               // coordinates of points, in order of leaves
+    std::vector<Payload> payloads_;         // payloads of points, in order of leaves
+    std::vector<double> split_value_;       // coordinate where internal node splits its points
+    std::vector<unsigned char> split_dim_;  // dimension along which internal node splits its points
+    std::vector<idx_t> leaf_begin_;         // points of leaf l are leaf_begin_[l] ... leaf_begin_[l+1]-1
+    idx_t nb_leaves_{1};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+template <typename PayloadT, typename PointT>
+size_t KDTreeFlat<PayloadT, PointT>::footprint() const {
+    size_t footprint = sizeof(*this) + payloads_.capacity() * sizeof(Payload) +
+                       split_value_.capacity() * sizeof(double) + split_dim_.capacity() +
+                       leaf_begin_.capacity() * sizeof(idx_t) + pending_.capacity() * sizeof(Value);
+    for (const auto& c : coordinates_) {
+        footprint += c.capacity() * sizeof(double);
+    }
+    return footprint;
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::build() {
+    std::vector<Value> values;
+    std::swap(values, pending_);
+    build(values);
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::build(std::vector<Value>& values) {
+    // Points already in the tree are rebuilt together with the new values
+    const idx_t n_old = size();
+    const idx_t n     = n_old + static_cast<idx_t>(values.size());
+
+    Coordinates coordinates;
+    std::vector<Payload> payloads;
+    payloads.reserve(n);
+    for (int d = 0; d < DIMS; ++d) {
+        coordinates[d].resize(n);
+        std::copy(coordinates_[d].begin(), coordinates_[d].end(), coordinates[d].begin());
+        for (idx_t i = n_old; i < n; ++i) {
+            coordinates[d][i] = values[i - n_old].point()[d];
+        }
+    }
+    payloads.insert(payloads.end(), payloads_.begin(), payloads_.end());
+    for (const auto& value : values) {
+        payloads.emplace_back(value.payload());
+    }
+
+    // Smallest power of two of leaves holding at most leaf_size points each
+    nb_leaves_ = 1;
+    while (nb_leaves_ * leaf_size < n) {
+        nb_leaves_ *= 2;
+    }
+    const idx_t nb_internal = nb_internal_nodes();
+    split_value_.assign(nb_internal, 0.);
+    split_dim_.assign(nb_internal, 0);
+
+    std::vector<idx_t> begin(nb_internal + nb_leaves_);
+    std::vector<idx_t> end(nb_internal + nb_leaves_);
+    std::vector<idx_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    begin[0] = 0;
+    end[0]   = n;
+
+    // Split level by level; the nodes of a level own disjoint ranges of points
+    for (idx_t level_begin = 0, level_size = 1; level_begin < nb_internal; level_begin += level_size, level_size *= 2) {
+        atlas_omp_parallel_for(idx_t node = level_begin; node < level_begin + level_size; ++node) {
+            const idx_t b = begin[node];
+            const idx_t e = end[node];
+            const idx_t m = b + (e - b) / 2;
+
+            int dim = 0;
+            if (e > b) {
+                double extent = -1.;
+                for (int d = 0; d < DIMS; ++d) {
+                    const auto& c = coordinates[d];
+                    auto minmax   = std::minmax_element(order.begin() + b, order.begin() + e,
+                                                        [&c](idx_t i, idx_t j) { return c[i] < c[j]; });
+                    if (c[*minmax.second] - c[*minmax.first] > extent) {
+                        extent = c[*minmax.second] - c[*minmax.first];
+                        dim    = d;
+                    }
+                }
+                const auto& c = coordinates[dim];
+                std::nth_element(order.begin() + b, order.begin() + m, order.begin() + e,
+                                 [&c](idx_t i, idx_t j) { return c[i] < c[j]; });
+                split_value_[node] = c[order[m]];
+            }
+            split_dim_[node]    = static_cast<unsigned char>(dim);
+            begin[2 * node + 1] = b;
+            end[2 * node + 1]   = m;
+            begin[2 * node + 2] = m;
+            end[2 * node + 2]   = e;
+        }
+    }
+
+    leaf_begin_.resize(nb_leaves_ + 1);
+    for (idx_t l = 0; l < nb_leaves_; ++l) {
+        leaf_begin_[l] = begin[nb_internal + l];
+        ATLAS_ASSERT(end[nb_internal + l] - begin[nb_internal + l] <= leaf_size);
+    }
+    leaf_begin_[nb_leaves_] = n;
+
+    for (int d = 0; d < DIMS; ++d) {
+        coordinates_[d].resize(n);
+        atlas_omp_parallel_for(idx_t i = 0; i < n; ++i) { coordinates_[d][i] = coordinates[d][order[i]]; }
+    }
+    payloads_.clear();
+    payloads_.reserve(n);
+    for (idx_t i = 0; i < n; ++i) {
+        payloads_.emplace_back(payloads[order[i]]);
+    }
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::assert_built() const {
+    if (not pending_.empty()) {
+        throw_AssertionFailed("KDTree was used before calling build()");
+    }
+}
+
+template <typename PayloadT, typename PointT>
+idx_t KDTreeFlat<PayloadT, PointT>::leaf_distances(idx_t node, const double q[], double distance2[],
+                                                    idx_t& begin) const {
+    const idx_t leaf = node - nb_internal_nodes();
+    begin            = leaf_begin_[leaf];
+    const idx_t n    = leaf_begin_[leaf + 1] - begin;
+    for (idx_t i = 0; i < n; ++i) {
+        distance2[i] = 0.;
+    }
+    for (int d = 0; d < DIMS; ++d) {
+        const double* c  = coordinates_[d].data() + begin;
+        const double q_d = q[d];
+        atlas_omp_pragma(omp simd)
+        for (idx_t i = 0; i < n; ++i) {
+            const double dx = c[i] - q_d;
+            distance2[i] += dx * dx;
+        }
+    }
+    return n;
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::search_nearest(idx_t node, const double q[], size_t k, ValueList& result) const {
+    if (node >= nb_internal_nodes()) {
+        double distance2[leaf_size];
+        idx_t begin;
+        const idx_t n = leaf_distances(node, q, distance2, begin);
+        for (idx_t i = 0; i < n; ++i) {
+            if (result.size() < k) {
+                result.emplace_back(point(begin + i), payloads_[begin + i], distance2[i]);
+                std::push_heap(result.begin(), result.end(), closer);
+            }
+            else if (distance2[i] < result.front().distance()) {
+                std::pop_heap(result.begin(), result.end(), closer);
+                result.back() = Value(point(begin + i), payloads_[begin + i], distance2[i]);
+                std::push_heap(result.begin(), result.end(), closer);
+            }
+        }
+        return;
+    }
+    const double dq = q[split_dim_[node]] - split_value_[node];
+    search_nearest(dq < 0. ? 2 * node + 1 : 2 * node + 2, q, k, result);
+    if (result.size() < k || dq * dq < result.front().distance()) {
+        search_nearest(dq < 0. ? 2 * node + 2 : 2 * node + 1, q, k, result);
+    }
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::search_radius(idx_t node, const double q[], double radius2,
+                                                 ValueList& result) const {
+    if (node >= nb_internal_nodes()) {
+        double distance2[leaf_size];
+        idx_t begin;
+        const idx_t n = leaf_distances(node, q, distance2, begin);
+        for (idx_t i = 0; i < n; ++i) {
+            if (distance2[i] <= radius2) {
+                result.emplace_back(point(begin + i), payloads_[begin + i], distance2[i]);
+            }
+        }
+        return;
+    }
+    const double dq = q[split_dim_[node]] - split_value_[node];
+    search_radius(dq < 0. ? 2 * node + 1 : 2 * node + 2, q, radius2, result);
+    if (dq * dq <= radius2) {
+        search_radius(dq < 0. ? 2 * node + 2 : 2 * node + 1, q, radius2, result);
+    }
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::do_closestPoints(const Point& p, size_t k, ValueList& result) const {
+    assert_built();
+    result.clear();
+    k = std::min(k, static_cast<size_t>(size()));
+    if (k == 0) {
+        return;
+    }
+    double q[DIMS];
+    for (int d = 0; d < DIMS; ++d) {
+        q[d] = p[d];
+    }
+    search_nearest(0, q, k, result);
+    std::sort_heap(result.begin(), result.end(), closer);
+    finalise(result);
+}
+
+template <typename PayloadT, typename PointT>
+typename KDTreeFlat<PayloadT, PointT>::Value KDTreeFlat<PayloadT, PointT>::do_closestPoint(const Point& p) const {
+    ValueList result;
+    do_closestPoints(p, 1, result);
+    ATLAS_ASSERT(not result.empty(), "KDTree is empty");
+    return result.front();
+}
+
+template <typename PayloadT, typename PointT>
+void KDTreeFlat<PayloadT, PointT>::do_closestPointsWithinRadius(const Point& p, double radius,
+                                                                ValueList& result) const {
+    assert_built();
+    result.clear();
+    if (size() == 0) {
+        return;
+    }
+    double q[DIMS];
+    for (int d = 0; d < DIMS; ++d) {
+        q[d] = p[d];
+    }
+    search_radius(0, q, radius * radius, result);
+    std::sort(result.begin(), result.end(), closer);
+    finalise(result);
+}
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace util
+}  // namespace atlas
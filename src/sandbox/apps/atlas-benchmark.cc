@@ -49,6 +49,8 @@
 #include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
 #include "atlas/mesh/actions/Reorder.h"
 #include "atlas/meshgenerator.h"
+#include "atlas/numerics/Nabla.h"
+#include "atlas/numerics/fvm/Method.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/Checksum.h"
 #include "atlas/parallel/HaloExchange.h"
@@ -141,6 +143,8 @@ public:
         add_option(new SimpleOption<bool>("details", "Show detailed timers (default=false)"));
         add_option(new SimpleOption<std::string>("reorder", "Reorder mesh (default=none)"));
         add_option(new SimpleOption<bool>("sort_edges", "Sort edges by lowest node local index"));
+        add_option(new SimpleOption<bool>(
+            "nabla", "Compute horizontal gradient with fvm Nabla operator instead of inline kernel (default=false)"));
     }
 
     void setup();
@@ -162,6 +166,9 @@ private:
 
     unique_ptr<array::Array> avgS_arr;
 
+    unique_ptr<numerics::fvm::Method> fvm;
+    numerics::Nabla nabla;
+
     std::vector<idx_t> pole_edges;
     std::vector<bool> is_ghost;
 
@@ -176,6 +183,7 @@ private:
     std::string gridname;
     std::string reorder{"none"};
     bool sort_edges{false};
+    bool use_nabla{false};
 
     TimerStats iteration_timer;
     TimerStats haloexchange_timer;
@@ -205,6 +213,7 @@ int AtlasBenchmark::execute(const Args& args) {
     args.get("output", output);
     args.get("reorder", reorder);
     args.get("sort_edges", sort_edges);
+    args.get("nabla", use_nabla);
     bool help(false);
     args.get("help", help);
 
@@ -221,6 +230,7 @@ int AtlasBenchmark::execute(const Args& args) {
     Log::info() << "  grid: " << gridname << endl;
     Log::info() << "  nlev: " << nlev << endl;
     Log::info() << "  niter: " << niter << endl;
+    Log::info() << "  nabla: " << (use_nabla ? "fvm" : "inline") << endl;
     Log::info() << endl;
     Log::info() << "  MPI tasks: " << mpi::comm().size() << endl;
     Log::info() << "  OpenMP threads per MPI task: " << atlas_omp_get_max_threads() << endl;
@@ -349,6 +359,14 @@ void AtlasBenchmark::setup() {
     double radius  = 6371.22e+03;  // Earth's radius
     double height  = 80.e+03;      // Height of atmosphere
     double deg2rad = M_PI / 180.;
+    if (use_nabla) {
+        // Before the dual mesh is scaled below, as the metric terms are computed from it
+        ATLAS_TRACE_SCOPE("Create fvm Nabla") {
+            fvm.reset(new numerics::fvm::Method(mesh, option::halo(halo) | option::levels(nlev) |
+                                                          util::Config("radius", radius)));
+            nabla = numerics::Nabla(*fvm);
+        }
+    }
     atlas_omp_parallel_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
         lonlat(jnode, LON) = lonlat(jnode, LON) * deg2rad;
         lonlat(jnode, LAT) = lonlat(jnode, LAT) * deg2rad;
@@ -422,43 +440,48 @@ void AtlasBenchmark::iteration() {
     auto grad = array::make_view<double, 3>(grad_field);
     auto avgS = array::make_view<double, 3>(*avgS_arr);
 
-    atlas_omp_parallel_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
-        idx_t ip1 = edge2node(jedge, 0);
-        idx_t ip2 = edge2node(jedge, 1);
-
-        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-            double avg             = (field(ip1, jlev) + field(ip2, jlev)) * 0.5;
-            avgS(jedge, jlev, LON) = S(jedge, LON) * avg;
-            avgS(jedge, jlev, LAT) = S(jedge, LAT) * avg;
-        }
+    if (use_nabla) {
+        nabla.gradient(scalar_field, grad_field);
     }
+    else {
+        atlas_omp_parallel_for(idx_t jedge = 0; jedge < nedges; ++jedge) {
+            idx_t ip1 = edge2node(jedge, 0);
+            idx_t ip2 = edge2node(jedge, 1);
 
-    atlas_omp_parallel_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
-        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-            grad(jnode, jlev, LON) = 0.;
-            grad(jnode, jlev, LAT) = 0.;
-        }
-        for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
-            idx_t iedge = node2edge(jnode, jedge);
-            double add  = node2edge_sign(jnode, jedge);
             for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-                grad(jnode, jlev, LON) += add * avgS(iedge, jlev, LON);
-                grad(jnode, jlev, LAT) += add * avgS(iedge, jlev, LAT);
+                double avg             = (field(ip1, jlev) + field(ip2, jlev)) * 0.5;
+                avgS(jedge, jlev, LON) = S(jedge, LON) * avg;
+                avgS(jedge, jlev, LAT) = S(jedge, LAT) * avg;
             }
         }
-        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-            grad(jnode, jlev, LON) /= V(jnode);
-            grad(jnode, jlev, LAT) /= V(jnode);
+
+        atlas_omp_parallel_for(idx_t jnode = 0; jnode < nnodes; ++jnode) {
+            for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+                grad(jnode, jlev, LON) = 0.;
+                grad(jnode, jlev, LAT) = 0.;
+            }
+            for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
+                idx_t iedge = node2edge(jnode, jedge);
+                double add  = node2edge_sign(jnode, jedge);
+                for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+                    grad(jnode, jlev, LON) += add * avgS(iedge, jlev, LON);
+                    grad(jnode, jlev, LAT) += add * avgS(iedge, jlev, LAT);
+                }
+            }
+            for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+                grad(jnode, jlev, LON) /= V(jnode);
+                grad(jnode, jlev, LAT) /= V(jnode);
+            }
         }
-    }
-    // special treatment for the north & south pole cell faces
-    // Sx == 0 at pole, and Sy has same sign at both sides of pole
-    for (size_t jedge = 0; jedge < pole_edges.size(); ++jedge) {
-        idx_t iedge = pole_edges[jedge];
-        idx_t ip2   = edge2node(iedge, 1);
-        // correct for wrong Y-derivatives in previous loop
-        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
-            grad(ip2, jlev, LAT) += 2. * avgS(iedge, jlev, LAT) / V(ip2);
+        // special treatment for the north & south pole cell faces
+        // Sx == 0 at pole, and Sy has same sign at both sides of pole
+        for (size_t jedge = 0; jedge < pole_edges.size(); ++jedge) {
+            idx_t iedge = pole_edges[jedge];
+            idx_t ip2   = edge2node(iedge, 1);
+            // correct for wrong Y-derivatives in previous loop
+            for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+                grad(ip2, jlev, LAT) += 2. * avgS(iedge, jlev, LAT) / V(ip2);
+            }
         }
     }
 
@@ -0,0 +1,141 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Benchmark of the flat kd-tree (detail::KDTreeFlat) against the eckit kd-tree (detail::KDTreeMemory):
+// build, k-nearest-neighbours and within-radius search, for points uniformly distributed on the sphere.
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eckit/log/Bytes.h"
+
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/Earth.h"
+#include "atlas/util/KDTree.h"
+#include "atlas/util/Point.h"
+
+using namespace atlas;
+using atlas::util::Config;
+using atlas::util::IndexKDTree;
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+std::vector<PointLonLat> random_points(size_t n, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> lon(0., 360.);
+    std::uniform_real_distribution<double> z(-1., 1.);
+    std::vector<PointLonLat> points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        points.emplace_back(lon(generator), std::asin(z(generator)) * 180. / M_PI);
+    }
+    return points;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute(const Args& args) override;
+    std::string briefDescription() override {
+        return "Benchmark of the flat kd-tree against the eckit kd-tree, for building and searching";
+    }
+    std::string usage() override {
+        return name() + " [--n=N] [--queries=N] [--k=N] [--radius=R] [--eckit=true|false] [--help]";
+    }
+
+public:
+    Tool(int argc, char** argv);
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
+    add_option(new SimpleOption<long>("n", "Number of points in the tree (default 1000000)"));
+    add_option(new SimpleOption<long>("queries", "Number of search queries (default 1000000)"));
+    add_option(new SimpleOption<long>("k", "Number of nearest neighbours searched (default 4)"));
+    add_option(new SimpleOption<double>("radius", "Search radius in km (default 2 * mean point spacing)"));
+    add_option(new SimpleOption<bool>("eckit", "Also benchmark the eckit kd-tree (default true)"));
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute(const Args& args) {
+    const size_t n        = args.getLong("n", 1000000);
+    const size_t queries  = args.getLong("queries", 1000000);
+    const size_t k        = args.getLong("k", 4);
+    const bool with_eckit = args.getBool("eckit", true);
+    const double spacing  = std::sqrt(4. * M_PI / n) * util::Earth::radius();
+    const double radius   = args.getDouble("radius", 2. * spacing * 1.e-3) * 1.e3;
+
+    const auto points  = random_points(n, 1);
+    const auto targets = random_points(queries, 2);
+    std::vector<idx_t> payloads(n);
+    for (size_t i = 0; i < n; ++i) {
+        payloads[i] = static_cast<idx_t>(i);
+    }
+
+    struct Result {
+        double distance{0.};
+        size_t found{0};
+    };
+
+    auto run = [&](const std::string& type) {
+        Result result;
+        IndexKDTree tree(Config("geometry", "Earth")("kdtree_type", type));
+        ATLAS_TRACE_SCOPE(type + " build") { tree.build(points, payloads); }
+        Log::info() << type << ": footprint " << eckit::Bytes(tree.footprint()) << std::endl;
+
+        IndexKDTree::ValueList neighbours;
+        ATLAS_TRACE_SCOPE(type + " closestPoints") {
+            for (const auto& p : targets) {
+                tree.closestPoints(p, k, neighbours);
+                result.distance += neighbours.back().distance();
+            }
+        }
+        ATLAS_TRACE_SCOPE(type + " closestPointsWithinRadius") {
+            for (const auto& p : targets) {
+                tree.closestPointsWithinRadius(p, radius, neighbours);
+                result.found += neighbours.size();
+            }
+        }
+        Log::info() << type << ": accumulated distance " << result.distance << ", found within radius "
+                    << result.found << std::endl;
+        return result;
+    };
+
+    Result flat = run("flat");
+    if (with_eckit) {
+        Result reference = run("eckit");
+        if (std::abs(flat.distance - reference.distance) > 1.e-9 * reference.distance ||
+            flat.found != reference.found) {
+            Log::error() << "Search results of flat and eckit kd-trees differ" << std::endl;
+            return failed();
+        }
+    }
+
+    Log::info() << Trace::report(Config("indent", 2)("decimals", 3)) << std::endl;
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    Tool tool(argc, argv);
+    return tool.start();
+}
@@ -0,0 +1,130 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+// Micro-benchmark of ConvexSphericalPolygon::intersect against the scalar reference
+// ConvexSphericalPolygon::intersect_scalar, on cells of a regular grid intersected with
+// shifted cells of a second regular grid.
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/ConvexSphericalPolygon.h"
+#include "atlas/util/Point.h"
+
+using namespace atlas;
+using atlas::util::Config;
+using atlas::util::ConvexSphericalPolygon;
+
+//------------------------------------------------------------------------------
+
+namespace {
+
+std::vector<ConvexSphericalPolygon> make_cells(int nlon, int nlat, double shift) {
+    const double dlon = 360. / nlon;
+    const double dlat = 180. / nlat;
+    std::vector<ConvexSphericalPolygon> cells;
+    cells.reserve(nlon * nlat);
+    for (int j = 0; j < nlat; ++j) {
+        const double lat0 = 90. - dlat * j;
+        const double lat1 = lat0 - dlat;
+        for (int i = 0; i < nlon; ++i) {
+            const double lon0 = dlon * i + shift * dlon;
+            const double lon1 = lon0 + dlon;
+            std::array<PointLonLat, 4> points{PointLonLat{lon0, lat0}, PointLonLat{lon0, lat1},
+                                              PointLonLat{lon1, lat1}, PointLonLat{lon1, lat0}};
+            cells.emplace_back(points);
+        }
+    }
+    return cells;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    int execute(const Args& args) override;
+    std::string briefDescription() override {
+        return "Micro-benchmark of the clipping kernel used to intersect ConvexSphericalPolygons";
+    }
+    std::string usage() override { return name() + " [--n=N] [--iterations=N] [--help]"; }
+
+public:
+    Tool(int argc, char** argv);
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool(int argc, char** argv): AtlasTool(argc, argv) {
+    add_option(new SimpleOption<long>("n", "Number of latitudes of the source grid (default 90)"));
+    add_option(new SimpleOption<long>("iterations", "Number of repetitions (default 5)"));
+}
+
+//-----------------------------------------------------------------------------
+
+int Tool::execute(const Args& args) {
+    const int nlat       = args.getLong("n", 90);
+    const int iterations = args.getLong("iterations", 5);
+
+    // Target cells are twice as fine as source cells, and shifted by a third of a cell in longitude,
+    // so that every target cell overlaps with one or two source cells of the same row
+    const auto src = make_cells(2 * nlat, nlat, 0.);
+    const auto tgt = make_cells(4 * nlat, 2 * nlat, 1. / 3.);
+
+    auto run = [&](const std::string& name, auto&& intersect) {
+        double area         = 0.;
+        size_t nb_intersect = 0;
+        ATLAS_TRACE_SCOPE(name) {
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                for (size_t t = 0; t < tgt.size(); ++t) {
+                    const size_t jt = t / (4 * nlat);
+                    const size_t it = t % (4 * nlat);
+                    const size_t js = jt / 2;
+                    for (size_t is : {(it / 2 + 2 * nlat - 1) % (2 * nlat), it / 2, (it / 2 + 1) % (2 * nlat)}) {
+                        auto iplg = intersect(src[js * 2 * nlat + is], tgt[t]);
+                        if (iplg) {
+                            area += iplg.area();
+                            ++nb_intersect;
+                        }
+                    }
+                }
+            }
+        }
+        Log::info() << name << ": " << nb_intersect << " intersections, accumulated area " << area << std::endl;
+        return area;
+    };
+
+    double area_scalar = run("intersect_scalar", [](const ConvexSphericalPolygon& p1, const ConvexSphericalPolygon& p2) {
+        return p1.intersect_scalar(p2);
+    });
+    double area = run("intersect", [](const ConvexSphericalPolygon& p1, const ConvexSphericalPolygon& p2) {
+        return p1.intersect(p2);
+    });
+
+    Log::info() << Trace::report(Config("indent", 2)("decimals", 3)) << std::endl;
+
+    if (area != area_scalar) {
+        Log::error() << "Accumulated areas differ: " << area << " != " << area_scalar << std::endl;
+        return failed();
+    }
+    return success();
+}
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    Tool tool(argc, argv);
+    return tool.start();
+}
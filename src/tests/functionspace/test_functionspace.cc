@@ -21,6 +21,7 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator.h"
+#include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/trans/Trans.h"
 
@@ -57,6 +58,31 @@ CASE("test_functionspace_NodeColumns_no_halo") {
     }
 }
 
+CASE("test_functionspace_NodeColumns_checksum_independent_of_partitioning") {
+    Grid grid("O8");
+    auto checksum = [&](const std::string& partitioner, double perturbation) {
+        Mesh mesh = StructuredMeshGenerator(util::Config("partitioner", partitioner)).generate(grid);
+        functionspace::NodeColumns nodes_fs(mesh, option::halo(1));
+        Field field  = nodes_fs.createField<double>(option::levels(3));
+        auto value   = array::make_view<double, 2>(field);
+        auto glb_idx = array::make_view<gidx_t, 1>(nodes_fs.global_index());
+        auto ghost   = array::make_view<int, 1>(nodes_fs.ghost());
+        for (idx_t j = 0; j < nodes_fs.size(); ++j) {
+            for (idx_t k = 0; k < 3; ++k) {
+                // Ghost values are not part of the checksum
+                value(j, k) = ghost(j) ? -1. : double(glb_idx(j) * 3 + k);
+            }
+            if (glb_idx(j) == 1 && not ghost(j)) {
+                value(j, 0) += perturbation;
+            }
+        }
+        return nodes_fs.checksum(field);
+    };
+    std::string reference = checksum("equal_regions", 0.);
+    EXPECT_EQ(checksum("equal_bands", 0.), reference);
+    EXPECT(checksum("equal_regions", 1.e-12) != reference);
+}
+
 CASE("test_functionspace_NodeColumns") {
     ReducedGaussianGrid grid({4, 8, 8, 4});
 
@@ -43,12 +43,16 @@ Grid grid() {
     return g;
 }
 
+// MD5 digest, as returned by the checksum of a FieldSet, of the parallel::Checksum of the field set by
+// field_init(): the decimal sum modulo 2^64 of util::hash64 over all grid points, of the value (double) g
+// seeded with g-1, for global indices g = 1 ... grid().size()
+// (O32: "7940657395266705958", N32: "3190575099790650611")
 std::string expected_checksum() {
     if (grid().name()=="O32") {
-        return "75e913d400755a0d2782fc65e2035e97";
+        return "533759bb848d0767bf5924effdc3da86";
     }
     else if (grid().name()=="N32") {
-        return "bcb344196d20becbb66f098d91f83abb";
+        return "2e0d97d1b10b297a82d58b63eb31503b";
     }
     else {
         return "unknown";
@@ -267,6 +267,10 @@ if (mpi::size() == 4) {
     }
 }
 
+// Owned points come first, followed by halo points
+for (idx_t i=0; i<pointcloud.size(); ++i) {
+    EXPECT_EQ(ghost(i), size_t(i) < count_ghost ? 0 : 1);
+}
 
 field.haloExchange();
 
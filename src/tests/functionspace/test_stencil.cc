@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include "eckit/linalg/Vector.h"
 #include "eckit/types/Types.h"
 
@@ -170,6 +171,66 @@ CASE("test horizontal stencil linear") {
     }
 }
 
+template <idx_t Width>
+void check_batched_stencils(const StructuredGrid& grid, const std::vector<double>& x, const std::vector<double>& y) {
+    const idx_t size = static_cast<idx_t>(x.size());
+    ComputeHorizontalStencil compute_stencil(grid, Width);
+    HorizontalStencils<Width> stencils;
+    compute_stencil(size, x.data(), y.data(), stencils);
+    EXPECT_EQ(stencils.size(), size);
+
+    HorizontalStencil<Width> stencil;
+    for (idx_t n = 0; n < size; ++n) {
+        compute_stencil(x[n], y[n], stencil);
+        for (idx_t j = 0; j < Width; ++j) {
+            EXPECT_EQ(stencils.j(n, j), stencil.j(j));
+            for (idx_t i = 0; i < Width; ++i) {
+                EXPECT_EQ(stencils.i(n, i, j), stencil.i(i, j));
+            }
+        }
+    }
+}
+
+CASE("test batched horizontal stencils") {
+    for (std::string gridname : {"O32", "F16", "L24x13"}) {
+        SECTION(gridname) {
+            StructuredGrid grid(gridname);
+
+            // Points across the whole sphere, including rows, poles and date line
+            std::vector<double> x, y;
+            for (idx_t j = 0; j < grid.ny(); ++j) {
+                for (double dy : {0., 0.1, -0.1}) {
+                    x.emplace_back(grid.x(0, j));
+                    y.emplace_back(std::max(-90., std::min(90., grid.y(j) + dy)));
+                }
+            }
+            for (double lat : {90., -90., 89.9999, -89.9999}) {
+                x.emplace_back(0.);
+                y.emplace_back(lat);
+            }
+            for (idx_t n = 0; n < 1000; ++n) {
+                x.emplace_back(360. * std::fmod(0.618033988749895 * n, 1.));
+                y.emplace_back(-90. + 180. * std::fmod(0.754877666246693 * n, 1.));
+            }
+            const idx_t size = static_cast<idx_t>(x.size());
+
+            // The northern row of a point is the southernmost row at or north of it
+            ComputeNorth compute_j_north(grid, 2);
+            for (idx_t n = 0; n < size; ++n) {
+                idx_t j = compute_j_north(y[n]);
+                if (j >= 0) {
+                    EXPECT(grid.y(j) >= y[n] - 0.5e-6);
+                }
+                if (j + 1 < grid.ny()) {
+                    EXPECT(grid.y(j + 1) < y[n] - 0.5e-6);
+                }
+            }
+
+            check_batched_stencils<4>(grid, x, y);
+            check_batched_stencils<2>(grid, x, y);
+        }
+    }
+}
 
 //-----------------------------------------------------------------------------
 
@@ -57,6 +57,46 @@ CASE("test_bands") {
     }
 }
 
+CASE("test partition_ranges") {
+    StructuredGrid grid = Grid("O32");
+    for (std::string type : {"bands", "regular_bands"}) {
+        SECTION(type) {
+            grid::Distribution dist(grid, grid::Partitioner(type));
+
+            for (int p = 0; p < dist.nb_partitions(); ++p) {
+                std::vector<grid::Distribution::Range> ranges;
+                EXPECT(dist.partition_ranges(p, ranges));
+                gidx_t count = 0;
+                for (const auto& range : ranges) {
+                    for (gidx_t n = range.first; n < range.second; ++n) {
+                        EXPECT_EQ(dist.partition(n), p);
+                    }
+                    count += range.second - range.first;
+                }
+                EXPECT_EQ(count, gidx_t(dist.nb_pts()[p]));
+            }
+
+            // Same StructuredColumns as when ownership is found by testing every point
+            grid::Distribution::partition_t part(grid.size());
+            dist.partition(0, grid.size(), part);
+            grid::Distribution array(dist.nb_partitions(), std::move(part));
+            std::vector<grid::Distribution::Range> ranges;
+            EXPECT(not array.partition_ranges(0, ranges));
+
+            functionspace::StructuredColumns fs_ranges(grid, dist, Config("halo", 1));
+            functionspace::StructuredColumns fs_array(grid, array, Config("halo", 1));
+            EXPECT_EQ(fs_ranges.sizeOwned(), fs_array.sizeOwned());
+            EXPECT_EQ(fs_ranges.size(), fs_array.size());
+            EXPECT_EQ(fs_ranges.j_begin(), fs_array.j_begin());
+            EXPECT_EQ(fs_ranges.j_end(), fs_array.j_end());
+            for (idx_t j = fs_array.j_begin(); j < fs_array.j_end(); ++j) {
+                EXPECT_EQ(fs_ranges.i_begin(j), fs_array.i_begin(j));
+                EXPECT_EQ(fs_ranges.i_end(j), fs_array.i_end(j));
+            }
+        }
+    }
+}
+
 CASE("test_regular_bands") {
     int nproc = mpi::size();
 
@@ -0,0 +1,92 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <string>
+#include <vector>
+
+#include "atlas/grid.h"
+#include "atlas/grid/detail/distribution/RunLengthDistribution.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/util/Config.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::grid::detail::distribution::RunLengthDistribution;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+void check_equal(const grid::Distribution& dist, const std::vector<int>& part) {
+    EXPECT_EQ(dist.size(), gidx_t(part.size()));
+    for (size_t n = 0; n < part.size(); ++n) {
+        EXPECT_EQ(dist.partition(n), part[n]);
+    }
+    std::vector<int> bulk(part.size() - 5);
+    dist.partition(5, part.size(), bulk);
+    for (size_t n = 0; n < bulk.size(); ++n) {
+        EXPECT_EQ(bulk[n], part[n + 5]);
+    }
+    std::vector<idx_t> nb_pts(dist.nb_partitions(), 0);
+    for (int p : part) {
+        ++nb_pts[p];
+    }
+    EXPECT(dist.nb_pts() == nb_pts);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test compress partition array") {
+    std::vector<int> part{0, 0, 0, 1, 1, 2, 2, 2, 2, 0, 0, 1, 1, 1, 2, 2};
+    EXPECT_EQ(RunLengthDistribution::nb_runs(part.size(), part.data()), 6);
+
+    grid::Distribution array(3, part.size(), part.data());
+    grid::Distribution runs(new RunLengthDistribution(3, part.size(), part.data(), array.type()));
+    check_equal(runs, part);
+    EXPECT_EQ(runs.hash(), array.hash());
+
+    std::vector<grid::Distribution::Range> ranges;
+    EXPECT(runs.partition_ranges(1, ranges));
+    EXPECT_EQ(ranges.size(), 2);
+    EXPECT_EQ(ranges[0].first, 3);
+    EXPECT_EQ(ranges[0].second, 5);
+    EXPECT_EQ(ranges[1].first, 11);
+    EXPECT_EQ(ranges[1].second, 14);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test equal_regions run-length distribution matches partition array") {
+    for (std::string gridname : {"O32", "N24", "L48x25", "F20"}) {
+        for (int nb_partitions : {int(mpi::size()), 7, 32}) {
+            SECTION(gridname + " " + std::to_string(nb_partitions)) {
+                Grid grid(gridname);
+                grid::Partitioner partitioner("equal_regions", nb_partitions);
+
+                std::vector<int> part(grid.size());
+                partitioner.partition(grid, part.data());
+
+                grid::Distribution dist = partitioner.partition(grid);
+                EXPECT(dist.footprint() < part.size() * sizeof(int));
+                check_equal(dist, part);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -9,7 +9,9 @@
  */
 
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "eckit/geometry/Sphere.h"
 #include "eckit/types/FloatCompare.h"
@@ -24,6 +26,7 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/option.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/Config.h"
 #include "atlas/util/function/VortexRollup.h"
 
@@ -228,6 +231,44 @@ CASE("test_interpolation_conservative") {
     }
 }
 
+CASE("test_interpolation_conservative independent of number of threads") {
+    auto func = [](const PointLonLat& p) { return util::function::vortex_rollup(p[0], p[1], 0.5); };
+
+    auto remap = [&](int order, bool src_cell_data, bool tgt_cell_data, int num_threads) {
+        int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads(num_threads);
+        util::Config config("type", "conservative-spherical-polygon");
+        config.set("order", order);
+        config.set("src_cell_data", src_cell_data);
+        config.set("tgt_cell_data", tgt_cell_data);
+        auto interpolation = Interpolation(config, Grid("O32"), Grid("H24"));
+        atlas_omp_set_num_threads(max_threads);
+
+        auto src_field = interpolation.source().createField<double>();
+        auto tgt_field = interpolation.target().createField<double>();
+        auto src_vals  = array::make_view<double, 1>(src_field);
+        auto& method   = dynamic_cast<ConservativeMethod&>(*interpolation.get());
+        for (idx_t spt = 0; spt < src_vals.size(); ++spt) {
+            PointLonLat pll;
+            eckit::geometry::Sphere::convertCartesianToSpherical(1., method.src_points(spt), pll);
+            src_vals(spt) = func(pll);
+        }
+        interpolation.execute(src_field, tgt_field);
+        auto tgt_vals = array::make_view<double, 1>(tgt_field);
+        return std::vector<double>(tgt_vals.data(), tgt_vals.data() + tgt_vals.size());
+    };
+
+    for (int order : {1, 2}) {
+        for (bool src_cell_data : {true, false}) {
+            for (bool tgt_cell_data : {true, false}) {
+                auto serial   = remap(order, src_cell_data, tgt_cell_data, 1);
+                auto threaded = remap(order, src_cell_data, tgt_cell_data, std::max(4, atlas_omp_get_max_threads()));
+                EXPECT(serial == threaded);
+            }
+        }
+    }
+}
+
 }  // namespace test
 }  // namespace atlas
 
@@ -8,7 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <string>
+#include <vector>
 
 #include "eckit/types/FloatCompare.h"
 
@@ -19,6 +22,7 @@
 #include "atlas/interpolation.h"
 #include "atlas/mesh.h"
 #include "atlas/meshgenerator.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/CoordinateEnums.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -80,6 +84,203 @@ CASE("test_interpolation_finite_element") {
 
 //-----------------------------------------------------------------------------
 
+CASE("test_interpolation_finite_element independent of number of threads") {
+    Grid grid("O32");
+    Mesh mesh(grid);
+    NodeColumns fs(mesh);
+    PointCloud pointcloud(Grid("O48"));  // spans several chunks of target points
+
+    Field field_source = fs.createField<double>(option::name("source"));
+    auto lonlat        = array::make_view<double, 2>(fs.nodes().lonlat());
+    auto source        = array::make_view<double, 1>(field_source);
+    for (idx_t j = 0; j < fs.nodes().size(); ++j) {
+        source(j) = std::sin(lonlat(j, LON) * M_PI / 180.) * std::cos(lonlat(j, LAT) * M_PI / 180.);
+    }
+
+    auto interpolate = [&](int num_threads) {
+        int max_threads = atlas_omp_get_max_threads();
+        atlas_omp_set_num_threads(num_threads);
+        Interpolation interpolation(option::type("finite-element"), fs, pointcloud);
+        atlas_omp_set_num_threads(max_threads);
+
+        Field field_target("target", array::make_datatype<double>(), array::make_shape(pointcloud.size()));
+        interpolation.execute(field_source, field_target);
+        auto target = array::make_view<double, 1>(field_target);
+        return std::vector<double>(target.data(), target.data() + target.size());
+    };
+
+    auto serial   = interpolate(1);
+    auto threaded = interpolate(std::max(4, atlas_omp_get_max_threads()));
+    EXPECT(serial == threaded);
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("test_interpolation_finite_element FieldSet matches individual Fields") {
+    Grid grid("O32");
+    Mesh mesh(grid);
+    NodeColumns fs(mesh);
+    PointCloud pointcloud(Grid("O16"));
+    const idx_t nlev = 5;
+
+    auto lonlat = array::make_view<double, 2>(fs.nodes().lonlat());
+    auto func   = [&](idx_t j, idx_t k) {
+        return std::sin(lonlat(j, LON) * M_PI / 180.) * std::cos(lonlat(j, LAT) * M_PI / 180.) + 0.1 * k;
+    };
+
+    FieldSet fields_source;
+    fields_source.add(fs.createField<double>(option::name("d1")));
+    fields_source.add(fs.createField<double>(option::name("d2") | option::levels(nlev)));
+    fields_source.add(fs.createField<float>(option::name("f1")));
+    fields_source.add(fs.createField<float>(option::name("f2") | option::levels(nlev)));
+    for (auto& field : fields_source) {
+        const idx_t levels = std::max(field.levels(), 1);
+        for (idx_t j = 0; j < fs.nodes().size(); ++j) {
+            for (idx_t k = 0; k < levels; ++k) {
+                if (field.datatype() == array::make_datatype<double>()) {
+                    field.array().data<double>()[j * levels + k] = func(j, k);
+                }
+                else {
+                    field.array().data<float>()[j * levels + k] = static_cast<float>(func(j, k));
+                }
+            }
+        }
+    }
+
+    auto create_target = [&](const Field& source) {
+        auto shape = source.shape();
+        shape[0]   = pointcloud.size();
+        return Field(source.name(), source.datatype(), array::ArrayShape(shape));
+    };
+    FieldSet fields_target;
+    for (auto& field : fields_source) {
+        fields_target.add(create_target(field));
+    }
+
+    Interpolation interpolation(option::type("finite-element"), fs, pointcloud);
+    interpolation.execute(fields_source, fields_target);
+
+    for (idx_t i = 0; i < fields_source.size(); ++i) {
+        Field field_target = create_target(fields_source[i]);
+        interpolation.execute(fields_source[i], field_target);
+        EXPECT_EQ(field_target.size(), fields_target[i].size());
+        for (idx_t n = 0; n < field_target.size(); ++n) {
+            if (field_target.datatype() == array::make_datatype<double>()) {
+                EXPECT_APPROX_EQ(fields_target[i].array().data<double>()[n], field_target.array().data<double>()[n],
+                                 1.e-14);
+            }
+            else {
+                EXPECT_APPROX_EQ(fields_target[i].array().data<float>()[n], field_target.array().data<float>()[n],
+                                 1.e-6f);
+            }
+        }
+    }
+}
+
+CASE("test_interpolation_finite_element structured locator") {
+    auto func = [](double lon, double lat) {
+        return std::sin(lon * M_PI / 180.) * std::cos(lat * M_PI / 180.) + std::sin(2. * lat * M_PI / 180.);
+    };
+    for (std::string gridname : {"O32", "F24", "L36x19"}) {
+        SECTION(gridname) {
+            Grid grid(gridname);
+            Mesh mesh(grid);
+            NodeColumns fs(mesh);
+
+            // Target points include the poles, grid points of the source, and points on the date line
+            std::vector<PointLonLat> points{{0., 90.}, {0., -90.}, {180., 89.99}, {-180., -89.99}, {360., 0.}};
+            for (auto p : grid.lonlat()) {
+                points.emplace_back(p);
+            }
+            Grid other("O24");
+            for (auto p : other.lonlat()) {
+                points.emplace_back(p);
+            }
+            PointCloud pointcloud(points);
+
+            Field field_source = fs.createField<double>(option::name("source"));
+            auto lonlat        = array::make_view<double, 2>(fs.nodes().lonlat());
+            auto source        = array::make_view<double, 1>(field_source);
+            for (idx_t j = 0; j < fs.nodes().size(); ++j) {
+                source(j) = func(lonlat(j, LON), lonlat(j, LAT));
+            }
+
+            auto interpolate = [&](bool use_structured_locator) {
+                Interpolation interpolation(option::type("finite-element") |
+                                                util::Config("use_structured_locator", use_structured_locator),
+                                            fs, pointcloud);
+                Field field_target("target", array::make_datatype<double>(), array::make_shape(pointcloud.size()));
+                interpolation.execute(field_source, field_target);
+                auto target = array::make_view<double, 1>(field_target);
+                return std::vector<double>(target.data(), target.data() + target.size());
+            };
+
+            auto located  = interpolate(true);
+            auto searched = interpolate(false);
+            EXPECT_EQ(located.size(), searched.size());
+            for (size_t j = 0; j < located.size(); ++j) {
+                EXPECT_APPROX_EQ(located[j], searched[j], 1.e-12);
+            }
+        }
+    }
+}
+
+CASE("test_interpolation_finite_element compact matrix storage") {
+    Grid grid("O32");
+    Mesh mesh(grid);
+    NodeColumns fs(mesh);
+    PointCloud pointcloud(Grid("O16"));
+    const idx_t nlev = 3;
+
+    Field field_source = fs.createField<double>(option::name("source") | option::levels(nlev));
+    auto lonlat        = array::make_view<double, 2>(fs.nodes().lonlat());
+    auto source        = array::make_view<double, 2>(field_source);
+    for (idx_t j = 0; j < fs.nodes().size(); ++j) {
+        for (idx_t k = 0; k < nlev; ++k) {
+            source(j, k) = std::sin(lonlat(j, LON) * M_PI / 180.) * std::cos(lonlat(j, LAT) * M_PI / 180.) + k;
+        }
+    }
+
+    auto interpolate = [&](const util::Config& storage) {
+        Interpolation interpolation(option::type("finite-element") | storage, fs, pointcloud);
+        Field field_target("target", array::make_datatype<double>(), array::make_shape(pointcloud.size(), nlev));
+        interpolation.execute(field_source, field_target);
+        auto target = array::make_view<double, 2>(field_target);
+        return std::vector<double>(target.data(), target.data() + target.size());
+    };
+
+    auto reference        = interpolate(util::Config());
+    auto compact          = interpolate(util::Config("matrix_compact_indices", true));
+    auto single_precision = interpolate(util::Config("matrix_single_precision", true));
+    EXPECT_EQ(compact.size(), reference.size());
+    EXPECT_EQ(single_precision.size(), reference.size());
+    for (size_t j = 0; j < reference.size(); ++j) {
+        EXPECT_APPROX_EQ(compact[j], reference[j], 1.e-14);
+        // Weights rounded to single precision, values up to nlev in magnitude
+        EXPECT_APPROX_EQ(single_precision[j], reference[j], 1.e-6);
+    }
+
+    // The full matrix is released in favour of the compact copy, and rebuilt from it for a cache
+    auto matrix = [&](const util::Config& storage) {
+        Interpolation interpolation(option::type("finite-element") | storage, fs, pointcloud);
+        return interpolation::MatrixCache(interpolation).matrix();
+    };
+    auto reference_matrix = matrix(util::Config());
+    for (auto storage : {util::Config("matrix_compact_indices", true),
+                         util::Config("matrix_compact_indices", true)("matrix_keep_full", true)}) {
+        auto cached_matrix = matrix(storage);
+        EXPECT_EQ(cached_matrix.rows(), reference_matrix.rows());
+        EXPECT_EQ(cached_matrix.cols(), reference_matrix.cols());
+        EXPECT_EQ(cached_matrix.nonZeros(), reference_matrix.nonZeros());
+        EXPECT(std::equal(reference_matrix.inner(), reference_matrix.inner() + reference_matrix.nonZeros(),
+                          cached_matrix.inner()));
+        EXPECT(std::equal(reference_matrix.data(), reference_matrix.data() + reference_matrix.nonZeros(),
+                          cached_matrix.data()));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
@@ -10,6 +10,8 @@
 
 
 #include <cmath>
+#include <set>
+#include <vector>
 
 #include "eckit/log/Bytes.h"
 
@@ -249,6 +251,33 @@ CASE("test_interpolation_grid_box_average matrix with cache") {
     ATLAS_TRACE_SCOPE("Interpolate with cache") { Interpolation(config, gridA, gridB, cache).execute(fieldA, fieldB); }
 }
 
+CASE("test_interpolation_grid_box_average candidates") {
+    // Candidates are a superset of the intersecting grid boxes, without duplicates
+    auto check = [](const Grid& source, const Grid& target) {
+        GridBoxes sourceBoxes(source);
+        GridBoxes targetBoxes(target);
+
+        std::vector<size_t> candidates;
+        for (const auto& box : targetBoxes) {
+            sourceBoxes.candidates(box, candidates);
+            std::set<size_t> unique(candidates.begin(), candidates.end());
+            EXPECT_EQ(unique.size(), candidates.size());
+
+            for (size_t j = 0; j < sourceBoxes.size(); ++j) {
+                auto smallBox = sourceBoxes[j];
+                if (box.intersects(smallBox)) {
+                    EXPECT(unique.count(j) == 1);
+                }
+            }
+        }
+    };
+
+    check(Grid("O16"), Grid("O8"));
+    check(Grid("O8"), Grid("F16"));
+    check(Grid("L36x19"), Grid("O8"));
+    check(Grid("O8"), Grid("L36x19"));
+}
+
 }  // namespace test
 }  // namespace atlas
 
@@ -27,6 +27,8 @@
 #include "atlas/meshgenerator.h"
 #include "atlas/option.h"
 #include "atlas/util/Config.h"
+#include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/PersistentKDTree.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -86,6 +88,47 @@ CASE("test_interpolation_k_nearest_neighbours") {
 
 //-----------------------------------------------------------------------------
 
+CASE("test_interpolation_k_nearest_neighbours with persistent kd-tree") {
+    Grid gridA("O32");
+    Grid gridB("O64");
+
+    util::PersistentKDTree persistent_kdtree("atlas_test_interpolation_k_nearest_neighbours_kdtree");
+
+    auto interpolate = [](const Interpolation& interpolation) {
+        auto source = interpolation.source().createField<double>();
+        auto target = interpolation.target().createField<double>();
+        auto lonlat = array::make_view<double, 2>(interpolation.source().lonlat());
+        auto values = array::make_view<double, 1>(source);
+        for (idx_t j = 0; j < values.size(); ++j) {
+            values(j) = std::cos(lonlat(j, LAT) * M_PI / 180.) * std::sin(lonlat(j, LON) * M_PI / 180.);
+        }
+        interpolation.execute(source, target);
+        return target;
+    };
+
+    for (auto config : {Config("type", "k-nearest-neighbours") | Config("k-nearest-neighbours", 4),
+                        Config("type", "nearest-neighbour")}) {
+        // Payloads of the stored tree are grid indices, and the source is the non-distributed PointCloud of gridA
+        Interpolation cached(config, gridA, gridB, interpolation::IndexKDTreeCache(persistent_kdtree(gridA)));
+        EXPECT_EQ(cached.source().type(), "PointCloud");
+
+        Field field           = interpolate(cached);
+        Field field_reference = interpolate(Interpolation(config, gridA, gridB));
+        auto target           = array::make_view<double, 1>(field);
+        auto target_reference = array::make_view<double, 1>(field_reference);
+        EXPECT_EQ(target.size(), target_reference.size());
+        for (idx_t j = 0; j < target.size(); ++j) {
+            EXPECT_APPROX_EQ(target(j), target_reference(j), 1.e-12);
+        }
+
+        // A tree of other points does not apply to the source
+        interpolation::IndexKDTreeCache other(persistent_kdtree(gridB));
+        EXPECT_THROWS_AS(Interpolation(config, gridA, gridB, other), eckit::AssertionFailed);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 CASE("test_multiple_fs") {
     Grid grid1("L90x45");
     Grid grid2("O8");
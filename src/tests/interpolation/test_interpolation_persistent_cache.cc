@@ -0,0 +1,178 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "eckit/log/Bytes.h"
+
+#include "atlas/array.h"
+#include "atlas/grid.h"
+#include "atlas/interpolation.h"
+#include "atlas/interpolation/PersistentMatrixCache.h"
+#include "atlas/option.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+using interpolation::MatrixCache;
+using interpolation::PersistentMatrixCache;
+
+eckit::PathName cache_directory(const std::string& name) {
+    return "atlas_test_interpolation_persistent_cache." + name + ".p" + std::to_string(mpi::rank());
+}
+
+void remove(const PersistentMatrixCache& persistent_cache, const std::string& key) {
+    if (persistent_cache.path(key).exists()) {
+        persistent_cache.path(key).unlink();
+    }
+}
+
+bool equal(const MatrixCache::Matrix& a, const MatrixCache::Matrix& b) {
+    return a.rows() == b.rows() && a.cols() == b.cols() && a.nonZeros() == b.nonZeros() &&
+           std::memcmp(a.outer(), b.outer(), (a.rows() + 1) * sizeof(*a.outer())) == 0 &&
+           std::memcmp(a.inner(), b.inner(), a.nonZeros() * sizeof(*a.inner())) == 0 &&
+           std::memcmp(a.data(), b.data(), a.nonZeros() * sizeof(*a.data())) == 0;
+}
+
+auto func = [](double x, double) -> double { return std::sin(x * M_PI / 180.); };
+
+//-----------------------------------------------------------------------------
+
+CASE("store and load matrix") {
+    Grid grid_source("F32");
+    Grid grid_target("F16");
+    auto config = option::type("finite-element");
+
+    PersistentMatrixCache persistent_cache(cache_directory("roundtrip"));
+    std::string key = persistent_cache.key(config, grid_source, grid_target);
+    remove(persistent_cache, key);
+
+    EXPECT(key != persistent_cache.key(config, grid_target, grid_source));
+    EXPECT(key != persistent_cache.key(option::type("structured-linear2D"), grid_source, grid_target));
+    EXPECT(not persistent_cache.load(key));
+
+    MatrixCache computed(Interpolation(config, grid_source, grid_target));
+    EXPECT(computed);
+    persistent_cache.store(key, computed);
+    EXPECT(persistent_cache.path(key).exists());
+    Log::info() << "Cache directory contains " << eckit::Bytes(persistent_cache.footprint()) << std::endl;
+
+    MatrixCache loaded = persistent_cache.load(key);
+    EXPECT(loaded);
+    EXPECT_EQ(loaded.uid(), key);
+    EXPECT(equal(loaded.matrix(), computed.matrix()));
+
+    // Loaded matrix remains valid after its record is removed
+    remove(persistent_cache, key);
+    EXPECT(equal(loaded.matrix(), computed.matrix()));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("use with Interpolation") {
+    if (mpi::size() > 1) {
+        // Fields below are defined on the complete grids
+        return;
+    }
+    Grid grid_source("F32");
+    Grid grid_target("F16");
+    auto config = option::type("finite-element");
+
+    PersistentMatrixCache persistent_cache(cache_directory("interpolation"));
+    remove(persistent_cache, persistent_cache.key(config, grid_source, grid_target));
+
+    Field field_source("source", array::make_datatype<double>(), array::make_shape(grid_source.size()));
+    Field field_target("target", array::make_datatype<double>(), array::make_shape(grid_target.size()));
+    {
+        auto view = array::make_view<double, 1>(field_source);
+        idx_t j{0};
+        for (auto& p : grid_source.lonlat()) {
+            view(j++) = func(p.lon(), p.lat());
+        }
+    }
+
+    // First call computes and stores the matrix, second call loads it
+    auto computed = persistent_cache(config, grid_source, grid_target);
+    EXPECT(persistent_cache.path(persistent_cache.key(config, grid_source, grid_target)).exists());
+    auto loaded = persistent_cache(config, grid_source, grid_target);
+    EXPECT(equal(loaded.matrix(), computed.matrix()));
+
+    Interpolation interpolation_using_cache(config, grid_source, grid_target, loaded);
+    interpolation_using_cache.execute(field_source, field_target);
+
+    auto view = array::make_view<double, 1>(field_target);
+    idx_t j{0};
+    for (auto& p : grid_target.lonlat()) {
+        EXPECT_APPROX_EQ(view(j++), func(p.lon(), p.lat()), 1.e-4);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("evict least recently used") {
+    Grid grid_source("F16");
+    Grid grid_target1("O8");
+    Grid grid_target2("O16");
+    auto config = option::type("finite-element");
+
+    // Room for a single matrix at a time
+    PersistentMatrixCache persistent_cache(cache_directory("eviction"), util::Config("max_size", 1));
+    std::string key1 = persistent_cache.key(config, grid_source, grid_target1);
+    std::string key2 = persistent_cache.key(config, grid_source, grid_target2);
+    remove(persistent_cache, key1);
+    remove(persistent_cache, key2);
+
+    persistent_cache(config, grid_source, grid_target1);
+    EXPECT(persistent_cache.path(key1).exists());
+
+    persistent_cache(config, grid_source, grid_target2);
+    EXPECT(persistent_cache.path(key2).exists());
+    EXPECT(not persistent_cache.path(key1).exists());
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("record missing on one rank only") {
+    Grid grid_source("F16");
+    Grid grid_target("O8");
+    auto config = option::type("finite-element");
+
+    PersistentMatrixCache persistent_cache(cache_directory("partial"));
+    std::string key = persistent_cache.key(config, grid_source, grid_target);
+    remove(persistent_cache, key);
+
+    persistent_cache(config, grid_source, grid_target);
+    EXPECT(persistent_cache.path(key).exists());
+    EXPECT_EQ(persistent_cache(config, grid_source, grid_target).uid(), key);
+
+    // As if evicted on the last rank only: every rank recomputes, collectively, instead of loading its record
+    if (mpi::rank() == mpi::size() - 1) {
+        remove(persistent_cache, key);
+    }
+    auto cache = persistent_cache(config, grid_source, grid_target);
+    EXPECT(cache);
+    EXPECT(cache.uid() != key);
+    EXPECT(persistent_cache.path(key).exists());
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
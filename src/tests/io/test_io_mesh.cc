@@ -0,0 +1,266 @@
+/*
+ * (C) Copyright 2023 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
+#include "atlas/meshgenerator.h"
+#include "atlas/parallel/GatherScatter.h"
+#include "atlas/parallel/HaloExchange.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "atlas/io/atlas-io.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+std::string record_path() {
+    return "atlas_test_io_mesh.p" + std::to_string(mpi::rank()) + ".atlas";
+}
+
+Mesh generate_mesh() {
+    Mesh mesh = StructuredMeshGenerator().generate(Grid("O16"));
+    mesh::actions::build_parallel_fields(mesh);
+    mesh::actions::build_periodic_boundaries(mesh);
+    mesh::actions::build_halo(mesh, 2);
+    mesh::actions::build_edges(mesh);
+    mesh::actions::build_node_to_edge_connectivity(mesh);
+    return mesh;
+}
+
+bool equal(const Field& a, const Field& b) {
+    return a.datatype() == b.datatype() && a.shape() == b.shape() &&
+           ::memcmp(a.array().data(), b.array().data(), a.size() * a.datatype().size()) == 0;
+}
+
+template <typename Connectivity>
+bool equal(const Connectivity& a, const Connectivity& b) {
+    if (a.rows() != b.rows()) {
+        return false;
+    }
+    for (idx_t r = 0; r < a.rows(); ++r) {
+        if (a.cols(r) != b.cols(r)) {
+            return false;
+        }
+        for (idx_t c = 0; c < a.cols(r); ++c) {
+            if (a(r, c) != b(r, c)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void check_elements(const mesh::HybridElements& original, const mesh::HybridElements& decoded) {
+    EXPECT_EQ(decoded.size(), original.size());
+    EXPECT_EQ(decoded.nb_types(), original.nb_types());
+    for (idx_t t = 0; t < original.nb_types(); ++t) {
+        EXPECT_EQ(decoded.element_type(t).name(), original.element_type(t).name());
+        EXPECT_EQ(decoded.elements(t).size(), original.elements(t).size());
+    }
+    EXPECT_EQ(decoded.nb_fields(), original.nb_fields());
+    for (idx_t f = 0; f < original.nb_fields(); ++f) {
+        const auto& field = original.field(f);
+        EXPECT(decoded.has_field(field.name()));
+        EXPECT(equal(decoded.field(field.name()), field));
+    }
+    EXPECT(equal(decoded.node_connectivity(), original.node_connectivity()));
+    EXPECT(equal(decoded.edge_connectivity(), original.edge_connectivity()));
+    EXPECT(equal(decoded.cell_connectivity(), original.cell_connectivity()));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Write and read Mesh") {
+    Mesh original = generate_mesh();
+    {
+        io::RecordWriter record;
+        io::encode(original, record, "mesh");
+        record.write(record_path());
+    }
+
+    Mesh decoded;
+    {
+        io::RecordReader record(record_path());
+        io::decode(record, decoded, "mesh");
+    }
+
+    SECTION("metadata") {
+        EXPECT_EQ(decoded.metadata().getInt("nb_nodes_including_halo[2]"),
+                  original.metadata().getInt("nb_nodes_including_halo[2]"));
+        EXPECT_EQ(decoded.metadata().getInt("halo"), original.metadata().getInt("halo"));
+        EXPECT_EQ(decoded.grid().name(), original.grid().name());
+        EXPECT_EQ(decoded.part(), original.part());
+        EXPECT_EQ(decoded.nb_parts(), original.nb_parts());
+    }
+
+    SECTION("nodes") {
+        EXPECT_EQ(decoded.nodes().size(), original.nodes().size());
+        EXPECT_EQ(decoded.nodes().nb_fields(), original.nodes().nb_fields());
+        for (idx_t f = 0; f < original.nodes().nb_fields(); ++f) {
+            const auto& field = original.nodes().field(f);
+            EXPECT(decoded.nodes().has_field(field.name()));
+            EXPECT(equal(decoded.nodes().field(field.name()), field));
+        }
+        EXPECT(equal(decoded.nodes().edge_connectivity(), original.nodes().edge_connectivity()));
+        EXPECT(equal(decoded.nodes().cell_connectivity(), original.nodes().cell_connectivity()));
+    }
+
+    SECTION("cells") { check_elements(original.cells(), decoded.cells()); }
+
+    SECTION("edges") { check_elements(original.edges(), decoded.edges()); }
+
+    SECTION("functionspace") {
+        functionspace::NodeColumns fs_original(original, option::halo(2));
+        functionspace::NodeColumns fs_decoded(decoded, option::halo(2));
+        EXPECT_EQ(fs_decoded.size(), fs_original.size());
+        EXPECT_EQ(fs_decoded.nb_nodes_global(), fs_original.nb_nodes_global());
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Write and read HaloExchange and GatherScatter") {
+    Mesh mesh = generate_mesh();
+    functionspace::NodeColumns fs(mesh, option::halo(2));
+
+    {
+        io::RecordWriter record;
+        io::encode(fs.halo_exchange(), record, "halo_exchange");
+        io::encode(fs.gather(), record, "gather_scatter");
+        record.write(record_path());
+    }
+
+    parallel::HaloExchange halo_exchange;
+    parallel::GatherScatter gather_scatter;
+    {
+        io::RecordReader record(record_path());
+        io::decode(record, halo_exchange, "halo_exchange");
+        io::decode(record, gather_scatter, "gather_scatter");
+    }
+
+    Field field1 = fs.createField<double>(option::name("field1"));
+    Field field2 = fs.createField<double>(option::name("field2"));
+    auto gidx    = array::make_view<gidx_t, 1>(fs.nodes().global_index());
+    auto ghost   = array::make_view<int, 1>(fs.nodes().ghost());
+    auto view1   = array::make_view<double, 1>(field1);
+    auto view2   = array::make_view<double, 1>(field2);
+    for (idx_t n = 0; n < fs.size(); ++n) {
+        view1(n) = ghost(n) ? 0. : double(gidx(n));
+        view2(n) = view1(n);
+    }
+
+    fs.halo_exchange().execute<double, 1>(field1.array());
+    halo_exchange.execute<double, 1>(field2.array());
+    EXPECT(equal(field1, field2));
+
+    EXPECT_EQ(gather_scatter.glb_dof(), fs.gather().glb_dof());
+    EXPECT_EQ(gather_scatter.loc_dof(), fs.gather().loc_dof());
+
+    Field global1 = fs.createField<double>(option::global());
+    Field global2 = fs.createField<double>(option::global());
+    auto global1_view = array::make_view<double, 1>(global1);
+    auto global2_view = array::make_view<double, 1>(global2);
+    fs.gather().gather(view1, global1_view);
+    gather_scatter.gather(view2, global2_view);
+    EXPECT(equal(global1, global2));
+}
+
+//-----------------------------------------------------------------------------
+
+CASE("Install decoded HaloExchange and GatherScatter in NodeColumns") {
+    Mesh mesh = generate_mesh();
+    functionspace::NodeColumns fs(mesh, option::halo(2));
+
+    // State added after setup() is restored as well
+    parallel::GatherScatter gather_scatter_writers;
+    {
+        io::RecordWriter record;
+        io::encode(fs.gather(), record, "gather_scatter");
+        record.write(record_path());
+    }
+    {
+        io::RecordReader record(record_path());
+        io::decode(record, gather_scatter_writers, "gather_scatter");
+    }
+    gather_scatter_writers.setup_writers(std::min<idx_t>(2, mpi::size()));
+    gather_scatter_writers.max_batch_bytes(1024);
+
+    {
+        io::RecordWriter record;
+        io::encode(fs.halo_exchange(), record, "halo_exchange");
+        io::encode(gather_scatter_writers, record, "gather_scatter");
+        record.write(record_path());
+    }
+
+    auto* halo_exchange  = new parallel::HaloExchange();
+    auto* gather_scatter = new parallel::GatherScatter();
+    {
+        io::RecordReader record(record_path());
+        io::decode(record, *halo_exchange, "halo_exchange");
+        io::decode(record, *gather_scatter, "gather_scatter");
+    }
+    EXPECT_EQ(gather_scatter->max_batch_bytes(), size_t(1024));
+    EXPECT_EQ(gather_scatter->slab_begin(), gather_scatter_writers.slab_begin());
+    EXPECT_EQ(gather_scatter->slab_size(), gather_scatter_writers.slab_size());
+
+    // A new function space uses the decoded objects instead of setting up its own
+    functionspace::NodeColumns fs_decoded(mesh, option::halo(2));
+    fs_decoded.set_halo_exchange(halo_exchange);
+    fs_decoded.set_gather_scatter(gather_scatter);
+    EXPECT(&fs_decoded.halo_exchange() == halo_exchange);
+    EXPECT(&fs_decoded.gather() == gather_scatter);
+
+    Field field1 = fs.createField<double>(option::name("field1"));
+    Field field2 = fs_decoded.createField<double>(option::name("field2"));
+    auto gidx    = array::make_view<gidx_t, 1>(fs.nodes().global_index());
+    auto ghost   = array::make_view<int, 1>(fs.nodes().ghost());
+    auto view1   = array::make_view<double, 1>(field1);
+    auto view2   = array::make_view<double, 1>(field2);
+    for (idx_t n = 0; n < fs.size(); ++n) {
+        view1(n) = ghost(n) ? 0. : double(gidx(n));
+        view2(n) = view1(n);
+    }
+    fs.haloExchange(field1);
+    fs_decoded.haloExchange(field2);
+    EXPECT(equal(field1, field2));
+
+    Field global1 = fs.createField<double>(option::global());
+    Field global2 = fs_decoded.createField<double>(option::global());
+    fs.gather(field1, global1);
+    fs_decoded.gather(field2, global2);
+    EXPECT(equal(global1, global2));
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main(int argc, char** argv) {
+    return atlas::test::run(argc, argv);
+}
@@ -8,6 +8,8 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
 #include <vector>
 
@@ -16,6 +18,7 @@
 
 #include "atlas/array.h"
 #include "atlas/linalg/sparse.h"
+#include "atlas/parallel/omp/omp.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -328,6 +331,178 @@ CASE("sparse_matrix matrix multiply (spmm)") {
     }
 }
 
+CASE("sparse_matrix transpose multiply add") {
+    // A^T = 2  .  .
+    //       .  2  .
+    //      -3  .  2
+    SparseMatrix A{3, 3, {{0, 0, 2.}, {0, 2, -3.}, {1, 1, 2.}, {2, 2, 2.}}};
+    Matrix m{{1., 2.}, {3., 4.}, {5., 6.}};
+    Matrix c_exp{{3., 5.}, {7., 9.}, {8., 7.}};  // 1 + A^T m
+
+    SECTION("View of atlas::Array, rank 1") {
+        ArrayVector<double> x(Vector{1., 2., 3.});
+        ArrayVector<double> y(Vector{1., 1., 1.});
+        sparse_matrix_transpose_multiply_add(A, x.view(), y.view());
+        expect_equal(y.view(), Vector{3., 5., 4.});
+    }
+
+    SECTION("View of atlas::Array PointsLeft") {
+        ArrayMatrix<float> ma(m);
+        ArrayMatrix<float> c(Matrix{{1., 1.}, {1., 1.}, {1., 1.}});
+        sparse_matrix_transpose_multiply_add(A, ma.view(), c.view());
+        expect_equal(c.view(), ArrayMatrix<float>(c_exp).view());
+    }
+
+    SECTION("View of atlas::Array PointsRight") {
+        ArrayMatrix<double, Indexing::layout_right> ma(m);
+        ArrayMatrix<double, Indexing::layout_right> c(Matrix{{1., 1.}, {1., 1.}, {1., 1.}});
+        sparse_matrix_transpose_multiply_add(A, ma.view(), c.view(), Indexing::layout_right);
+        expect_equal(c.view(), ArrayMatrix<double, Indexing::layout_right>(c_exp).view());
+    }
+
+    SECTION("Consistent with transposed matrix, independent of number of threads") {
+        // Banded matrix with many row blocks, whose column ranges overlap with their neighbours
+        const int rows = 5000;
+        const int cols = 3000;
+        std::vector<eckit::linalg::Triplet> triplets;
+        for (int r = 0; r < rows; ++r) {
+            for (int j = 0; j < 4; ++j) {
+                int c = (r * cols / rows + 37 * j) % cols;
+                triplets.emplace_back(r, c, 1. / (1. + r % 7 + j));
+            }
+        }
+        std::sort(triplets.begin(), triplets.end());
+        SparseMatrix B(rows, cols, triplets);
+        SparseMatrix Bt(B);
+        Bt.transpose();
+        EXPECT(sparse::TransposeMultiplyPlan(B).coloured());
+
+        ArrayVector<double> x(rows);
+        for (int r = 0; r < rows; ++r) {
+            x.view()[r] = std::sin(0.01 * r);
+        }
+
+        ArrayVector<double> y_transposed(cols);
+        sparse_matrix_multiply(Bt, x.view(), y_transposed.view(), sparse::backend::openmp());
+
+        auto transpose_multiply = [&](int num_threads) {
+            int max_threads = atlas_omp_get_max_threads();
+            atlas_omp_set_num_threads(num_threads);
+            ArrayVector<double> y(cols);
+            y.view().assign(0.);
+            sparse_matrix_transpose_multiply_add(B, x.view(), y.view());
+            atlas_omp_set_num_threads(max_threads);
+            return std::vector<double>(y.view().data(), y.view().data() + cols);
+        };
+        auto serial   = transpose_multiply(1);
+        auto threaded = transpose_multiply(std::max(4, atlas_omp_get_max_threads()));
+        EXPECT(serial == threaded);
+        expect_equal(serial, y_transposed.view());
+    }
+
+    SECTION("Scattered columns, accumulated in private buffers per thread") {
+        // Rows touch columns spread over the whole range, so that the column ranges of all row blocks overlap
+        const int rows = 5000;
+        const int cols = 3000;
+        const int Nk   = 5;
+        std::vector<eckit::linalg::Triplet> triplets;
+        for (int r = 0; r < rows; ++r) {
+            for (int j = 0; j < 4; ++j) {
+                triplets.emplace_back(r, (r * 7919 + j * 104729) % cols, 1. / (1. + r % 7 + j));
+            }
+        }
+        std::sort(triplets.begin(), triplets.end());
+        SparseMatrix B(rows, cols, triplets);
+        SparseMatrix Bt(B);
+        Bt.transpose();
+
+        sparse::TransposeMultiplyPlan plan(B);
+        EXPECT(not plan.coloured());
+        EXPECT(plan.colours() > sparse::TransposeMultiplyPlan::max_colours());
+        EXPECT(plan.valid_for(B));
+        EXPECT(not plan.valid_for(Bt));
+
+        ArrayMatrix<double> x(rows, Nk);
+        for (int r = 0; r < rows; ++r) {
+            for (int k = 0; k < Nk; ++k) {
+                x.view()(r, k) = std::sin(0.01 * r + k);
+            }
+        }
+        ArrayMatrix<double> y_transposed(cols, Nk);
+        sparse_matrix_multiply(Bt, x.view(), y_transposed.view(), sparse::backend::openmp());
+
+        for (int num_threads : {1, std::max(4, atlas_omp_get_max_threads())}) {
+            // Buffers of 2 values per point for each thread, accumulating the 5 values in passes of 2, 2 and 1;
+            // and buffers too small for two threads, accumulating serially
+            sparse::TransposeMultiplyPlan tiled(B, size_t(2) * cols * num_threads);
+            sparse::TransposeMultiplyPlan unbuffered(B, size_t(cols));
+            for (const auto* p : {&plan, &tiled, &unbuffered}) {
+                int max_threads = atlas_omp_get_max_threads();
+                atlas_omp_set_num_threads(num_threads);
+                ArrayMatrix<double> y(cols, Nk);
+                y.view().assign(0.);
+                sparse_matrix_transpose_multiply_add(B, x.view(), y.view(), *p);
+                atlas_omp_set_num_threads(max_threads);
+                expect_equal(y.view(), y_transposed.view());
+            }
+        }
+    }
+}
+
+CASE("compact sparse_matrix multiply") {
+    SparseMatrix A{3, 3, {{0, 0, 2.}, {0, 2, -3.}, {1, 1, 2.}, {2, 2, 2.}}};
+    Matrix m{{1., 2.}, {3., 4.}, {5., 6.}};
+    Matrix c_exp{{-13., -14.}, {6., 8.}, {10., 12.}};
+
+    EXPECT(CompactSparseMatrix<double>::fits(A));
+    CompactSparseMatrix<double> Ad(A);
+    CompactSparseMatrix<float> Af(A);
+    EXPECT_EQ(Ad.rows(), A.rows());
+    EXPECT_EQ(Ad.cols(), A.cols());
+    EXPECT_EQ(Af.nonZeros(), A.nonZeros());
+    EXPECT(Ad.weight_error() == 0.);
+    EXPECT(Af.weight_error() == 0.);  // weights exactly representable in single precision
+
+    SECTION("View of atlas::Array, rank 1") {
+        ArrayVector<double> x(Vector{1., 2., 3.});
+        ArrayVector<double> y(3);
+        sparse_matrix_multiply(Af, x.view(), y.view());
+        expect_equal(y.view(), Vector{-7., 4., 6.});
+    }
+
+    SECTION("View of atlas::Array PointsLeft") {
+        ArrayMatrix<float> ma(m);
+        ArrayMatrix<float> c(3, 2);
+        sparse_matrix_multiply(Ad, ma.view(), c.view());
+        expect_equal(c.view(), ArrayMatrix<float>(c_exp).view());
+    }
+
+    SECTION("View of atlas::Array PointsRight") {
+        ArrayMatrix<double, Indexing::layout_right> ma(m);
+        ArrayMatrix<double, Indexing::layout_right> c(3, 2);
+        sparse_matrix_multiply(Af, ma.view(), c.view(), Indexing::layout_right);
+        expect_equal(c.view(), ArrayMatrix<double, Indexing::layout_right>(c_exp).view());
+    }
+
+    SECTION("Single precision weights, double precision accumulation") {
+        SparseMatrix B{2, 3, {{0, 0, 0.1}, {0, 1, 0.2}, {0, 2, 0.7}, {1, 1, 1. / 3.}, {1, 2, 2. / 3.}}};
+        CompactSparseMatrix<float> Bf(B);
+        EXPECT(Bf.weight_error() > 0.);
+        EXPECT(Bf.weight_error() < 1.e-7);
+        EXPECT(Bf.row_sum_error() < 1.e-7);
+        EXPECT(Bf.footprint() < B.footprint());
+
+        ArrayVector<double> x(Vector{1., 2., 3.});
+        ArrayVector<double> y(2);
+        ArrayVector<double> y_exp(2);
+        sparse_matrix_multiply(Bf, x.view(), y.view());
+        sparse_matrix_multiply(B, x.view(), y_exp.view(), sparse::backend::openmp());
+        for (int r = 0; r < 2; ++r) {
+            EXPECT_APPROX_EQ(y.view()[r], y_exp.view()[r], 3. * Bf.weight_error());
+        }
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace test
@@ -8,9 +8,12 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "eckit/config/Resource.h"
 
@@ -20,6 +23,7 @@
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Partitioner.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator.h"
@@ -151,6 +155,51 @@ void rotated_flow_magnitude(const fvm::Method& fvm, Field& field, const double&
     }
 }
 
+/// @brief Gradient of scalar computed edge by edge, then summed per node (the former two-pass fvm implementation)
+void reference_gradient(const fvm::Method& fvm, Field& scalar_field, Field& grad_field) {
+    const double deg2rad     = M_PI / 180.;
+    const double scale       = deg2rad * deg2rad * fvm.radius();
+    const mesh::Edges& edges = fvm.mesh().edges();
+    const mesh::Nodes& nodes = fvm.mesh().nodes();
+    const idx_t nnodes       = fvm.node_columns().nb_nodes();
+    const idx_t nedges       = fvm.edge_columns().nb_edges();
+
+    auto scalar               = make_scalarview<double>(scalar_field);
+    auto grad                 = make_vectorview<double>(grad_field);
+    const idx_t nlev          = scalar.shape(1);
+    const auto lonlat_deg     = array::make_view<double, 2>(nodes.lonlat());
+    const auto dual_volumes   = array::make_view<double, 1>(nodes.field("dual_volumes"));
+    const auto dual_normals   = array::make_view<double, 2>(edges.field("dual_normals"));
+    const auto node2edge_sign = array::make_view<double, 2>(nodes.field("node2edge_sign"));
+    const auto& node2edge     = nodes.edge_connectivity();
+    const auto& edge2node     = edges.node_connectivity();
+
+    std::vector<double> avgS(nedges * nlev * 2);
+    for (idx_t jedge = 0; jedge < nedges; ++jedge) {
+        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+            double avg = (scalar(edge2node(jedge, 0), jlev) + scalar(edge2node(jedge, 1), jlev)) * 0.5;
+            avgS[(jedge * nlev + jlev) * 2 + LON] = dual_normals(jedge, LON) * deg2rad * avg;
+            avgS[(jedge * nlev + jlev) * 2 + LAT] = dual_normals(jedge, LAT) * deg2rad * avg;
+        }
+    }
+    for (idx_t jnode = 0; jnode < nnodes; ++jnode) {
+        const double metric_y = 1. / (dual_volumes(jnode) * scale);
+        const double metric_x = metric_y / std::cos(lonlat_deg(jnode, LAT) * deg2rad);
+        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+            double sum[2] = {0., 0.};
+            for (idx_t jedge = 0; jedge < node2edge.cols(jnode); ++jedge) {
+                const idx_t iedge = node2edge(jnode, jedge);
+                if (iedge < nedges) {
+                    sum[LON] += node2edge_sign(jnode, jedge) * avgS[(iedge * nlev + jlev) * 2 + LON];
+                    sum[LAT] += node2edge_sign(jnode, jedge) * avgS[(iedge * nlev + jlev) * 2 + LAT];
+                }
+            }
+            grad(jnode, jlev, LON) = sum[LON] * metric_x;
+            grad(jnode, jlev, LAT) = sum[LAT] * metric_y;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CASE("test_factory") {
@@ -459,6 +508,132 @@ CASE("test_lapl") {
 
 }
 
+CASE("test_grad against reference, with more levels than a level block") {
+    Grid grid(griduid());
+    MeshGenerator meshgenerator("structured");
+    Mesh mesh        = meshgenerator.generate(grid, Distribution(grid, Partitioner("equal_regions")));
+    const idx_t nlev = 70;
+    fvm::Method fvm(mesh, option::radius("Earth") | option::levels(nlev));
+    Nabla nabla(fvm);
+
+    FieldSet fields;
+    fields.add(fvm.node_columns().createField<double>(option::name("scalar")));
+    fields.add(fvm.node_columns().createField<double>(option::name("grad") | option::variables(2)));
+    fields.add(fvm.node_columns().createField<double>(option::name("rgrad") | option::variables(2)));
+
+    rotated_flow_magnitude<double>(fvm, fields["scalar"], M_PI_4);
+    auto scalar = make_scalarview<double>(fields["scalar"]);
+    for (idx_t jnode = 0; jnode < scalar.shape(0); ++jnode) {
+        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+            scalar(jnode, jlev) *= 1. + 0.1 * jlev;
+        }
+    }
+
+    nabla.gradient(fields["scalar"], fields["grad"]);
+    reference_gradient(fvm, fields["scalar"], fields["rgrad"]);
+
+    auto grad        = make_vectorview<double>(fields["grad"]);
+    auto rgrad       = make_vectorview<double>(fields["rgrad"]);
+    double max_value = 0.;
+    double max_error = 0.;
+    for (idx_t jnode = 0; jnode < fvm.node_columns().nb_nodes(); ++jnode) {
+        for (idx_t jlev = 0; jlev < nlev; ++jlev) {
+            for (idx_t jvar = 0; jvar < 2; ++jvar) {
+                max_value = std::max(max_value, std::abs(rgrad(jnode, jlev, jvar)));
+                max_error = std::max(max_error, std::abs(grad(jnode, jlev, jvar) - rgrad(jnode, jlev, jvar)));
+            }
+        }
+    }
+    Log::info() << "max |grad - reference| = " << max_error << ", max |reference| = " << max_value << std::endl;
+    EXPECT(max_value > 0.);
+    EXPECT(max_error <= 1.e-14 * max_value);
+}
+
+template <typename Value>
+bool bitwise_equal(const Field& a, const Field& b) {
+    return a.size() == b.size() &&
+           std::equal(a.array().data<Value>(), a.array().data<Value>() + a.size(), b.array().data<Value>());
+}
+
+CASE("test_fieldset operators equal field operators") {
+    Grid grid(griduid());
+    MeshGenerator meshgenerator("structured");
+    Mesh mesh = meshgenerator.generate(grid, Distribution(grid, Partitioner("equal_regions")));
+    fvm::Method fvm(mesh, option::radius("Earth") | option::levels(test_levels()));
+    Nabla nabla(fvm);
+
+    auto create = [&](const std::string& name, idx_t variables, DataType datatype) {
+        return fvm.node_columns().createField(option::name(name) | option::variables(variables) |
+                                              option::datatype(datatype));
+    };
+    auto output_like = [&](const FieldSet& fields, idx_t variables) {
+        FieldSet outputs;
+        for (const auto& field : fields) {
+            outputs.add(create(field.name() + ".out", variables ? variables : field.variables() * 2,
+                               field.datatype()));
+        }
+        return outputs;
+    };
+
+    FieldSet scalars;
+    FieldSet vectors;
+    for (int i = 0; i < 3; ++i) {
+        Field scalar = create("scalar" + std::to_string(i), 1, DataType::real64());
+        Field vector = create("vector" + std::to_string(i), 2, DataType::real64());
+        rotated_flow_magnitude<double>(fvm, scalar, M_PI_4 * i);
+        rotated_flow<double>(fvm, vector, M_PI_4 * i);
+        scalars.add(scalar);
+        vectors.add(vector);
+    }
+    Field scalar_float = create("scalar_float", 1, DataType::real32());
+    Field vector_float = create("vector_float", 2, DataType::real32());
+    rotated_flow_magnitude<float>(fvm, scalar_float, 0.);
+    rotated_flow<float>(fvm, vector_float, 0.);
+    scalars.add(scalar_float);
+    vectors.add(vector_float);
+
+    // Gradients of scalars and vectors, in double and single precision, are computed in separate batches
+    FieldSet fields;
+    for (const auto& field : scalars) {
+        fields.add(field);
+    }
+    fields.add(vectors[0]);
+
+    auto check = [&](const FieldSet& inputs, const FieldSet& outputs, auto&& op) {
+        for (idx_t i = 0; i < inputs.size(); ++i) {
+            Field expected = create("expected", outputs[i].variables(), outputs[i].datatype());
+            op(inputs[i], expected);
+            if (outputs[i].datatype() == DataType::real64()) {
+                EXPECT(bitwise_equal<double>(outputs[i], expected));
+            }
+            else {
+                EXPECT(bitwise_equal<float>(outputs[i], expected));
+            }
+        }
+    };
+
+    SECTION("gradient") {
+        FieldSet grads = output_like(fields, 0);
+        nabla.gradient(fields, grads);
+        check(fields, grads, [&](const Field& in, Field& out) { nabla.gradient(in, out); });
+    }
+    SECTION("divergence") {
+        FieldSet divs = output_like(vectors, 1);
+        nabla.divergence(vectors, divs);
+        check(vectors, divs, [&](const Field& in, Field& out) { nabla.divergence(in, out); });
+    }
+    SECTION("curl") {
+        FieldSet curls = output_like(vectors, 1);
+        nabla.curl(vectors, curls);
+        check(vectors, curls, [&](const Field& in, Field& out) { nabla.curl(in, out); });
+    }
+    SECTION("laplacian") {
+        FieldSet lapls = output_like(scalars, 1);
+        nabla.laplacian(scalars, lapls);
+        check(scalars, lapls, [&](const Field& in, Field& out) { nabla.laplacian(in, out); });
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 #include "atlas/array.h"
 #include "atlas/array/ArrayView.h"
@@ -680,6 +681,134 @@ CASE("test_gather") {
             }
         }
     }
+
+    SECTION("test_gather_to_writers") {
+        // Global points 0..3 are written by rank 2, points 4..8 by rank 0
+        f.gather_scatter.setup_writers(std::vector<int>{2, 0});
+        const idx_t slab_size   = f.gather_scatter.slab_size();
+        const gidx_t slab_begin = f.gather_scatter.slab_begin();
+        switch (f.rank) {
+            case 0:
+                EXPECT_EQ(slab_begin, 4);
+                EXPECT_EQ(slab_size, 5);
+                break;
+            case 1:
+                EXPECT_EQ(slab_size, 0);
+                break;
+            case 2:
+                EXPECT_EQ(slab_begin, 0);
+                EXPECT_EQ(slab_size, 4);
+                break;
+        }
+
+        array::ArrayT<POD> loc1(f.Nl);
+        array::ArrayT<POD> loc2(f.Nl, 2);
+        array::ArrayT<POD> glb1(slab_size);
+        array::ArrayT<POD> glb2(slab_size, 2);
+        auto locv1 = array::make_view<POD, 1>(loc1);
+        auto locv2 = array::make_view<POD, 2>(loc2);
+        auto glbv1 = array::make_view<POD, 1>(glb1);
+        auto glbv2 = array::make_view<POD, 2>(glb2);
+        for (int j = 0; j < f.Nl; ++j) {
+            const bool owned = (f.part[j] == f.rank);
+            locv1(j)         = owned ? f.gidx[j] * 10 : 0;
+            locv2(j, 0)      = owned ? f.gidx[j] * 10 : 0;
+            locv2(j, 1)      = owned ? f.gidx[j] * 100 : 0;
+        }
+
+        std::vector<parallel::Field<POD const>> lfields{parallel::Field<POD const>(locv1),
+                                                        parallel::Field<POD const>(locv2)};
+        std::vector<parallel::Field<POD>> gfields{parallel::Field<POD>(glbv1), parallel::Field<POD>(glbv2)};
+        std::vector<idx_t> gathered;
+        f.gather_scatter.gather_to_writers(lfields.data(), gfields.data(), 2,
+                                           [&](idx_t jfield) { gathered.push_back(jfield); });
+
+        EXPECT(gathered == (slab_size ? std::vector<idx_t>{0, 1} : std::vector<idx_t>{}));
+        for (idx_t i = 0; i < slab_size; ++i) {
+            const POD g = slab_begin + i + 1;
+            EXPECT_EQ(glbv1(i), g * 10);
+            EXPECT_EQ(glbv2(i, 0), g * 10);
+            EXPECT_EQ(glbv2(i, 1), g * 100);
+        }
+
+        // Scatter back, only owned points are set
+        POD nan = -1000.;
+        locv1.assign(nan);
+        locv2.assign(nan);
+        std::vector<parallel::Field<POD const>> gfields_const{parallel::Field<POD const>(glbv1),
+                                                              parallel::Field<POD const>(glbv2)};
+        std::vector<parallel::Field<POD>> lfields_scatter{parallel::Field<POD>(locv1), parallel::Field<POD>(locv2)};
+        f.gather_scatter.scatter_from_writers(gfields_const.data(), lfields_scatter.data(), 2);
+        for (int j = 0; j < f.Nl; ++j) {
+            const bool owned = (f.part[j] == f.rank);
+            EXPECT_EQ(locv1(j), owned ? f.gidx[j] * 10 : nan);
+            EXPECT_EQ(locv2(j, 0), owned ? f.gidx[j] * 10 : nan);
+            EXPECT_EQ(locv2(j, 1), owned ? f.gidx[j] * 100 : nan);
+        }
+    }
+
+    SECTION("test_gather_multiple_fields") {
+        // Default batch size gathers all fields together, the small one gathers fields {0, 1} and {2} separately
+        const size_t default_batch_bytes = f.gather_scatter.max_batch_bytes();
+        for (size_t max_batch_bytes : {default_batch_bytes, 2 * f.gather_scatter.glb_dof() * sizeof(POD)}) {
+            f.gather_scatter.max_batch_bytes(max_batch_bytes);
+            for (f.root = 0; f.root < f.comm_size; ++f.root) {
+                array::ArrayT<POD> loc1(f.Nl);
+                array::ArrayT<POD> loc2(f.Nl);
+                array::ArrayT<POD> loc3(f.Nl, 2);
+                array::ArrayT<POD> glb1(f.Ng());
+                array::ArrayT<POD> glb2(f.Ng());
+                array::ArrayT<POD> glb3(f.Ng(), 2);
+                auto locv1 = array::make_view<POD, 1>(loc1);
+                auto locv2 = array::make_view<POD, 1>(loc2);
+                auto locv3 = array::make_view<POD, 2>(loc3);
+                auto glbv1 = array::make_view<POD, 1>(glb1);
+                auto glbv2 = array::make_view<POD, 1>(glb2);
+                auto glbv3 = array::make_view<POD, 2>(glb3);
+                for (int j = 0; j < f.Nl; ++j) {
+                    locv1(j)    = f.gidx[j];
+                    locv2(j)    = -f.gidx[j];
+                    locv3(j, 0) = f.gidx[j] * 10;
+                    locv3(j, 1) = f.gidx[j] * 100;
+                }
+
+                std::vector<parallel::Field<POD const>> lfields{parallel::Field<POD const>(locv1),
+                                                                parallel::Field<POD const>(locv2),
+                                                                parallel::Field<POD const>(locv3)};
+                std::vector<parallel::Field<POD>> gfields{parallel::Field<POD>(glbv1), parallel::Field<POD>(glbv2),
+                                                          parallel::Field<POD>(glbv3)};
+                f.gather_scatter.gather(lfields.data(), gfields.data(), 3, f.root);
+                for (idx_t i = 0; i < f.Ng(); ++i) {
+                    const POD g = i + 1;
+                    EXPECT_EQ(glbv1(i), g);
+                    EXPECT_EQ(glbv2(i), -g);
+                    EXPECT_EQ(glbv3(i, 0), g * 10);
+                    EXPECT_EQ(glbv3(i, 1), g * 100);
+                }
+
+                // Scatter back, only owned points are set
+                POD nan = -1000.;
+                locv1.assign(nan);
+                locv2.assign(nan);
+                locv3.assign(nan);
+                std::vector<parallel::Field<POD const>> gfields_const{parallel::Field<POD const>(glbv1),
+                                                                      parallel::Field<POD const>(glbv2),
+                                                                      parallel::Field<POD const>(glbv3)};
+                std::vector<parallel::Field<POD>> lfields_scatter{
+                    parallel::Field<POD>(locv1), parallel::Field<POD>(locv2), parallel::Field<POD>(locv3)};
+                f.gather_scatter.scatter(gfields_const.data(), lfields_scatter.data(), 3, f.root);
+                for (int j = 0; j < f.Nl; ++j) {
+                    const bool owned = (f.part[j] == f.rank);
+                    EXPECT_EQ(locv1(j), owned ? f.gidx[j] : nan);
+                    EXPECT_EQ(locv2(j), owned ? -f.gidx[j] : nan);
+                    EXPECT_EQ(locv3(j, 0), owned ? f.gidx[j] * 10 : nan);
+                    EXPECT_EQ(locv3(j, 1), owned ? f.gidx[j] * 100 : nan);
+                }
+            }
+        }
+        f.gather_scatter.max_batch_bytes(default_batch_bytes);
+        f.root = 0;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -491,6 +491,72 @@ CASE("Structured grid") {
     }
 }
 
+CASE("FieldSet with mixed datatypes and ranks") {
+    auto grid = atlas::Grid("L24x19");
+
+    auto sourceMesh = MeshGenerator("structured", util::Config("partitioner", "equal_regions")).generate(grid);
+    auto targetMesh = MeshGenerator("structured", util::Config("partitioner", "equal_bands")).generate(grid);
+
+    const auto sourceFunctionSpace = functionspace::NodeColumns(sourceMesh, util::Config("halo", 1));
+    const auto targetFunctionSpace = functionspace::NodeColumns(targetMesh, util::Config("halo", 1));
+
+    auto redist = Redistribution(sourceFunctionSpace, targetFunctionSpace);
+
+    auto sourceFieldSet = FieldSet{};
+    auto targetFieldSet = FieldSet{};
+    sourceFieldSet.add(sourceFunctionSpace.createField<double>(util::Config("name", "a") | fieldConfig<3>()));
+    sourceFieldSet.add(sourceFunctionSpace.createField<int>(util::Config("name", "b") | fieldConfig<1>()));
+    sourceFieldSet.add(sourceFunctionSpace.createField<float>(util::Config("name", "c") | fieldConfig<2>()));
+    for (const auto& field : sourceFieldSet) {
+        targetFieldSet.add(targetFunctionSpace.createField(field));
+    }
+
+    const auto sourceLonLatView = array::make_view<double, 2>(sourceFunctionSpace.lonlat());
+    auto a = array::make_view<double, 3>(sourceFieldSet[0]);
+    auto b = array::make_view<int, 1>(sourceFieldSet[1]);
+    auto c = array::make_view<float, 2>(sourceFieldSet[2]);
+    for (idx_t i = 0; i < sourceFunctionSpace.size(); ++i) {
+        const double lon = sourceLonLatView(i, LON);
+        const double lat = sourceLonLatView(i, LAT);
+        b(i)             = testPattern<int>(lon, lat, 0);
+        for (idx_t j = 0; j < a.shape(1); ++j) {
+            a(i, j, 0) = testPattern<double>(lon, lat, j);
+            a(i, j, 1) = -testPattern<double>(lon, lat, j);
+            c(i, j)    = testPattern<float>(lon, lat, j);
+        }
+    }
+
+    // Redistribute the fields one by one, and all together, reusing the same buffers.
+    auto expectedFieldSet = FieldSet{};
+    for (idx_t f = 0; f < sourceFieldSet.size(); ++f) {
+        expectedFieldSet.add(targetFunctionSpace.createField(sourceFieldSet[f]));
+        redist.execute(sourceFieldSet[f], expectedFieldSet[f]);
+    }
+    redist.execute(sourceFieldSet, targetFieldSet);
+
+    const auto targetGhostView = array::make_view<int, 1>(targetFunctionSpace.ghost());
+    const auto expectedA       = array::make_view<double, 3>(expectedFieldSet[0]);
+    const auto expectedB       = array::make_view<int, 1>(expectedFieldSet[1]);
+    const auto expectedC       = array::make_view<float, 2>(expectedFieldSet[2]);
+    const auto targetA         = array::make_view<double, 3>(targetFieldSet[0]);
+    const auto targetB         = array::make_view<int, 1>(targetFieldSet[1]);
+    const auto targetC         = array::make_view<float, 2>(targetFieldSet[2]);
+    const auto targetLonLat    = array::make_view<double, 2>(targetFunctionSpace.lonlat());
+    for (idx_t i = 0; i < targetFunctionSpace.size(); ++i) {
+        if (targetGhostView(i)) {
+            continue;
+        }
+        EXPECT_EQ(targetB(i), expectedB(i));
+        EXPECT(checkValue(targetB(i), testPattern<int>(targetLonLat(i, LON), targetLonLat(i, LAT), 0)));
+        for (idx_t j = 0; j < targetA.shape(1); ++j) {
+            EXPECT_EQ(targetA(i, j, 0), expectedA(i, j, 0));
+            EXPECT_EQ(targetA(i, j, 1), expectedA(i, j, 1));
+            EXPECT_EQ(targetC(i, j), expectedC(i, j));
+            EXPECT(checkValue(targetA(i, j, 0), testPattern<double>(targetLonLat(i, LON), targetLonLat(i, LAT), j)));
+        }
+    }
+}
+
 CASE("Cubed sphere grid") {
     auto grid = atlas::Grid("CS-LFR-C-8");
 
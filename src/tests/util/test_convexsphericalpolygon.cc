@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <vector>
 #include <type_traits>
+#include <utility>
 #include <initializer_list>
 
 #include "atlas/util/ConvexSphericalPolygon.h"
@@ -57,8 +59,21 @@ std::string to_json(std::initializer_list<ConvexSphericalPolygon>&& polygons, in
     return to_json(polygons.begin(),polygons.end(),precision);
 }
 
+bool bitwise_equal(const ConvexSphericalPolygon& plg1, const ConvexSphericalPolygon& plg2) {
+    if (bool(plg1) != bool(plg2) || plg1.size() != plg2.size()) {
+        return false;
+    }
+    for (idx_t i = 0; i < plg1.size(); ++i) {
+        if (plg1[i][0] != plg2[i][0] || plg1[i][1] != plg2[i][1] || plg1[i][2] != plg2[i][2]) {
+            return false;
+        }
+    }
+    return plg1.area() == plg2.area();
+}
+
 void check_intersection(const ConvexSphericalPolygon& plg1, const ConvexSphericalPolygon& plg2, const ConvexSphericalPolygon& iplg_sol, double pointsSameEPS = 5.e6 * EPS, std::ostream* out = nullptr) {
     auto iplg       = plg1.intersect(plg2, out, pointsSameEPS);
+    EXPECT(bitwise_equal(iplg, plg1.intersect_scalar(plg2, nullptr, pointsSameEPS)));
     Log::info().indent();
     Log::info() << "plg1 area : " << plg1.area() << "\n";
     Log::info() << "plg2 area : " << plg2.area() << "\n";
@@ -581,6 +596,56 @@ CASE("Edge cases in polygon intersections") {
 
 }
 
+CASE("intersect is bitwise identical to intersect_scalar") {
+    // Quadrilateral cells of a regular grid, intersected with shifted and rotated cells of other shapes,
+    // including polar triangles, cells sharing edges with each other, and disjoint cells
+    const int nlon    = 36;
+    const int nlat    = 18;
+    const double dlon = 360. / nlon;
+    const double dlat = 180. / nlat;
+    size_t nb_pairs   = 0;
+    size_t nb_valid   = 0;
+    for (int j = 0; j < nlat; ++j) {
+        const double lat0 = 90. - dlat * j;
+        const double lat1 = lat0 - dlat;
+        for (int i = 0; i < nlon; ++i) {
+            const double lon0 = dlon * i;
+            const double lon1 = lon0 + dlon;
+            const auto cell   = (j == 0) ? make_polygon(PointLonLat{lon0, 90.}, PointLonLat{lon0, lat1},
+                                                        PointLonLat{lon1, lat1})
+                                             : make_polygon(PointLonLat{lon0, lat0}, PointLonLat{lon0, lat1},
+                                                            PointLonLat{lon1, lat1}, PointLonLat{lon1, lat0});
+            const double s = 0.37 * (i % 3) * dlon;
+            const double t = (j < nlat / 2 ? 0.29 : -0.29) * (j % 4) * dlat;
+            auto clamp     = [](double lat) { return std::max(-90., std::min(90., lat)); };
+            std::vector<ConvexSphericalPolygon> others{
+                make_polygon(PointLonLat{lon0 + s, lat0 - t}, PointLonLat{lon0 + s - 0.5 * dlon, lat1 - t},
+                             PointLonLat{lon1 + s, lat1 - t}),
+                make_polygon(PointLonLat{0.5 * (lon0 + lon1), clamp(lat0 + 0.3 * dlat)},
+                             PointLonLat{lon0 - 0.2 * dlon, 0.5 * (lat0 + lat1)},
+                             PointLonLat{0.5 * (lon0 + lon1), clamp(lat1 - 0.3 * dlat)},
+                             PointLonLat{lon1 + 0.2 * dlon, 0.5 * (lat0 + lat1)}),
+                make_polygon(PointLonLat{lon1, lat0}, PointLonLat{lon1, lat1}, PointLonLat{lon1 + dlon, lat1},
+                             PointLonLat{lon1 + dlon, lat0}),
+                make_polygon(PointLonLat{lon0 + 90., -30.}, PointLonLat{lon0 + 100., -40.},
+                             PointLonLat{lon0 + 110., -30.}),
+            };
+            for (const auto& other : others) {
+                for (const auto& pair : {std::make_pair(&cell, &other), std::make_pair(&other, &cell)}) {
+                    auto iplg        = pair.first->intersect(*pair.second);
+                    auto iplg_scalar = pair.first->intersect_scalar(*pair.second);
+                    EXPECT(bitwise_equal(iplg, iplg_scalar));
+                    ++nb_pairs;
+                    nb_valid += bool(iplg);
+                }
+            }
+        }
+    }
+    Log::info() << "Compared " << nb_pairs << " intersections, of which " << nb_valid << " non-empty" << std::endl;
+    EXPECT(nb_valid > 0);
+    EXPECT(nb_valid < nb_pairs);
+}
+
 //-----------------------------------------------------------------------------
 
 }  // end namespace test
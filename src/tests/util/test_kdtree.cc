@@ -8,6 +8,7 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <limits>
@@ -16,6 +17,7 @@
 
 #include "atlas/grid.h"
 #include "atlas/util/KDTree.h"
+#include "atlas/util/PersistentKDTree.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -334,6 +336,80 @@ CASE("test kdtree with configured geometry") {
     EXPECT_EQ(neighbours_earth, expected_neighbours);
 }
 
+CASE("test flat kdtree") {
+    auto grid = Grid{"O32"};
+    IndexKDTree flat(util::Config("geometry", "Earth")("kdtree_type", "flat"));
+    flat.build(grid.lonlat(), PayloadGenerator(grid.size()));
+    EXPECT_EQ(flat.size(), size_t(grid.size()));
+
+    auto sorted = [](std::vector<idx_t> payloads) {
+        std::sort(payloads.begin(), payloads.end());
+        return payloads;
+    };
+
+    // Same neighbours as the eckit tree; the order of equidistant points may differ
+    IndexKDTree::ValueList result;
+    double km = 1000. * radius() / util::Earth::radius();
+    for (auto& p : std::vector<PointLonLat>{{180., 45.}, {0., 90.}, {-10., -89.9}, {359.9, 0.}, {33.3, 12.1}}) {
+        auto expected = search().closestPoints(p, 8);
+        flat.closestPoints(p, 8, result);
+        EXPECT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < result.size(); ++i) {
+            EXPECT_APPROX_EQ(result[i].distance(), expected[i].distance(), 1.e-6);
+        }
+        EXPECT_EQ(flat.closestPoint(p).distance(), result.front().distance());
+
+        auto expected_within = search().closestPointsWithinRadius(p, 500 * km);
+        flat.closestPointsWithinRadius(p, 500 * km, result);
+        EXPECT_EQ(sorted(result.payloads()), sorted(expected_within.payloads()));
+    }
+    EXPECT_EQ(flat.closestPoints(PointLonLat{180., 45.}, 1).payloads(), std::vector<idx_t>{760});
+
+    // Points inserted after a build are searched once the tree is rebuilt
+    flat.insert(PointLonLat{180., 45.}, -1);
+    EXPECT_THROWS_AS(flat.closestPoint(PointLonLat{180., 45.}), eckit::AssertionFailed);
+    flat.build();
+    EXPECT_EQ(flat.size(), size_t(grid.size() + 1));
+    EXPECT_EQ(flat.closestPoint(PointLonLat{180., 45.}).payload(), -1);
+
+    IndexKDTree empty(util::Config("kdtree_type", "flat"));
+    empty.build();
+    EXPECT(empty.empty());
+    EXPECT(empty.closestPoints(PointLonLat{0., 0.}, 4).empty());
+
+    // Other options of the caller, e.g. of a PointCloud, are ignored
+    EXPECT_NO_THROW(IndexKDTree(util::Config("type", "PointCloud")));
+    EXPECT_THROWS_AS(IndexKDTree(util::Config("kdtree_type", "unknown")), eckit::AssertionFailed);
+}
+
+CASE("test persistent kdtree") {
+    auto grid = Grid{"O32"};
+
+    PersistentKDTree persistent_kdtree("atlas_test_kdtree_persistent");
+    std::string key = persistent_kdtree.key(grid, geometry());
+    if (persistent_kdtree.path(key).exists()) {
+        persistent_kdtree.path(key).unlink();
+    }
+    EXPECT(key != persistent_kdtree.key(grid, Geometry("UnitSphere")));
+    EXPECT(key != persistent_kdtree.key(Grid{"O16"}, geometry()));
+    EXPECT(not persistent_kdtree.load(key, geometry()));
+
+    // First call builds and stores the tree, second call maps the stored tree
+    auto built = persistent_kdtree(grid, geometry());
+    EXPECT(persistent_kdtree.path(key).exists());
+    auto loaded = persistent_kdtree(grid, geometry());
+    EXPECT_EQ(loaded.size(), size_t(grid.size()));
+
+    double km                = 1000. * radius() / util::Earth::radius();
+    auto neighbours          = loaded.closestPointsWithinRadius(PointLonLat{180., 45.}, 500 * km).payloads();
+    auto expected_neighbours = std::vector<idx_t>{760, 842, 759, 761, 841, 843, 682};
+    EXPECT_EQ(neighbours, expected_neighbours);
+
+    auto payloads = loaded.closestPoints(PointLonLat{180., 45.}, 4).payloads();
+    EXPECT_EQ(payloads, search().closestPoints(PointLonLat{180., 45.}, 4).payloads());
+    EXPECT_EQ(built.closestPoint(PointLonLat{180., 45.}).payload(), 760);
+}
+
 //------------------------------------------------------------------------------------------------
 
 }  // namespace test